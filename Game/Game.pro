@@ -13,6 +13,10 @@ CONFIG += c++17
 # deprecated API in order to know how to port your code away from it.
 DEFINES += QT_DEPRECATED_WARNINGS
 
+# Scoped timers of the hot paths, see core/profiler.hh. Build with
+# qmake CONFIG+=profiling and run with PV_PROFILE_OUT=<prefix>
+CONFIG(profiling): DEFINES += PV_PROFILING
+
 # You can also make your code fail to compile if you use deprecated APIs.
 # In order to do so, uncomment the following line.
 # You can also select to disable deprecated APIs only up to a certain version of Qt.
@@ -27,9 +31,28 @@ SOURCES += \
     graphics/gamescene.cpp \
     interfaces/objectmanager.cpp \
     graphics/mapitem.cpp \
+    graphics/statschart.cpp \
     core/gamemanager.cpp \
+    core/mapsnapshot.cpp \
+    core/actionlog.cpp \
+    core/replayengine.cpp \
     tiles/mountain.cpp \
     core/worldgeneratorperlin.cpp \
+    core/biomeconfig.cpp \
+    core/objectregistry.cpp \
+    core/objectpool.cpp \
+    core/scoreledger.cpp \
+    core/actionerror.cpp \
+    core/productionforecast.cpp \
+    core/upkeep.cpp \
+    core/steadyturns.cpp \
+    core/turntimers.cpp \
+    ai/montecarlopolicy.cpp \
+    ai/randompolicy.cpp \
+    ai/scriptedpolicy.cpp \
+    ai/turnplanner.cpp \
+    core/profiler.cpp \
+    core/statsrecorder.cpp \
     core/perlinnoise.cpp \
     tiles/lake.cpp \
     tiles/ocean.cpp \
@@ -64,9 +87,32 @@ HEADERS += \
     graphics/gamescene.hh \
     interfaces/objectmanager.hh \
     graphics/mapitem.hh \
+    graphics/statschart.hh \
     core/gamemanager.hh \
+    core/mapsnapshot.hh \
+    core/actionlog.hh \
+    core/replayengine.hh \
     tiles/mountain.h \
     core/worldgeneratorperlin.hh \
+    core/biomeconfig.hh \
+    core/typetags.hh \
+    core/objectregistry.hh \
+    core/objectpool.hh \
+    core/scoreledger.hh \
+    core/actionerror.hh \
+    core/productionforecast.hh \
+    core/upkeep.hh \
+    core/steadyturns.hh \
+    core/turntimers.hh \
+    ai/montecarlopolicy.hh \
+    ai/playerpolicy.hh \
+    ai/randompolicy.hh \
+    ai/scriptedpolicy.hh \
+    ai/turnplanner.hh \
+    core/profiler.hh \
+    core/tilebitset.hh \
+    core/statsrecorder.hh \
+    core/neighbourrange.hh \
     core/perlinnoise.hh \
     tiles/lake.h \
     tiles/ocean.hh \
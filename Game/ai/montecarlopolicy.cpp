@@ -0,0 +1,535 @@
+#include "montecarlopolicy.hh"
+#include "ai/randompolicy.hh"
+#include "ai/scriptedpolicy.hh"
+#include "core/neighbourrange.hh"
+#include "core/profiler.hh"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <exception>
+#include <random>
+
+namespace Game {
+
+namespace {
+
+// Exploration constant of UCB1
+const double EXPLORATION = 1.0;
+// One rollout turn in this many is played randomly
+const unsigned int RANDOM_TURNS = 4;
+// Smallest amount worth a sale, half of the amount is sold
+const int MIN_SALE = 40;
+
+// Candidates of each kind per tree node
+const unsigned int MAX_CLAIMS = 6;
+const unsigned int MAX_BUILDS = 8;
+const unsigned int MAX_RECRUITS = 6;
+
+const std::vector<Course::BasicResource> SOLD_RESOURCES = {
+    Course::WOOD, Course::STONE, Course::ORE, Course::FOOD
+};
+
+/**
+ * @brief Actions of the current turn, the path from the root is the plan
+ */
+struct Node
+{
+    GameAction action;
+    int depth = 0;
+    std::vector<std::unique_ptr<Node>> children;
+    // Actions not tried yet, known once the node has been reached. The
+    // last one is tried first
+    std::vector<GameAction> untried;
+    bool expanded = false;
+    int visits = 0;
+    // Rollouts still running under the node
+    int running = 0;
+    double reward = 0;
+};
+
+/**
+ * @brief Takes at most limit elements evenly spread over the list
+ */
+template<typename T>
+std::vector<T> spread(const std::vector<T>& list, unsigned int limit)
+{
+    if(list.size() <= limit){
+        return list;
+    }
+    std::vector<T> taken;
+    for(unsigned int i=0; i<limit; i++){
+        taken.push_back(list.at(i * list.size() / limit));
+    }
+    return taken;
+}
+
+GameAction endTurnAction()
+{
+    GameAction action;
+    action.type = ActionType::END_TURN;
+    return action;
+}
+
+/**
+ * @brief Lists the actions worth trying for the current player
+ * @return Ending the turn first
+ */
+std::vector<GameAction> candidateActions(GameManager& game)
+{
+    std::vector<GameAction> actions = {endTurnAction()};
+
+    std::shared_ptr<Player> player = game.getCurrentPlayer();
+    std::shared_ptr<ObjectManager> objects = game.getObjectManager();
+    std::pair<int, int> size = game.getMapSize();
+
+    std::vector<Course::Coordinate> owned;
+    for(const auto& object : player->getObjects()){
+        if(std::dynamic_pointer_cast<Course::TileBase>(object) != nullptr){
+            owned.push_back(object->getCoordinate());
+        }
+    }
+
+    std::vector<GameAction> builds;
+    std::vector<GameAction> recruits;
+    for(const Course::Coordinate& coordinate : owned){
+        GameAction action;
+        action.x = coordinate.x();
+        action.y = coordinate.y();
+
+        action.type = ActionType::BUILD;
+        for(const BuildingEntry& entry : ObjectRegistry::buildings()){
+            if(game.canAddBuilding(coordinate, entry.tag) ==
+                    ActionError::NONE){
+                action.name = entry.name;
+                builds.push_back(action);
+            }
+        }
+
+        action.type = ActionType::RECRUIT;
+        for(const WorkerEntry& entry : ObjectRegistry::workers()){
+            if(game.canAddWorkers(coordinate, entry.tag) ==
+                    ActionError::NONE){
+                action.name = entry.name;
+                recruits.push_back(action);
+            }
+        }
+    }
+
+    // Tiles next to own land, or any free land for the first claim
+    std::vector<Course::Coordinate> free;
+    auto claimable = [&](const Course::Coordinate& coordinate){
+        TypeTag type = objects->getTileTag(coordinate);
+        return type != TypeTag::UNKNOWN &&
+                objects->getTileOwner(coordinate) == nullptr &&
+                std::find(free.begin(), free.end(), coordinate) ==
+                free.end() &&
+                game.canClaimArea(coordinate) == ActionError::NONE;
+    };
+    if(owned.empty()){
+        for(int y=0; y<size.second; y++){
+            for(int x=0; x<size.first; x++){
+                Course::Coordinate coordinate(x, y);
+                if(!typeTraits(objects->getTileTag(coordinate)).water &&
+                        claimable(coordinate)){
+                    free.push_back(coordinate);
+                }
+            }
+        }
+    } else {
+        for(const Course::Coordinate& coordinate : owned){
+            for(Course::Coordinate next :
+                NeighbourRange(coordinate, 1, Connectivity::FOUR, true)
+                .clippedTo(size.first, size.second)){
+                if(claimable(next)){
+                    free.push_back(next);
+                }
+            }
+        }
+    }
+
+    for(const Course::Coordinate& coordinate : spread(free, MAX_CLAIMS)){
+        GameAction action;
+        action.type = ActionType::CLAIM;
+        action.x = coordinate.x();
+        action.y = coordinate.y();
+        actions.push_back(action);
+    }
+    for(const GameAction& action : spread(builds, MAX_BUILDS)){
+        actions.push_back(action);
+    }
+    for(const GameAction& action : spread(recruits, MAX_RECRUITS)){
+        actions.push_back(action);
+    }
+
+    std::shared_ptr<Course::ResourceMap> resources = player->getResourceMap();
+    for(Course::BasicResource resource : SOLD_RESOURCES){
+        auto amount = resources->find(resource);
+        if(amount != resources->end() && amount->second >= MIN_SALE){
+            GameAction action;
+            action.type = ActionType::SELL;
+            action.resource = resource;
+            action.value = amount->second / 2;
+            actions.push_back(action);
+        }
+    }
+
+    return actions;
+}
+
+/**
+ * @brief Search state shared by the rollout threads
+ */
+class SearchTree
+{
+public:
+    SearchTree(const ForkPoint& point, const MonteCarloSettings& settings,
+               std::chrono::steady_clock::time_point deadline) :
+        point_(point),
+        settings_(settings),
+        deadline_(deadline)
+    {
+    }
+
+    /**
+     * @brief Lists the actions of the root, stops there if the game is over
+     * @return False if there is nothing to search
+     */
+    bool prepare()
+    {
+        std::unique_ptr<GameManager> game = GameManager::fork(point_);
+        if(game == nullptr || game->gameOver_){
+            return false;
+        }
+        player_ = game->getCurrentPlayerIndex();
+        baseline_ = game->getPlayerScores().at(player_).second;
+
+        root_.untried = candidateActions(*game);
+        std::reverse(root_.untried.begin(), root_.untried.end());
+        root_.expanded = true;
+        nodes_ = 1;
+        return root_.untried.size() > 1;
+    }
+
+    /**
+     * @brief Runs rollouts until the budget is used
+     * @param seed - Seed of the thread's rollouts
+     */
+    void work(unsigned int seed)
+    {
+        std::mt19937 random(seed);
+        while(std::chrono::steady_clock::now() < deadline_){
+            if(settings_.maxRollouts > 0 &&
+                    started_.fetch_add(1) >= settings_.maxRollouts){
+                return;
+            }
+            iterate(random);
+        }
+    }
+
+    /**
+     * @brief Follows the most visited children from the root
+     * @return Actions of the plan, without END_TURN
+     */
+    std::vector<GameAction> bestPlan() const
+    {
+        std::vector<GameAction> plan;
+        const Node* node = &root_;
+        while(!node->children.empty()){
+            const Node* best = nullptr;
+            for(const std::unique_ptr<Node>& child : node->children){
+                if(best == nullptr || child->visits > best->visits){
+                    best = child.get();
+                }
+            }
+            if(best->action.type == ActionType::END_TURN){
+                break;
+            }
+            plan.push_back(best->action);
+            node = best;
+        }
+        return plan;
+    }
+
+    int getRollouts() const
+    {
+        return root_.visits;
+    }
+
+    int getNodes() const
+    {
+        return nodes_;
+    }
+
+private:
+    /**
+     * @brief Selects a path, adds a node to its end and rolls it out
+     */
+    void iterate(std::mt19937& random)
+    {
+        std::vector<Node*> path;
+        Node* leaf = select(path);
+
+        std::unique_ptr<GameManager> game = GameManager::fork(point_);
+        double reward = 0;
+        if(game != nullptr){
+            try{
+                for(unsigned int i=1; i<path.size(); i++){
+                    MonteCarloPolicy::applyPathAction(*game,
+                                                      path.at(i)->action);
+                }
+                expand(leaf, *game, path);
+                reward = rollout(*game, random);
+            }
+            catch(const Course::BaseException&){
+                // Actions listed for a state are legal in it
+            }
+            catch(const std::exception&){
+                // Scored as a loss, an exception must not leave the
+                // worker thread
+            }
+        }
+
+        QMutexLocker lock(&mutex_);
+        for(Node* node : path){
+            node->visits++;
+            node->running--;
+            node->reward += reward;
+        }
+    }
+
+    /**
+     * @brief Descends by UCB1 to a node that still has untried actions or
+     * ends the turn
+     * @param path - Nodes passed, the root first
+     * @return Last node of the path
+     */
+    Node* select(std::vector<Node*>& path)
+    {
+        QMutexLocker lock(&mutex_);
+        Node* node = &root_;
+        node->running++;
+        path.push_back(node);
+
+        while(node->expanded && node->untried.empty() &&
+              !node->children.empty()){
+            // Running rollouts count as lost ones
+            double total = std::log(node->visits + node->running);
+            Node* best = nullptr;
+            double bestValue = 0;
+            for(const std::unique_ptr<Node>& child : node->children){
+                double tries = child->visits + child->running;
+                double value = tries == 0 ? INFINITY
+                        : child->reward / tries +
+                          EXPLORATION * std::sqrt(total / tries);
+                if(best == nullptr || value > bestValue){
+                    best = child.get();
+                    bestValue = value;
+                }
+            }
+            node = best;
+            node->running++;
+            path.push_back(node);
+        }
+        return node;
+    }
+
+    /**
+     * @brief Lists the actions of a reached node and adds a child for one
+     * of them to the path
+     * @param leaf - Last node of the path, the game is in its state
+     */
+    void expand(Node* leaf, GameManager& game, std::vector<Node*>& path)
+    {
+        bool terminal = leaf->action.type == ActionType::END_TURN ||
+                leaf->depth >= settings_.maxActions;
+        if(leaf == &root_){
+            terminal = false;
+        }
+
+        std::vector<GameAction> actions;
+        bool listed = false;
+        {
+            QMutexLocker lock(&mutex_);
+            listed = leaf->expanded;
+        }
+        if(!listed && !terminal){
+            actions = candidateActions(game);
+            std::reverse(actions.begin(), actions.end());
+        }
+
+        Node* child = nullptr;
+        {
+            QMutexLocker lock(&mutex_);
+            if(!leaf->expanded){
+                leaf->untried = std::move(actions);
+                leaf->expanded = true;
+            }
+            if(leaf->untried.empty()){
+                return;
+            }
+
+            leaf->children.push_back(std::make_unique<Node>());
+            child = leaf->children.back().get();
+            child->action = leaf->untried.back();
+            child->depth = leaf->depth + 1;
+            child->running = 1;
+            leaf->untried.pop_back();
+            nodes_++;
+            path.push_back(child);
+        }
+
+        MonteCarloPolicy::applyPathAction(game, child->action);
+    }
+
+    /**
+     * @brief Ends the turn and plays the horizon with simple policies
+     * @return Share of the player of its score and the baseline
+     */
+    double rollout(GameManager& game, std::mt19937& random) const
+    {
+        PV_PROFILE_SCOPE("MonteCarloPolicy::rollout");
+
+        game.endTurn();
+
+        ScriptedPolicy scripted;
+        RandomPolicy randomPolicy(random());
+        int players = game.getPlayerScores().size();
+        for(int turn=0; turn<settings_.horizon * players &&
+            !game.gameOver_; turn++){
+            if(random() % RANDOM_TURNS == 0){
+                randomPolicy.playTurn(game);
+            } else {
+                scripted.playTurn(game);
+            }
+            game.endTurn();
+        }
+
+        // Best other score, or the own score at the root when alone
+        std::vector<std::pair<std::string, int>> scores =
+                game.getPlayerScores();
+        int rival = players > 1 ? INT_MIN : baseline_;
+        for(int i=0; i<players; i++){
+            if(i != player_){
+                rival = std::max(rival, scores.at(i).second);
+            }
+        }
+        double own = std::max(0, scores.at(player_).second);
+        double other = std::max(0, rival);
+        return own + other > 0 ? own / (own + other) : 0.5;
+    }
+
+    const ForkPoint& point_;
+    const MonteCarloSettings& settings_;
+    const std::chrono::steady_clock::time_point deadline_;
+
+    QMutex mutex_;
+    Node root_;
+    int nodes_ = 0;
+    int player_ = 0;
+    int baseline_ = 0;
+    std::atomic<int> started_{0};
+};
+
+/**
+ * @brief Runs rollouts on a pool thread
+ */
+class RolloutTask : public QRunnable
+{
+public:
+    RolloutTask(SearchTree& tree, unsigned int seed) :
+        tree_(tree),
+        seed_(seed)
+    {
+    }
+
+    void run() override
+    {
+        tree_.work(seed_);
+    }
+
+private:
+    SearchTree& tree_;
+    unsigned int seed_;
+};
+
+}
+
+MonteCarloPolicy::MonteCarloPolicy(const MonteCarloSettings &settings) :
+    settings_(settings)
+{
+    if(settings_.threads > 0){
+        pool_.setMaxThreadCount(settings_.threads);
+    }
+}
+
+void MonteCarloPolicy::playTurn(GameManager &game)
+{
+    for(const GameAction& action : search(game.captureState())){
+        try{
+            game.applyAction(action);
+        }
+        catch(const Course::BaseException&){
+            // Searched on the same state, rejected ones are skipped
+        }
+    }
+}
+
+void MonteCarloPolicy::applyPathAction(GameManager &game,
+                                       const GameAction &action)
+{
+    if(action.type != ActionType::END_TURN){
+        game.applyAction(action);
+    }
+}
+
+std::string MonteCarloPolicy::getName() const
+{
+    return "mcts";
+}
+
+std::vector<GameAction> MonteCarloPolicy::search(const ForkPoint &point)
+{
+    PV_PROFILE_SCOPE("MonteCarloPolicy::search");
+
+    std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+    SearchTree tree(point, settings_,
+                    start + std::chrono::milliseconds(settings_.budget));
+    lastStats_ = SearchStats();
+    searches_++;
+    if(!tree.prepare()){
+        return {};
+    }
+
+    // Seeds depend only on the settings, the turn and the thread
+    int threads = pool_.maxThreadCount();
+    std::seed_seq seeds{settings_.seed, searches_};
+    std::vector<unsigned int> threadSeeds(threads);
+    seeds.generate(threadSeeds.begin(), threadSeeds.end());
+    for(int i=0; i<threads; i++){
+        pool_.start(new RolloutTask(tree, threadSeeds.at(i)));
+    }
+    pool_.waitForDone();
+
+    lastStats_.rollouts = tree.getRollouts();
+    lastStats_.nodes = tree.getNodes();
+    lastStats_.elapsed = std::chrono::duration_cast<
+            std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                       start).count();
+    PV_PROFILE_COUNT("MonteCarloPolicy::rollouts", lastStats_.rollouts);
+    return tree.bestPlan();
+}
+
+SearchStats MonteCarloPolicy::getLastStats() const
+{
+    return lastStats_;
+}
+
+}
@@ -0,0 +1,115 @@
+#ifndef MONTECARLOPOLICY_HH
+#define MONTECARLOPOLICY_HH
+
+#include "ai/playerpolicy.hh"
+#include "core/actionlog.hh"
+
+#include <QThreadPool>
+
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Settings of a MonteCarloPolicy
+ */
+struct MonteCarloSettings
+{
+    // Thinking time per turn in milliseconds
+    int budget = 1000;
+    // Stops earlier after this many rollouts, 0 for no limit
+    int maxRollouts = 0;
+    // Rollout threads, 0 uses every core
+    int threads = 0;
+    // Rounds played after the turn before the scores are compared
+    int horizon = 4;
+    // Most actions in one turn
+    int maxActions = 4;
+    // Seed of the rollouts
+    unsigned int seed = 1;
+};
+
+/**
+ * @brief Counters of the last search
+ */
+struct SearchStats
+{
+    int rollouts = 0;
+    int nodes = 0;
+    // Wall clock time of the search in microseconds
+    qint64 elapsed = 0;
+};
+
+/**
+ * @brief The MonteCarloPolicy class chooses the actions of a turn with
+ * Monte-Carlo tree search.
+ *
+ * The tree holds the actions of the current turn: claims next to the
+ * player's land, builds, recruits and sales, and ending the turn. Each
+ * rollout forks the captured state, does the actions of one path of the
+ * tree and plays the following rounds with ScriptedPolicy and
+ * RandomPolicy turns for everyone. The reward is the player's share of its
+ * score and the best other score at the end. Rollouts run in parallel on a
+ * thread pool sharing one tree, paths being rolled out count as losses
+ * until they finish so threads spread over the tree.
+ *
+ * With one thread and maxRollouts set the choices only depend on the seed
+ * and the state. Otherwise they depend on the speed of the machine.
+ */
+class MonteCarloPolicy : public PlayerPolicy
+{
+public:
+    /**
+     * @brief Constructor for the class
+     * @param settings - Search settings
+     */
+    explicit MonteCarloPolicy(const MonteCarloSettings& settings);
+
+    /**
+     * @copydoc PlayerPolicy::playTurn
+     */
+    void playTurn(GameManager& game) override;
+
+    /**
+     * @copydoc PlayerPolicy::getName
+     */
+    std::string getName() const override;
+
+    /**
+     * @brief Searches the actions of the current player of a captured state
+     * @param point - Captured state, see GameManager::captureState
+     * @return Actions in order, without END_TURN. Empty if the game is over
+     * or the player has nothing to do
+     * @post Exception guarantee: Basic
+     * @note Blocks for the time budget
+     */
+    std::vector<GameAction> search(const ForkPoint& point);
+
+    /**
+     * @brief Gets the counters of the last search
+     * @post Exception guarantee: No-throw
+     */
+    SearchStats getLastStats() const;
+
+    /**
+     * @brief Does one action of a tree path on a fork of the searched
+     * state. END_TURN is left to the rollout, so a path that ends the turn
+     * reaches the same state on every visit.
+     * @param game - Fork of the searched state
+     * @param action - Action of a tree node
+     * @post Exception guarantee: Strong
+     * @exceptions See GameManager::applyAction
+     */
+    static void applyPathAction(GameManager& game, const GameAction& action);
+
+private:
+    MonteCarloSettings settings_;
+    QThreadPool pool_;
+    // Searches done, varies the rollouts of every turn
+    unsigned int searches_ = 0;
+    SearchStats lastStats_;
+};
+
+}
+
+#endif // MONTECARLOPOLICY_HH
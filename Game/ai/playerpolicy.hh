@@ -0,0 +1,37 @@
+#ifndef PLAYERPOLICY_HH
+#define PLAYERPOLICY_HH
+
+#include "core/gamemanager.hh"
+
+#include <string>
+
+namespace Game {
+
+/**
+ * @brief The PlayerPolicy class is the interface of computer players.
+ * A policy plays the turn of the current player through the GameManager
+ * but does not end the turn.
+ */
+class PlayerPolicy
+{
+public:
+    virtual ~PlayerPolicy() = default;
+
+    /**
+     * @brief Makes the actions of the current player for this turn
+     * @param game - Running game
+     * @post Exception guarantee: Basic
+     * @note Rejected actions are ignored, the turn is not ended
+     */
+    virtual void playTurn(GameManager& game) = 0;
+
+    /**
+     * @brief Gets the name of the policy
+     * @return Name used on the command line and in results
+     */
+    virtual std::string getName() const = 0;
+};
+
+}
+
+#endif // PLAYERPOLICY_HH
@@ -0,0 +1,84 @@
+#include "randompolicy.hh"
+
+namespace Game {
+
+namespace {
+
+// Attempts per turn, rejected ones count too
+const int ACTIONS_PER_TURN = 6;
+const int MAX_SELL_AMOUNT = 30;
+
+const std::vector<QString> BUILDINGS = {
+    FARM, HQ, OUTPOST, MINE, FISHING_BOAT, LAKE_COTTAGE
+};
+const std::vector<QString> WORKERS = {
+    WORKER_BASIC, WORKER_FARMER, WORKER_MINER
+};
+const std::vector<Course::BasicResource> SOLD_RESOURCES = {
+    Course::FOOD, Course::WOOD, Course::STONE, Course::ORE
+};
+
+/**
+ * @brief Gets the coordinates of the tiles the player has claimed
+ */
+std::vector<Course::Coordinate> ownedTiles(
+        const std::shared_ptr<Player>& player)
+{
+    std::vector<Course::Coordinate> owned;
+    for(const auto& object : player->getObjects()){
+        if(std::dynamic_pointer_cast<Course::TileBase>(object) != nullptr){
+            owned.push_back(object->getCoordinate());
+        }
+    }
+    return owned;
+}
+
+}
+
+RandomPolicy::RandomPolicy(unsigned int seed) :
+    random_(seed)
+{
+}
+
+void RandomPolicy::playTurn(GameManager &game)
+{
+    std::pair<int, int> size = game.getMapSize();
+
+    for(int i=0; i<ACTIONS_PER_TURN; i++){
+        std::vector<Course::Coordinate> owned =
+                ownedTiles(game.getCurrentPlayer());
+
+        try{
+            switch(random_() % 4){
+            case 0:
+                game.claimArea(Course::Coordinate(random_() % size.first,
+                                                  random_() % size.second));
+                break;
+            case 1:
+                if(!owned.empty()){
+                    game.addBuildingOnTile(pick(owned), pick(BUILDINGS));
+                }
+                break;
+            case 2:
+                if(!owned.empty()){
+                    game.addWorkerOnTile(pick(owned), pick(WORKERS));
+                }
+                break;
+            default:
+                game.sellResource(pick(SOLD_RESOURCES),
+                                  1 + random_() % MAX_SELL_AMOUNT);
+                break;
+            }
+        }
+        catch(const Course::BaseException&){
+            // Illegal moves are simply wasted
+        }
+    }
+}
+
+std::string RandomPolicy::getName() const
+{
+    return "random";
+}
+
+}
@@ -0,0 +1,50 @@
+#ifndef RANDOMPOLICY_HH
+#define RANDOMPOLICY_HH
+
+#include "ai/playerpolicy.hh"
+
+#include <random>
+
+namespace Game {
+
+/**
+ * @brief The RandomPolicy class makes random actions: claims random tiles,
+ * builds and recruits on random owned tiles and sells random resources.
+ * The same seed always makes the same choices.
+ */
+class RandomPolicy : public PlayerPolicy
+{
+public:
+    /**
+     * @brief Constructor for the class
+     * @param seed - Seed of the policy's own random generator
+     */
+    explicit RandomPolicy(unsigned int seed);
+
+    /**
+     * @copydoc PlayerPolicy::playTurn
+     */
+    void playTurn(GameManager& game) override;
+
+    /**
+     * @copydoc PlayerPolicy::getName
+     */
+    std::string getName() const override;
+
+private:
+    /**
+     * @brief Picks a random element
+     * @pre List is not empty
+     */
+    template<typename T>
+    const T& pick(const std::vector<T>& list)
+    {
+        return list.at(random_() % list.size());
+    }
+
+    std::mt19937 random_;
+};
+
+}
+
+#endif // RANDOMPOLICY_HH
@@ -0,0 +1,133 @@
+#include "scriptedpolicy.hh"
+
+namespace Game {
+
+namespace {
+
+// Resources above this are sold
+const int SURPLUS_LIMIT = 100;
+
+const std::map<TypeTag, QString> BUILDING_FOR_TILE = {
+    {TypeTag::GRASSLAND, FARM},
+    {TypeTag::FOREST, OUTPOST},
+    {TypeTag::MOUNTAIN, MINE},
+    {TypeTag::LAKE, LAKE_COTTAGE},
+    {TypeTag::OCEAN, FISHING_BOAT}
+};
+
+std::vector<Course::Coordinate> ownedTiles(
+        const std::shared_ptr<Player>& player)
+{
+    std::vector<Course::Coordinate> owned;
+    for(const auto& object : player->getObjects()){
+        if(std::dynamic_pointer_cast<Course::TileBase>(object) != nullptr){
+            owned.push_back(object->getCoordinate());
+        }
+    }
+    return owned;
+}
+
+}
+
+void ScriptedPolicy::playTurn(GameManager &game)
+{
+    std::vector<Course::Coordinate> owned =
+            ownedTiles(game.getCurrentPlayer());
+    claimNext(game, owned);
+    owned = ownedTiles(game.getCurrentPlayer());
+
+    std::shared_ptr<ObjectManager> objects = game.getObjectManager();
+    for(const Course::Coordinate& coordinate : owned){
+        std::shared_ptr<Course::TileBase> tile = objects->getTile(coordinate);
+
+        // Actions that can't be done now are tried again next turn
+        TypeTag type = tile->getTypeTag();
+        if(tile->getBuildingCount() == 0 &&
+                BUILDING_FOR_TILE.count(type) != 0){
+            const QString& building = BUILDING_FOR_TILE.at(type);
+            if(game.canAddBuilding(coordinate, building) ==
+                    ActionError::NONE){
+                game.addBuildingOnTile(coordinate, building);
+            }
+        } else if(tile->getWorkerCount() == 0){
+            QString worker = WORKER_BASIC;
+            if(type == TypeTag::MOUNTAIN){
+                worker = WORKER_MINER;
+            } else if(type == TypeTag::GRASSLAND){
+                worker = WORKER_FARMER;
+            }
+            if(game.canAddWorkers(coordinate, worker) == ActionError::NONE){
+                game.addWorkerOnTile(coordinate, worker);
+            }
+        }
+    }
+
+    std::shared_ptr<Course::ResourceMap> resources =
+            game.getCurrentPlayer()->getResourceMap();
+    for(Course::BasicResource resource :
+        {Course::WOOD, Course::STONE, Course::ORE}){
+        int surplus = (*resources)[resource] - SURPLUS_LIMIT;
+        if(surplus > 0){
+            game.sellResource(resource, surplus);
+        }
+    }
+}
+
+std::string ScriptedPolicy::getName() const
+{
+    return "scripted";
+}
+
+void ScriptedPolicy::claimNext(GameManager &game,
+                               const std::vector<Course::Coordinate> &owned)
+{
+    std::pair<int, int> size = game.getMapSize();
+    std::shared_ptr<ObjectManager> objects = game.getObjectManager();
+
+    // Players start from different columns so they don't block each other
+    Course::Coordinate home(
+                (game.getCurrentPlayerIndex() * 2 + 1) * size.first / 8 %
+                size.first,
+                size.second / 2);
+    if(!owned.empty()){
+        home = owned.front();
+    }
+
+    auto claimable = [&objects](const Course::Coordinate& coordinate){
+        TypeTag type = objects->getTileTag(coordinate);
+        return type != TypeTag::UNKNOWN && !typeTraits(type).water &&
+                objects->getTileOwner(coordinate) == nullptr;
+    };
+
+    // Search rings of growing walking distance. The topmost, then leftmost
+    // tile of the first ring with free land wins
+    bool found = claimable(home);
+    Course::Coordinate best = home;
+    int maxRadius = size.first + size.second;
+    for(int radius=1; radius<=maxRadius && !found; radius++){
+        NeighbourRange ring = NeighbourRange(home, radius, Connectivity::FOUR,
+                                             true).clippedTo(size.first,
+                                                             size.second);
+        for(Course::Coordinate coordinate : ring){
+            if(!claimable(coordinate)){
+                continue;
+            }
+            if(!found || coordinate.y() < best.y() ||
+                    (coordinate.y() == best.y() && coordinate.x() < best.x())){
+                found = true;
+                best = coordinate;
+            }
+        }
+    }
+
+    if(!found){
+        return;
+    }
+
+    // Waits for money otherwise
+    if(game.canClaimArea(best) == ActionError::NONE){
+        game.claimArea(best);
+    }
+}
+
+}
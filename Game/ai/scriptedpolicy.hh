@@ -0,0 +1,40 @@
+#ifndef SCRIPTEDPOLICY_HH
+#define SCRIPTEDPOLICY_HH
+
+#include "ai/playerpolicy.hh"
+
+namespace Game {
+
+/**
+ * @brief The ScriptedPolicy class plays a fixed builder strategy:
+ * every turn it claims the closest free land tile to its first tile,
+ * builds the building suited for each empty owned tile, recruits a worker
+ * for every tile with a building and sells surplus resources.
+ * Makes no random choices.
+ */
+class ScriptedPolicy : public PlayerPolicy
+{
+public:
+    ScriptedPolicy() = default;
+
+    /**
+     * @copydoc PlayerPolicy::playTurn
+     */
+    void playTurn(GameManager& game) override;
+
+    /**
+     * @copydoc PlayerPolicy::getName
+     */
+    std::string getName() const override;
+
+private:
+    /**
+     * @brief Claims the closest free land tile to the first owned tile
+     */
+    void claimNext(GameManager& game,
+                   const std::vector<Course::Coordinate>& owned);
+};
+
+}
+
+#endif // SCRIPTEDPOLICY_HH
@@ -0,0 +1,22 @@
+#include "turnplanner.hh"
+#include "core/profiler.hh"
+
+namespace Game {
+
+std::vector<GameAction> planTurn(PlayerPolicy &policy, const ForkPoint &point)
+{
+    PV_PROFILE_SCOPE("planTurn");
+
+    std::unique_ptr<GameManager> game = GameManager::fork(point);
+    if(game == nullptr || game->gameOver_){
+        return {};
+    }
+
+    // Only accepted actions get recorded
+    std::shared_ptr<ActionLog> log = std::make_shared<ActionLog>();
+    game->setActionLog(log);
+    policy.playTurn(*game);
+    return log->getActions();
+}
+
+}
@@ -0,0 +1,27 @@
+#ifndef TURNPLANNER_HH
+#define TURNPLANNER_HH
+
+#include "ai/playerpolicy.hh"
+#include "core/actionlog.hh"
+
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Plays the turn of the current player of a captured state on a
+ * fork, so a policy can think on another thread while the game itself
+ * stays untouched. Doing the returned actions on the game with
+ * GameManager::applyAction then gives the state the policy would have
+ * made playing on the game directly.
+ * @param policy - Policy of the current player
+ * @param point - Captured state, see GameManager::captureState
+ * @return Accepted actions in order, without END_TURN
+ * @post Exception guarantee: Basic
+ * @note The policy must not be used by another thread at the same time
+ */
+std::vector<GameAction> planTurn(PlayerPolicy& policy, const ForkPoint& point);
+
+}
+
+#endif // TURNPLANNER_HH
@@ -26,6 +26,11 @@ std::string BuildingBase::getType() const
     return "BuildingBase";
 }
 
+Game::TypeTag BuildingBase::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 void BuildingBase::doSpecialAction()
 {
     qDebug() << "BuildingBase - doSpecialAction";
@@ -38,9 +43,18 @@ void BuildingBase::onBuildAction()
 
 ResourceMap BuildingBase::getProduction()
 {
-    if( m_hold > 0 )
+    return getNextProduction();
+}
+
+bool BuildingBase::isHeld() const
+{
+    return m_hold > 0;
+}
+
+ResourceMap BuildingBase::getNextProduction() const
+{
+    if( isHeld() )
     {
-        m_hold -= 1;
         return {};
     }
     return PRODUCTION_EFFECT;
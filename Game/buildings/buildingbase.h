@@ -3,6 +3,7 @@
 
 #include "core/placeablegameobject.h"
 #include "core/basicresources.h"
+#include "core/resourcemaps.h"
 
 
 namespace Course {
@@ -21,9 +22,12 @@ class TileBase;
 class BuildingBase : public PlaceableGameObject
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::BUILDING;
 
-    const ResourceMap BUILD_COST;
-    const ResourceMap PRODUCTION_EFFECT;
+
+    // Refer to the shared definitions of the type, see resourcemaps.h
+    const ResourceMap& BUILD_COST;
+    const ResourceMap& PRODUCTION_EFFECT;
 
     /**
      * @brief Disabled parameterless constructor.
@@ -38,6 +42,8 @@ public:
      * @param descriptions contains descriptions and flavor texts.
      * @param tile points to the tile upon which the building is constructed.
      * @param hold is the initial amount of hold-markers.
+     * @param buildcost and production are kept by reference and must
+     * outlive the building, use the maps in resourcemaps.h.
      *
      * @post Exception guarantee: No guarantee.
      * @exception OwnerConflict - if the building conflicts with tile's
@@ -48,10 +54,28 @@ public:
             const std::shared_ptr<iObjectManager>& objectmanager,
             const std::shared_ptr<PlayerBase>& owner,
             const int& tilespaces = 1,
-            const ResourceMap& buildcost = {},
-            const ResourceMap& production = {}
+            const ResourceMap& buildcost = ConstResourceMaps::EMPTY,
+            const ResourceMap& production = ConstResourceMaps::EMPTY
             );
 
+    /**
+     * @brief Cost and production maps are kept by reference, temporaries
+     * are not accepted.
+     */
+    BuildingBase(const std::shared_ptr<iGameEventHandler>& eventhandler,
+                 const std::shared_ptr<iObjectManager>& objectmanager,
+                 const std::shared_ptr<PlayerBase>& owner,
+                 const int& tilespaces,
+                 ResourceMap&& buildcost,
+                 const ResourceMap& production =
+                     ConstResourceMaps::EMPTY) = delete;
+    BuildingBase(const std::shared_ptr<iGameEventHandler>& eventhandler,
+                 const std::shared_ptr<iObjectManager>& objectmanager,
+                 const std::shared_ptr<PlayerBase>& owner,
+                 const int& tilespaces,
+                 const ResourceMap& buildcost,
+                 ResourceMap&& production) = delete;
+
     /**
      * @brief Default destructor.
      */
@@ -62,6 +86,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
     /**
      * @brief Performs building's default action.
      */
@@ -82,9 +111,25 @@ public:
      */
     virtual ResourceMap getProduction();
 
+    /**
+     * @brief Returns what the next getProduction call will return.
+     * @post Exception guarantee: No-throw
+     * @note Override together with getProduction.
+     */
+    virtual ResourceMap getNextProduction() const;
+
+    /**
+     * @brief Tells if hold-markers keep the building from producing.
+     * @post Exception guarantee: No-throw
+     * @note Override together with getProduction.
+     */
+    virtual bool isHeld() const;
+
     /**
      * @brief Adds the amount to hold-markers.
      * @note Negative amounts can be used for substraction.
+     * @note Producing doesn't use markers up, Game::GameManager removes them
+     * with its turn timers once as many turns have ended.
      * @param amount the amount being added.
      * @post Exception guarantee: No-throw
      */
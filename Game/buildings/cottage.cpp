@@ -24,13 +24,15 @@ std::string Cottage::getType() const
     return "Lake Cottage";
 }
 
+Game::TypeTag Cottage::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 bool Cottage::canBePlacedOnTile(const std::shared_ptr<Course::TileBase> &target) const
 {
-    if (QString::fromStdString(target->getType()) == LAKE) {
-        return true;
-    } else {
-        return false;
-    }
+    // Terrain rules are in the traits table
+    return canPlaceBuilding(TYPE_TAG, target->getTypeTag());
 }
 
 
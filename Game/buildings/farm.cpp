@@ -26,5 +26,10 @@ std::string Farm::getType() const
     return "Farm";
 }
 
+Game::TypeTag Farm::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 
 } // namespace Course
@@ -15,6 +15,8 @@ namespace Course {
 class Farm : public BuildingBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::FARM;
+
     /**
      * @brief Disabled parameterless constructor.
      */
@@ -40,6 +42,24 @@ public:
             const ResourceMap& production = ConstResourceMaps::FARM_PRODUCTION
             );
 
+    /**
+     * @brief Cost and production maps are kept by reference, temporaries
+     * are not accepted.
+     */
+    Farm(const std::shared_ptr<iGameEventHandler>& eventhandler,
+         const std::shared_ptr<iObjectManager>& objectmanager,
+         const std::shared_ptr<PlayerBase>& owner,
+         const int& tilespaces,
+         ResourceMap&& buildcost,
+         const ResourceMap& production =
+             ConstResourceMaps::FARM_PRODUCTION) = delete;
+    Farm(const std::shared_ptr<iGameEventHandler>& eventhandler,
+         const std::shared_ptr<iObjectManager>& objectmanager,
+         const std::shared_ptr<PlayerBase>& owner,
+         const int& tilespaces,
+         const ResourceMap& buildcost,
+         ResourceMap&& production) = delete;
+
     /**
      * @brief Default destructor.
      */
@@ -50,6 +70,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
 }; // class Farm
 
 } // namespace Course
@@ -24,14 +24,15 @@ std::string FishingBoat::getType() const
     return "Fishing Boat";
 }
 
+Game::TypeTag FishingBoat::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 bool FishingBoat::canBePlacedOnTile(const std::shared_ptr<Course::TileBase> &target) const
 {
-    QString type = QString::fromStdString(target->getType());
-    if (type == OCEAN || type == LAKE) {
-        return true;
-    } else {
-        return false;
-    }
+    // Terrain rules are in the traits table
+    return canPlaceBuilding(TYPE_TAG, target->getTypeTag());
 }
 
 
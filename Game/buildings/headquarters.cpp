@@ -1,4 +1,5 @@
 #include "headquarters.h"
+#include "interfaces/iobjectmanager.h"
 #include "tiles/tilebase.h"
 
 
@@ -26,20 +27,19 @@ std::string HeadQuarters::getType() const
     return "HeadQuarters";
 }
 
+Game::TypeTag HeadQuarters::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 void HeadQuarters::onBuildAction()
 {
-    std::vector< std::shared_ptr<TileBase> > neighbours =
-            lockObjectManager()->getTiles(getCoordinatePtr()->neighbours(3));
-
-    for(auto it = neighbours.begin(); it != neighbours.end(); ++it)
-    {
-        // If the Tile doesn't have owner, set it's owner to buildings owner.
-        if( not (*it)->getOwner() )
-        {
-            (*it)->setOwner(getOwner());
-        }
-    }
-    lockObjectManager()->getTile(getCoordinate())->setOwner(getOwner());
+    std::shared_ptr<iObjectManager> objectmanager = lockObjectManager();
+
+    // Tiles without owner around the building go to the buildings owner.
+    objectmanager->claimUnowned(Game::NeighbourRange(getCoordinate(), 3),
+                                getOwner());
+    objectmanager->getTile(getCoordinate())->setOwner(getOwner());
 }
 
 
@@ -18,6 +18,8 @@ namespace Course {
 class HeadQuarters : public BuildingBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::HEADQUARTERS;
+
     /**
      * @brief Disabled parameterless constructor.
      */
@@ -43,6 +45,24 @@ public:
             const ResourceMap& production = ConstResourceMaps::HQ_PRODUCTION
             );
 
+    /**
+     * @brief Cost and production maps are kept by reference, temporaries
+     * are not accepted.
+     */
+    HeadQuarters(const std::shared_ptr<iGameEventHandler>& eventhandler,
+                 const std::shared_ptr<iObjectManager>& objectmanager,
+                 const std::shared_ptr<PlayerBase>& owner,
+                 const int& tilespaces,
+                 ResourceMap&& buildcost,
+                 const ResourceMap& production =
+                     ConstResourceMaps::HQ_PRODUCTION) = delete;
+    HeadQuarters(const std::shared_ptr<iGameEventHandler>& eventhandler,
+                 const std::shared_ptr<iObjectManager>& objectmanager,
+                 const std::shared_ptr<PlayerBase>& owner,
+                 const int& tilespaces,
+                 const ResourceMap& buildcost,
+                 ResourceMap&& production) = delete;
+
     /**
      * @brief Default destructor.
      */
@@ -53,6 +73,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
     /**
      * @brief Sets neighbouring Tiles' ownership to this building's
      * ownership in 3 tile-radius, if the Tiles don't already have an owner.
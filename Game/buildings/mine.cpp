@@ -24,14 +24,15 @@ std::string Mine::getType() const
     return "Mine";
 }
 
-bool Mine::canBePlacedOnTile(const std::shared_ptr<Course::TileBase> &target) const
+Game::TypeTag Mine::getTypeTag() const
 {
-    if (QString::fromStdString(target->getType()) == MOUNTAIN) {
-        return true;
-    } else {
-        return false;
-    }
+    return TYPE_TAG;
+}
 
+bool Mine::canBePlacedOnTile(const std::shared_ptr<Course::TileBase> &target) const
+{
+    // Terrain rules are in the traits table
+    return canPlaceBuilding(TYPE_TAG, target->getTypeTag());
 }
 
 
@@ -15,8 +15,7 @@ namespace Game {
 class Mine : public Course::BuildingBase
 {
 public:
-    const Course::ResourceMap BUILD_COST;
-    const Course:: ResourceMap PRODUCTION_EFFECT;
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::MINE;
 
     /**
      * @brief Disabled parameterless constructor.
@@ -45,6 +44,23 @@ public:
             const Course::ResourceMap& production = MINE_PRODUCTION
             );
 
+    /**
+     * @brief Cost and production maps are kept by reference, temporaries
+     * are not accepted.
+     */
+    Mine(const std::shared_ptr<Course::iGameEventHandler>& eventhandler,
+         const std::shared_ptr<Course::iObjectManager>& objectmanager,
+         const std::shared_ptr<Course::PlayerBase>& owner,
+         const int& tilespaces,
+         Course::ResourceMap&& buildcost,
+         const Course::ResourceMap& production = MINE_PRODUCTION) = delete;
+    Mine(const std::shared_ptr<Course::iGameEventHandler>& eventhandler,
+         const std::shared_ptr<Course::iObjectManager>& objectmanager,
+         const std::shared_ptr<Course::PlayerBase>& owner,
+         const int& tilespaces,
+         const Course::ResourceMap& buildcost,
+         Course::ResourceMap&& production) = delete;
+
     /**
      * @brief Default destructor.
      */
@@ -52,6 +68,8 @@ public:
 
     virtual std::string getType() const override;
 
+    virtual Game::TypeTag getTypeTag() const override;
+
     /**
      * @brief Returns boolean based on wheter the building can or can't be
      * placed on a Tile-object.
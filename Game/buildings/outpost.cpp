@@ -26,20 +26,19 @@ std::string Outpost::getType() const
     return "Outpost";
 }
 
+Game::TypeTag Outpost::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 void Outpost::onBuildAction()
 {
-    std::vector< std::shared_ptr<TileBase> > neighbours =
-            lockObjectManager()->getTiles(getCoordinatePtr()->neighbours(1));
-
-    for(auto it = neighbours.begin(); it != neighbours.end(); ++it)
-    {
-        // If the Tile doesn't have owner, set it's owner to buildings owner.
-        if( not (*it)->getOwner() )
-        {
-            (*it)->setOwner(getOwner());
-        }
-    }
-    lockObjectManager()->getTile(getCoordinate())->setOwner(getOwner());
+    std::shared_ptr<iObjectManager> objectmanager = lockObjectManager();
+
+    // Tiles without owner around the building go to the buildings owner.
+    objectmanager->claimUnowned(Game::NeighbourRange(getCoordinate(), 1),
+                                getOwner());
+    objectmanager->getTile(getCoordinate())->setOwner(getOwner());
 }
 
 ResourceMap Outpost::getProduction()
@@ -49,4 +48,14 @@ ResourceMap Outpost::getProduction()
     return PRODUCTION_EFFECT;
 }
 
+ResourceMap Outpost::getNextProduction() const
+{
+    return PRODUCTION_EFFECT;
+}
+
+bool Outpost::isHeld() const
+{
+    return false;
+}
+
 } // namespace Course
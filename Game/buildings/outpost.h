@@ -24,6 +24,8 @@ static const ResourceMap OUTPOST_PRODUCTIONMAP = {
 class Outpost : public BuildingBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::OUTPOST;
+
     /**
      * @brief Disabled parameterless constructor.
      */
@@ -49,6 +51,24 @@ public:
             const ResourceMap& production = ConstResourceMaps::OUTPOST_PRODUCTION
             );
 
+    /**
+     * @brief Cost and production maps are kept by reference, temporaries
+     * are not accepted.
+     */
+    Outpost(const std::shared_ptr<iGameEventHandler>& eventhandler,
+            const std::shared_ptr<iObjectManager>& objectmanager,
+            const std::shared_ptr<PlayerBase>& owner,
+            const int& tilespaces,
+            ResourceMap&& buildcost,
+            const ResourceMap& production =
+                ConstResourceMaps::OUTPOST_PRODUCTION) = delete;
+    Outpost(const std::shared_ptr<iGameEventHandler>& eventhandler,
+            const std::shared_ptr<iObjectManager>& objectmanager,
+            const std::shared_ptr<PlayerBase>& owner,
+            const int& tilespaces,
+            const ResourceMap& buildcost,
+            ResourceMap&& production) = delete;
+
     /**
      * @brief Default destructor.
      */
@@ -59,6 +79,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
     /**
      * @brief Sets neighbouring Tiles' ownership to this building's
      * ownership in 1 tile-radius, if the Tiles don't already have an owner.
@@ -73,6 +98,16 @@ public:
      */
     virtual ResourceMap getProduction() override;
 
+    /**
+     * @copydoc BuildingBase::getNextProduction()
+     */
+    virtual ResourceMap getNextProduction() const override;
+
+    /**
+     * @copydoc BuildingBase::isHeld()
+     */
+    virtual bool isHeld() const override;
+
 }; // class Outpost
 
 } // namespace Course
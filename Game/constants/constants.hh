@@ -9,6 +9,10 @@
 const QString MAIN_TITLE = "Pirkanmaan Valloitus";
 const QString DIALOG_TITLE = "Configure the Game";
 const QString SCOREDIALOG_TITLE = "ScoreBoard";
+const QString SAVE_GAME_TITLE = "Save Game";
+const QString LOAD_GAME_TITLE = "Load Game";
+const QString SAVE_REPLAY_TITLE = "Save Replay";
+const QString EXPORT_STATS_TITLE = "Export Statistics";
 
 // Image paths
 const QString TEST_IMAGE = ":/images/images/test.png";
@@ -39,10 +43,17 @@ const QString GOLD_ICON = ":/images/images/Icons/coins.png";
 // UI values
 const int MAX_SHOP_VALUE = 500;
 const QColor HIGHLIGHT_COLOR = Qt::red;
+// Translucent fill for tiles where the selected building can be placed
+const QColor PLACEMENT_COLOR = QColor(0, 255, 0, 60);
+// Text of the production overlay
+const QColor PRODUCTION_TEXT_COLOR = Qt::white;
 
 // Buttons and elements changing
 const QString GAME_BUTTON_START = "Start The Game";
 const QString GAME_BUTTON_WHILE_GAME = "End Turn";
+const QString GAME_BUTTON_COMPUTER_TURN = "Thinking...";
+const QString GAME_BUTTON_GENERATING = "Generating...";
+const QString WORLD_PROGRESS = "Generating the world...";
 const QString PLAYERS_ADDED = "Players added";
 const QString BUILDING_ADDED = "Building added";
 const QString WORKER_ADDED = "Worker(s) added";
@@ -61,21 +72,34 @@ const QString NOT_ENOUGH_MONEY = "Not enough money";
 const QString NOT_ENOUGH_RESOURCES = "Not enough resources";
 const QString CLAIM_REQUIRED = "Tile not claimed";
 const QString TOO_MANY_BUILDINGS = "Too many buildings";
+const QString TOO_MANY_WORKERS = "No room for more workers";
 const QString TOO_MANY_BUILDINGS_THIS_TURN = "Can't build more this turn";
 const QString CANT_BE_BUILT = "Can't be built to this tile";
 const QString NOT_OWNED_TILE = "You do not own this tile";
 const QString ALREADY_OWNED_TILE = "Tile is already owned!";
+const QString SAVE_FAILED = "Could not write the save file";
+const QString LOAD_FAILED = "Not a valid save file";
+
+// Save files
+const QString SNAPSHOT_FILE_FILTER = "Saved games (*.pvsave)";
+const QString REPLAY_FILE_FILTER = "Replays (*.pvlog)";
+const QString STATS_FILE_FILTER =
+        "CSV (*.csv);;Binary statistics (*.pvstats)";
 
 // WorldGenerator
 const int FOREST_RARITY = 10;
 const int GRASSLAND_RARITY = 10;
 const int MOUNTAIN_RARITY = 2;
+// Columns the window draws at a time while the world is generated
+const int WORLD_CHUNK_COLUMNS = 4;
 
 // Game related consts
 const int MAX_PLAYERNAME_LENGTH = 12;
 const int DEFAULT_ROUND_COUNT = 30;
 const int MIN_ROUND_COUNT = 10;
 const int MAX_ROUND_COUNT = 1000;
+// Thinking time of computer players per turn in milliseconds
+const int COMPUTER_TURN_BUDGET = 1000;
 const int MIN_MAP_WIDTH = 3;
 const int MIN_MAP_HEIGHT = 2;
 
@@ -83,6 +107,9 @@ const int MIN_MAP_HEIGHT = 2;
 const int MAX_CLAIMS_PER_TURN = 2;
 const int MAX_BUILDINGS_PER_TURN = 2;
 
+// Score of one claimed tile
+const int CLAIM_SCORE = 50;
+
 // Tiles
 const QString GRASSLAND = "Grassland";
 const QString FOREST = "Forest";
@@ -44,6 +44,15 @@ const ResourceMap CLAIM_COST = {
     {MONEY, -25}
 };
 
+// Score of one unit of each resource
+const ResourceMap RESOURCE_SCORE_WEIGHTS = {
+    {MONEY, 2},
+    {FOOD, 1},
+    {WOOD, 1},
+    {STONE, 1},
+    {ORE, 2}
+};
+
 const ResourceMap FOREST_BP = {
     {MONEY, 2},
     {FOOD, 0},
@@ -0,0 +1,46 @@
+#include "actionerror.hh"
+#include "constants/constants.hh"
+#include "exceptions/illegalaction.h"
+#include "exceptions/ownerconflict.h"
+
+namespace Game {
+
+const QString &actionErrorMessage(ActionError error)
+{
+    switch(error){
+    case ActionError::NONE:
+        return EMPTY;
+    case ActionError::NOT_OWNED:
+        return NOT_OWNED_TILE;
+    case ActionError::ALREADY_OWNED:
+        return ALREADY_OWNED_TILE;
+    case ActionError::NO_BUILDING_SPACE:
+        return TOO_MANY_BUILDINGS;
+    case ActionError::NO_WORKER_SPACE:
+        return TOO_MANY_WORKERS;
+    case ActionError::NOT_ENOUGH_MONEY:
+        return NOT_ENOUGH_MONEY;
+    case ActionError::NOT_ENOUGH_RESOURCES:
+        return NOT_ENOUGH_RESOURCES;
+    case ActionError::NO_TILE:
+    case ActionError::UNKNOWN_TYPE:
+    case ActionError::CANT_BE_BUILT:
+        break;
+    }
+    return CANT_BE_BUILT;
+}
+
+void throwActionError(ActionError error)
+{
+    switch(error){
+    case ActionError::NONE:
+        return;
+    case ActionError::NOT_OWNED:
+    case ActionError::ALREADY_OWNED:
+        throw Course::OwnerConflict(actionErrorMessage(error).toStdString());
+    default:
+        throw Course::IllegalAction(actionErrorMessage(error).toStdString());
+    }
+}
+
+}
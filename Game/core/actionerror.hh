@@ -0,0 +1,49 @@
+#ifndef ACTIONERROR_HH
+#define ACTIONERROR_HH
+
+#include <QString>
+#include <QtGlobal>
+
+namespace Game {
+
+/**
+ * @brief Why a game action can't be done. The GameManager::canX queries
+ * return these without throwing or allocating, the acting methods throw
+ * the matching exception with throwActionError.
+ */
+enum class ActionError : quint8 {
+    NONE,
+    // No tile on the coordinate
+    NO_TILE,
+    NOT_OWNED,
+    ALREADY_OWNED,
+    // Name or tag isn't a building or worker type
+    UNKNOWN_TYPE,
+    // The terrain doesn't take the building
+    CANT_BE_BUILT,
+    NO_BUILDING_SPACE,
+    NO_WORKER_SPACE,
+    NOT_ENOUGH_MONEY,
+    NOT_ENOUGH_RESOURCES
+};
+
+/**
+ * @brief Gets the message shown to the player
+ * @param error - Any error
+ * @return One of the messages in constants.hh, empty for NONE
+ * @post Exception guarantee: No-throw
+ */
+const QString& actionErrorMessage(ActionError error);
+
+/**
+ * @brief Throws the exception the acting methods use for the error
+ * @param error - Result of a canX query
+ * @post Exception guarantee: Strong. Does nothing for NONE.
+ * @exceptions OwnerConflict - NOT_OWNED or ALREADY_OWNED
+ * @exceptions IllegalAction - Any other error
+ */
+void throwActionError(ActionError error);
+
+}
+
+#endif // ACTIONERROR_HH
@@ -0,0 +1,247 @@
+#include "actionlog.hh"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+namespace Game {
+
+namespace {
+
+// 2: workers are fed and paid before production, older hashes differ
+const int LOG_VERSION = 2;
+
+// Keywords in the same order as ActionType
+const std::vector<std::string> ACTION_KEYWORDS = {
+    "claim", "build", "unbuild", "recruit", "free", "sell", "end"
+};
+
+/**
+ * @brief Reads the rest of the line without the separating space
+ */
+std::string restOfLine(std::istringstream& stream)
+{
+    std::string rest;
+    std::getline(stream, rest);
+    if(!rest.empty() && rest.front() == ' '){
+        rest.erase(0, 1);
+    }
+    return rest;
+}
+
+}
+
+void ActionLog::setSettings(int seed, int mapWidth, int mapHeight,
+                            int turnCount)
+{
+    seed_ = seed;
+    mapWidth_ = mapWidth;
+    mapHeight_ = mapHeight;
+    turnCount_ = turnCount;
+}
+
+void ActionLog::addPlayer(const QString &name, const QColor &color)
+{
+    players_.push_back(std::make_pair(name, color));
+}
+
+void ActionLog::record(const GameAction &action)
+{
+    actions_.push_back(action);
+}
+
+void ActionLog::recordChecksum(const TurnChecksum &checksum)
+{
+    checksums_.push_back(checksum);
+}
+
+bool ActionLog::save(const std::string &path) const
+{
+    std::ofstream file(path);
+    if(!file){
+        return false;
+    }
+
+    file << "pvlog " << LOG_VERSION << "\n";
+    file << "seed " << seed_ << "\n";
+    file << "map " << mapWidth_ << " " << mapHeight_ << "\n";
+    file << "turns " << turnCount_ << "\n";
+
+    for(const auto& player : players_){
+        file << "player " << std::hex << std::setw(8) << std::setfill('0')
+             << player.second.rgba() << std::dec << " "
+             << player.first.toStdString() << "\n";
+    }
+
+    // Checksums are written right after the end of the turn they belong to
+    unsigned int checksum = 0;
+    for(const GameAction& action : actions_){
+        file << ACTION_KEYWORDS.at(static_cast<int>(action.type));
+
+        switch(action.type){
+        case ActionType::CLAIM:
+            file << " " << action.x << " " << action.y;
+            break;
+        case ActionType::BUILD:
+        case ActionType::RECRUIT:
+            file << " " << action.x << " " << action.y << " "
+                 << action.name.toStdString();
+            break;
+        case ActionType::REMOVE_BUILDING:
+        case ActionType::FREE_WORKER:
+            file << " " << action.x << " " << action.y << " "
+                 << action.value;
+            break;
+        case ActionType::SELL:
+            file << " " << action.resource << " " << action.value;
+            break;
+        case ActionType::END_TURN:
+            break;
+        }
+        file << "\n";
+
+        if(action.type == ActionType::END_TURN &&
+                checksum < checksums_.size()){
+            const TurnChecksum& sum = checksums_.at(checksum++);
+            file << "hash " << sum.turn << " " << sum.playerIndex << " "
+                 << std::hex << std::setw(16) << std::setfill('0')
+                 << sum.hash << std::dec << "\n";
+        }
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool ActionLog::load(const std::string &path)
+{
+    std::ifstream file(path);
+    if(!file){
+        return false;
+    }
+
+    ActionLog log;
+    std::string line;
+    bool headerFound = false;
+
+    while(std::getline(file, line)){
+        std::istringstream stream(line);
+        std::string keyword;
+        if(!(stream >> keyword)){
+            continue;
+        }
+
+        if(keyword == "pvlog"){
+            int version = 0;
+            stream >> version;
+            if(version != LOG_VERSION){
+                return false;
+            }
+            headerFound = true;
+            continue;
+        }
+        if(!headerFound){
+            return false;
+        }
+
+        if(keyword == "seed"){
+            stream >> log.seed_;
+        } else if(keyword == "map"){
+            stream >> log.mapWidth_ >> log.mapHeight_;
+        } else if(keyword == "turns"){
+            stream >> log.turnCount_;
+        } else if(keyword == "player"){
+            unsigned int rgba = 0;
+            stream >> std::hex >> rgba >> std::dec;
+            log.addPlayer(QString::fromStdString(restOfLine(stream)),
+                          QColor::fromRgba(rgba));
+        } else if(keyword == "hash"){
+            TurnChecksum checksum;
+            stream >> checksum.turn >> checksum.playerIndex
+                   >> std::hex >> checksum.hash >> std::dec;
+            log.recordChecksum(checksum);
+        } else {
+            auto found = std::find(ACTION_KEYWORDS.begin(),
+                                   ACTION_KEYWORDS.end(), keyword);
+            if(found == ACTION_KEYWORDS.end()){
+                return false;
+            }
+
+            GameAction action;
+            action.type = static_cast<ActionType>(
+                        found - ACTION_KEYWORDS.begin());
+
+            switch(action.type){
+            case ActionType::CLAIM:
+                stream >> action.x >> action.y;
+                break;
+            case ActionType::BUILD:
+            case ActionType::RECRUIT:
+                stream >> action.x >> action.y;
+                action.name = QString::fromStdString(restOfLine(stream));
+                break;
+            case ActionType::REMOVE_BUILDING:
+            case ActionType::FREE_WORKER:
+                stream >> action.x >> action.y >> action.value;
+                break;
+            case ActionType::SELL:{
+                int resource = Course::NONE;
+                stream >> resource >> action.value;
+                action.resource = static_cast<Course::BasicResource>(resource);
+                break;
+            }
+            case ActionType::END_TURN:
+                break;
+            }
+            log.record(action);
+        }
+
+        if(stream.fail()){
+            return false;
+        }
+    }
+
+    if(!headerFound){
+        return false;
+    }
+
+    *this = log;
+    return true;
+}
+
+int ActionLog::getSeed() const
+{
+    return seed_;
+}
+
+int ActionLog::getMapWidth() const
+{
+    return mapWidth_;
+}
+
+int ActionLog::getMapHeight() const
+{
+    return mapHeight_;
+}
+
+int ActionLog::getTurnCount() const
+{
+    return turnCount_;
+}
+
+const std::vector<std::pair<QString, QColor> > &ActionLog::getPlayers() const
+{
+    return players_;
+}
+
+const std::vector<GameAction> &ActionLog::getActions() const
+{
+    return actions_;
+}
+
+const std::vector<TurnChecksum> &ActionLog::getChecksums() const
+{
+    return checksums_;
+}
+
+}
@@ -0,0 +1,164 @@
+#ifndef ACTIONLOG_HH
+#define ACTIONLOG_HH
+
+#include "core/coordinate.h"
+#include "core/basicresources.h"
+
+#include <QString>
+#include <QColor>
+#include <QtGlobal>
+
+#include <string>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Player actions that change the game state
+ */
+enum class ActionType {
+    CLAIM,
+    BUILD,
+    REMOVE_BUILDING,
+    RECRUIT,
+    FREE_WORKER,
+    SELL,
+    END_TURN
+};
+
+/**
+ * @brief A single recorded player action
+ * @note Unused fields are left to zero / empty
+ */
+struct GameAction
+{
+    ActionType type;
+    int x = 0;
+    int y = 0;
+    // Building or worker index on the tile, or amount sold
+    int value = 0;
+    // Building or worker name, see constants.hh
+    QString name;
+    // Resource sold
+    Course::BasicResource resource = Course::NONE;
+};
+
+/**
+ * @brief State hash recorded after an ended turn
+ */
+struct TurnChecksum
+{
+    int turn;
+    int playerIndex;
+    quint64 hash;
+};
+
+/**
+ * @brief The ActionLog class holds everything needed to play a game again:
+ * the settings the game was started with, every action in order and the
+ * state hash after every ended turn.
+ *
+ * The log is stored as text, one entry per line:
+ * @code
+ * pvlog 2
+ * seed 1234
+ * map 30 20
+ * turns 30
+ * player ff0000ff Alice
+ * claim 3 4
+ * build 3 4 Farm
+ * sell 3 20
+ * end
+ * hash 1 0 8c3a27d0f1e2b5a4
+ * @endcode
+ */
+class ActionLog
+{
+public:
+    ActionLog() = default;
+
+    /**
+     * @brief Sets the settings the game was started with
+     * @param seed - World seed
+     * @param mapWidth - Map width in tiles
+     * @param mapHeight - Map height in tiles
+     * @param turnCount - Total turn count
+     * @post Exception guarantee: No-throw
+     */
+    void setSettings(int seed, int mapWidth, int mapHeight, int turnCount);
+
+    /**
+     * @brief Adds a player in turn order
+     * @param name - Player name
+     * @param color - Player color
+     * @post Exception guarantee: Strong
+     */
+    void addPlayer(const QString& name, const QColor& color);
+
+    /**
+     * @brief Records an action
+     * @param action - Action that succeeded
+     * @post Exception guarantee: Strong
+     */
+    void record(const GameAction& action);
+
+    /**
+     * @brief Records the state hash after a turn ended
+     * @param checksum - Turn, player and hash
+     * @post Exception guarantee: Strong
+     */
+    void recordChecksum(const TurnChecksum& checksum);
+
+    /**
+     * @brief Writes the log to a file
+     * @param path - File path
+     * @post Exception guarantee: No-throw
+     * @return True if the file was written
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Reads a log from a file
+     * @param path - File path
+     * @post Exception guarantee: Strong
+     * @return True if the file was read, false if missing or malformed
+     */
+    bool load(const std::string& path);
+
+    int getSeed() const;
+    int getMapWidth() const;
+    int getMapHeight() const;
+    int getTurnCount() const;
+
+    /**
+     * @brief Gets the players in turn order
+     * @post Exception guarantee: No-throw
+     */
+    const std::vector<std::pair<QString, QColor>>& getPlayers() const;
+
+    /**
+     * @brief Gets the actions in the order they were made
+     * @post Exception guarantee: No-throw
+     */
+    const std::vector<GameAction>& getActions() const;
+
+    /**
+     * @brief Gets the recorded checksums in turn order
+     * @post Exception guarantee: No-throw
+     */
+    const std::vector<TurnChecksum>& getChecksums() const;
+
+private:
+    int seed_ = 0;
+    int mapWidth_ = 0;
+    int mapHeight_ = 0;
+    int turnCount_ = 0;
+
+    std::vector<std::pair<QString, QColor>> players_;
+    std::vector<GameAction> actions_;
+    std::vector<TurnChecksum> checksums_;
+};
+
+}
+
+#endif // ACTIONLOG_HH
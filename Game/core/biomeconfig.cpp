@@ -0,0 +1,99 @@
+#include "biomeconfig.hh"
+#include "constants/resourcemaps2.h"
+#include "exceptions/invalidpointer.h"
+
+#include "tiles/forest.h"
+#include "tiles/grassland.h"
+#include "tiles/lake.h"
+#include "tiles/mountain.h"
+#include "tiles/ocean.hh"
+
+#include <algorithm>
+
+namespace Game {
+
+BiomeConfig::BiomeConfig(const std::vector<Biome> &biomes) :
+    biomes_(biomes)
+{
+    if(biomes_.empty()){
+        throw Course::InvalidPointer("BiomeConfig needs at least one biome");
+    }
+
+    for(const Biome& biome : biomes_){
+        bounds_.push_back(biome.min);
+        bounds_.push_back(biome.max);
+    }
+    std::sort(bounds_.begin(), bounds_.end());
+    bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
+
+    // Interval i is below bounds_[i], the last one is above every bound
+    pointCandidates_.resize(bounds_.size());
+    intervalCandidates_.resize(bounds_.size() + 1);
+
+    for(const Biome& biome : biomes_){
+        for(unsigned int i=0; i<bounds_.size(); i++){
+            if(biome.min <= bounds_.at(i) && bounds_.at(i) <= biome.max){
+                pointCandidates_.at(i).push_back(&biome);
+            }
+            // Open interval between the previous bound and this one
+            if(i > 0 && biome.min <= bounds_.at(i - 1) &&
+                    bounds_.at(i) <= biome.max){
+                intervalCandidates_.at(i).push_back(&biome);
+            }
+        }
+    }
+}
+
+std::shared_ptr<const BiomeConfig> BiomeConfig::defaultConfig()
+{
+    // Static initialization is thread safe
+    static const std::shared_ptr<const BiomeConfig> config =
+            std::make_shared<const BiomeConfig>(std::vector<Biome>{
+        biome<Game::Ocean>(0, 0.2),
+        // Forests and grasslands use the game's own productions
+        {0.2f, 0.6f, [](Course::Coordinate coordinate,
+                        std::shared_ptr<GameEventHandler> geh,
+                        std::shared_ptr<ObjectManager> om){
+             return std::make_shared<Course::Forest>(coordinate, geh, om,
+                                                     2, 3, FOREST_BP);
+         }},
+        biome<Game::Lake>(0.4, 0.41),
+        biome<Game::Lake>(0.5, 0.51),
+        {0.5f, 0.8f, [](Course::Coordinate coordinate,
+                        std::shared_ptr<GameEventHandler> geh,
+                        std::shared_ptr<ObjectManager> om){
+             return std::make_shared<Course::Grassland>(coordinate, geh, om,
+                                                        2, 3, GRASSLAND_BP);
+         }},
+        biome<Game::Mountain>(0.8, 1)
+    });
+
+    return config;
+}
+
+const std::vector<const Biome*> &BiomeConfig::getCandidates(
+        double value) const
+{
+    // First bound that is not below the value
+    unsigned int i = std::lower_bound(bounds_.begin(), bounds_.end(), value,
+                                      [](float bound, double value){
+        return bound < value;
+    }) - bounds_.begin();
+
+    if(i < bounds_.size() && bounds_.at(i) == value){
+        return pointCandidates_.at(i);
+    }
+    return intervalCandidates_.at(i);
+}
+
+const Biome &BiomeConfig::getFallback() const
+{
+    return biomes_.front();
+}
+
+const std::vector<Biome> &BiomeConfig::getBiomes() const
+{
+    return biomes_;
+}
+
+}
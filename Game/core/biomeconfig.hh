@@ -0,0 +1,111 @@
+#ifndef BIOMECONFIG_HH
+#define BIOMECONFIG_HH
+
+#include "tiles/tilebase.h"
+#include "interfaces/gameeventhandler.hh"
+#include "interfaces/objectmanager.hh"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace Game {
+
+using TileConstructorPointer = std::function<std::shared_ptr<Course::TileBase>(
+    Course::Coordinate,
+    std::shared_ptr<GameEventHandler>,
+    std::shared_ptr<ObjectManager>)>;
+
+/**
+ * @brief Tile type used for a range of noise values. Both ends of the
+ * range are inclusive.
+ */
+struct Biome
+{
+    float min;
+    float max;
+    TileConstructorPointer ctor;
+};
+
+/**
+ * @brief The BiomeConfig class tells which tiles the world generator
+ * places for each noise value. The configuration can't be changed after
+ * construction so one instance can be shared by any number of generators
+ * on any threads without locking.
+ *
+ * When several biomes overlap one of them is picked randomly. The matching
+ * biomes are precomputed for every interval between range ends so a lookup
+ * is a binary search instead of a scan over every biome.
+ */
+class BiomeConfig
+{
+public:
+    /**
+     * @brief Constructor for the class
+     * @param biomes - Biomes, order is kept when several match
+     * @pre At least one biome
+     * @exceptions InvalidPointer - No biomes given
+     */
+    explicit BiomeConfig(const std::vector<Biome>& biomes);
+
+    // Candidate lists point into biomes_
+    BiomeConfig(const BiomeConfig&) = delete;
+    BiomeConfig& operator=(const BiomeConfig&) = delete;
+
+    /**
+     * @brief Creates a biome that uses the Tile's default constructor.
+     * Use the Tile's type as the template parameter: biome<Forest>(0, 0.5);
+     * @param min - Minimum noise value, 0...1
+     * @param max - Maximum noise value, 0...1
+     * @return Biome
+     */
+    template<typename T>
+    static Biome biome(float min, float max)
+    {
+        TileConstructorPointer ctor = std::make_shared<T, Course::Coordinate,
+                std::shared_ptr<GameEventHandler>,
+                std::shared_ptr<ObjectManager>>;
+        return {min, max, ctor};
+    }
+
+    /**
+     * @brief Gets the biomes of the normal game
+     * @post Exception guarantee: No-throw
+     * @return Shared configuration, created on first use
+     */
+    static std::shared_ptr<const BiomeConfig> defaultConfig();
+
+    /**
+     * @brief Gets the biomes whose range contains the value
+     * @param value - Noise value
+     * @post Exception guarantee: No-throw
+     * @return Matching biomes in the original order, may be empty
+     */
+    const std::vector<const Biome*>& getCandidates(double value) const;
+
+    /**
+     * @brief Gets the biome used when no range matches
+     * @post Exception guarantee: No-throw
+     * @return First biome
+     */
+    const Biome& getFallback() const;
+
+    /**
+     * @brief Gets all biomes
+     * @post Exception guarantee: No-throw
+     */
+    const std::vector<Biome>& getBiomes() const;
+
+private:
+    std::vector<Biome> biomes_;
+
+    // Sorted range ends. pointCandidates_[i] matches exactly bounds_[i]
+    // and intervalCandidates_[i] values between bounds_[i-1] and bounds_[i]
+    std::vector<float> bounds_;
+    std::vector<std::vector<const Biome*>> pointCandidates_;
+    std::vector<std::vector<const Biome*>> intervalCandidates_;
+};
+
+}
+
+#endif // BIOMECONFIG_HH
@@ -1,7 +1,42 @@
 #include "gamemanager.hh"
+#include "core/profiler.hh"
 #include <iostream>
+#include <cstring>
+#include <algorithm>
 
 namespace Game {
+
+namespace {
+
+const quint64 FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const quint64 FNV_PRIME = 1099511628211ULL;
+
+// Every registry building and worker takes one space on its tile
+const int OBJECT_TILE_SPACES = 1;
+
+/**
+ * @brief Adds value to FNV-1a hash byte by byte, least significant first
+ * so the result does not depend on the byte order of the platform
+ */
+void hashValue(quint64& hash, qint64 value)
+{
+    quint64 bits = static_cast<quint64>(value);
+    for(int i=0; i<8; i++){
+        hash ^= (bits >> (i * 8)) & 0xFF;
+        hash *= FNV_PRIME;
+    }
+}
+
+void hashString(quint64& hash, const std::string& value)
+{
+    for(unsigned char c : value){
+        hash ^= c;
+        hash *= FNV_PRIME;
+    }
+    hashValue(hash, value.size());
+}
+
+}
 GameManager::GameManager(std::shared_ptr<GameEventHandler> geh,
                          std::shared_ptr<ObjectManager> om,
                          std::shared_ptr<GameScene> gs,
@@ -9,14 +44,25 @@ GameManager::GameManager(std::shared_ptr<GameEventHandler> geh,
     gameEventHandler_(geh),
     objectManager_(om),
     gameScene_(gs),
-    parent_(parent)
+    parent_(parent),
+    scoreLedger_(om),
+    productionForecast_(om)
 {
 
 }
 
 void GameManager::addPlayers(std::unordered_map<QString, QColor> players)
 {
-	for(const std::pair<QString, QColor> player : players){
+	// Hash map order differs between platforms, turn order must not
+	std::vector<std::pair<QString, QColor>> ordered(players.begin(),
+													players.end());
+	std::sort(ordered.begin(), ordered.end(),
+			  [](const std::pair<QString, QColor>& a,
+				 const std::pair<QString, QColor>& b){
+		return a.first < b.first;
+	});
+
+	for(const std::pair<QString, QColor>& player : ordered){
 		addPlayer(player);
 	}
 }
@@ -57,6 +103,21 @@ void GameManager::setSeed(int seed)
 }
 
 bool GameManager::startGame()
+{
+	if(!beginGame()){
+		return false;
+	}
+
+	GenerateWorld();
+	if(gameScene_ != nullptr){
+		gameScene_->loadTiles();
+	}
+	finishWorld();
+
+	return true;
+}
+
+bool GameManager::beginGame()
 {
 	// Add all necessary checks. Primitive for now
 	if( players_.size() == 0 ||
@@ -64,13 +125,377 @@ bool GameManager::startGame()
 		return false;
 	}
 	gameEventHandler_->setPlayers(players_);
+	objectManager_->setPlayers(std::vector<std::shared_ptr<Course::PlayerBase>>(
+								   players_.begin(), players_.end()));
+	scoreLedger_.setPlayers(players_);
+	productionForecast_.setPlayers(players_);
+
+	// Setup is profiled apart from the turns
+	PV_PROFILE_TURN(0);
+	// Chunks of the world are placed as they come
+	objectManager_->reserveMap(mapWidth_, mapHeight_);
+
+	if(actionLog_ != nullptr){
+		actionLog_->setSettings(seed_, mapWidth_, mapHeight_, totalTurnCount_);
+		for(std::shared_ptr<Player> player : players_){
+			actionLog_->addPlayer(QString::fromStdString(player->getName()),
+								  player->getColor());
+		}
+	}
+	if(statsRecorder_ != nullptr){
+		statsRecorder_->start(players_, totalTurnCount_);
+		roundProduction_.assign(players_.size(), 0);
+	}
 
-	GenerateWorld();
-	gameScene_->loadTiles();
+	return true;
+}
+
+GameManager::WorldJob GameManager::getWorldJob() const
+{
+	unsigned int width = mapWidth_;
+	unsigned int height = mapHeight_;
+	unsigned int seed = seed_;
+	WorldGeneratorPerlin worldGenerator(biomeConfig_);
+	std::shared_ptr<ObjectManager> objectManager = objectManager_;
+	std::shared_ptr<GameEventHandler> eventHandler = gameEventHandler_;
+
+	return [=](unsigned int chunkColumns,
+			   const WorldGeneratorPerlin::ChunkHandler& onChunk,
+			   const std::atomic<bool>* cancel){
+		PV_PROFILE_SCOPE("generateWorldChunks");
+		return worldGenerator.generateChunks(width, height, seed,
+											 objectManager, eventHandler,
+											 chunkColumns, onChunk, cancel);
+	};
+}
+
+void GameManager::addWorldChunk(
+		const std::vector<std::shared_ptr<Course::TileBase>>& tiles)
+{
+	if(tiles.empty()){
+		return;
+	}
+
+	objectManager_->addTiles(tiles);
+	if(gameScene_ != nullptr){
+		// Chunks are whole columns in order
+		int first = tiles.front()->getCoordinate().x();
+		int last = tiles.back()->getCoordinate().x();
+		gameScene_->loadColumns(first, last - first + 1);
+	}
+}
 
+void GameManager::finishWorld()
+{
 	gameStarted_ = true;
+}
 
-	return true;
+bool GameManager::saveGame(const QString &path)
+{
+    SnapshotHeader header = {};
+    std::vector<SnapshotPlayer> players;
+    std::vector<SnapshotTile> tiles;
+    std::vector<SnapshotObject> objects;
+    exportSnapshot(header, players, tiles, objects);
+
+    return MapSnapshot::write(path, header, players, tiles, objects);
+}
+
+ForkPoint GameManager::captureState()
+{
+    PV_PROFILE_SCOPE("captureState");
+
+    SnapshotHeader header = {};
+    std::vector<SnapshotPlayer> players;
+    std::vector<SnapshotTile> tiles;
+    std::vector<SnapshotObject> objects;
+    exportSnapshot(header, players, tiles, objects);
+
+    ForkPoint point;
+    point.snapshot = MapSnapshot::create(header, players, tiles, objects);
+    for(const std::shared_ptr<Player>& player : players_){
+        std::vector<Course::Coordinate> claims;
+        for(const auto& object : player->getObjects()){
+            if(std::dynamic_pointer_cast<Course::TileBase>(object) != nullptr){
+                claims.push_back(object->getCoordinate());
+            }
+        }
+        point.claims.push_back(claims);
+    }
+    return point;
+}
+
+std::unique_ptr<GameManager> GameManager::fork(const ForkPoint &point)
+{
+    PV_PROFILE_SCOPE("fork");
+
+    std::shared_ptr<ObjectManager> objects = std::make_shared<ObjectManager>();
+    std::unique_ptr<GameManager> game = std::make_unique<GameManager>(
+                std::make_shared<GameEventHandler>(), objects, nullptr,
+                nullptr);
+    if(!game->loadGame(point.snapshot)){
+        return nullptr;
+    }
+
+    for(unsigned int i=0; i<point.claims.size() &&
+        i<game->players_.size(); i++){
+        for(const Course::Coordinate& coordinate : point.claims.at(i)){
+            std::shared_ptr<Course::TileBase> tile =
+                    objects->getTile(coordinate);
+            if(tile != nullptr){
+                game->players_.at(i)->addObject(tile);
+            }
+        }
+    }
+    return game;
+}
+
+std::unique_ptr<GameManager> GameManager::fork()
+{
+    return fork(captureState());
+}
+
+void GameManager::exportSnapshot(SnapshotHeader &header,
+                                 std::vector<SnapshotPlayer> &players,
+                                 std::vector<SnapshotTile> &tiles,
+                                 std::vector<SnapshotObject> &objects)
+{
+    header.mapWidth = mapWidth_;
+    header.mapHeight = mapHeight_;
+    header.seed = seed_;
+    header.totalTurnCount = totalTurnCount_;
+    // Turn number past the end marks a finished game
+    header.currentTurnNumber = gameOver_ ? totalTurnCount_ + 1
+                                         : currentTurnNumber_;
+    header.currentPlayerIndex = currentPlayerIndex_;
+
+    std::vector<std::shared_ptr<Course::PlayerBase>> playerBases;
+    for(std::shared_ptr<Player> player : players_){
+        SnapshotPlayer record = {};
+        std::strncpy(record.name, player->getName().c_str(),
+                     sizeof(record.name) - 1);
+        record.rgba = player->getColor().rgba();
+
+        for(const auto& resource : *(player->getResourceMap())){
+            if(resource.first <= ORE){
+                record.resources[resource.first] = resource.second;
+            }
+        }
+
+        players.push_back(record);
+        playerBases.push_back(player);
+    }
+
+    auto ownerIndex = [this](const std::shared_ptr<Course::PlayerBase>& owner){
+        for(unsigned int i=0; i<players_.size(); i++){
+            if(players_.at(i) == owner){
+                return static_cast<quint8>(i);
+            }
+        }
+        return SNAPSHOT_NO_OWNER;
+    };
+
+    for(auto building : objectManager_->getBuildings()){
+        SnapshotObject record = {};
+        record.tileIndex = building->getCoordinate().y() * mapWidth_ +
+                building->getCoordinate().x();
+        record.kind = SNAPSHOT_BUILDING;
+        record.type = MapSnapshot::objectTypeCode(SNAPSHOT_BUILDING,
+                                                  building->getType());
+        record.owner = ownerIndex(building->getOwner());
+        record.hold = holdRemaining(building);
+        objects.push_back(record);
+    }
+    for(auto worker : objectManager_->getWorkers()){
+        SnapshotObject record = {};
+        record.tileIndex = worker->getCoordinate().y() * mapWidth_ +
+                worker->getCoordinate().x();
+        record.kind = SNAPSHOT_WORKER;
+        record.type = MapSnapshot::objectTypeCode(SNAPSHOT_WORKER,
+                                                  worker->getType());
+        record.owner = ownerIndex(worker->getOwner());
+        record.focus = worker->getResourceFocus();
+        objects.push_back(record);
+    }
+
+    tiles = objectManager_->exportTiles(playerBases);
+}
+
+bool GameManager::loadGame(const std::shared_ptr<MapSnapshot> &snapshot)
+{
+    if(snapshot == nullptr || snapshot->header().playerCount == 0){
+        return false;
+    }
+
+    const SnapshotHeader& header = snapshot->header();
+    mapWidth_ = header.mapWidth;
+    mapHeight_ = header.mapHeight;
+    seed_ = header.seed;
+    totalTurnCount_ = header.totalTurnCount;
+    currentTurnNumber_ = header.currentTurnNumber;
+    currentPlayerIndex_ = header.currentPlayerIndex;
+
+    std::vector<std::shared_ptr<Course::PlayerBase>> playerBases;
+    for(unsigned int i=0; i<header.playerCount; i++){
+        const SnapshotPlayer& record = snapshot->player(i);
+        std::string name(record.name, strnlen(record.name,
+                                              sizeof(record.name)));
+
+        Course::ResourceMap resources;
+        for(int r=MONEY; r<=ORE; r++){
+            resources[static_cast<BasicResource>(r)] = record.resources[r];
+        }
+
+        addPlayer(std::make_pair(QString::fromStdString(name),
+                                 QColor::fromRgba(record.rgba)));
+        players_.back()->setResourceMap(resources);
+        playerBases.push_back(players_.back());
+    }
+    gameEventHandler_->setPlayers(players_);
+    scoreLedger_.setPlayers(players_);
+    productionForecast_.setPlayers(players_);
+
+    objectManager_->setSnapshot(snapshot, gameEventHandler_, playerBases);
+    try{
+        restoreObjects(*snapshot);
+    } catch(const Course::BaseException&){
+        // Snapshots built in memory are not validated like opened files
+        return false;
+    }
+    if(gameScene_ != nullptr){
+        gameScene_->loadTiles();
+    }
+
+    gameStarted_ = true;
+    if(currentTurnNumber_ > totalTurnCount_){
+        gameOver_ = true;
+        currentTurnNumber_ = totalTurnCount_;
+    }
+
+    // Only the rounds played after loading are recorded
+    if(statsRecorder_ != nullptr){
+        statsRecorder_->start(players_,
+                              totalTurnCount_ - currentTurnNumber_ + 1);
+        roundProduction_.assign(players_.size(), 0);
+    }
+
+    return true;
+}
+
+void GameManager::restoreObjects(const MapSnapshot &snapshot)
+{
+    for(unsigned int i=0; i<snapshot.header().objectCount; i++){
+        const SnapshotObject& record = snapshot.object(i);
+        if(record.owner >= players_.size() ||
+                record.tileIndex >= snapshot.header().tileCount){
+            continue;
+        }
+
+        std::shared_ptr<Player> owner = players_.at(record.owner);
+        std::shared_ptr<Course::TileBase> tile = objectManager_->getTile(
+                    Course::Coordinate(record.tileIndex % mapWidth_,
+                                       record.tileIndex / mapWidth_));
+        if(tile == nullptr){
+            continue;
+        }
+        QString type = MapSnapshot::objectTypeName(
+                    static_cast<SnapshotObjectKind>(record.kind),
+                    record.type);
+
+        if(record.kind == SNAPSHOT_BUILDING){
+            std::shared_ptr<Course::BuildingBase> building =
+                    createBuilding(type, owner);
+            if(building == nullptr){
+                continue;
+            }
+            tile->addBuilding(building);
+            // Tiles may add hold markers of their own when building
+            building->addHoldMarkers(record.hold - building->holdCount());
+            objectManager_->addBuilding(building);
+            scheduleHoldRelease(building);
+            scoreLedger_.addAsset(owner, building->BUILD_COST);
+        } else {
+            std::shared_ptr<Course::WorkerBase> worker =
+                    createWorker(type, owner);
+            if(worker == nullptr){
+                continue;
+            }
+            tile->addWorker(worker);
+            worker->setResourceFocus(
+                        static_cast<BasicResource>(record.focus));
+            objectManager_->addWorker(worker);
+            scoreLedger_.addAsset(owner, worker->RECRUITMENT_COST);
+        }
+    }
+}
+
+quint64 GameManager::getStateHash()
+{
+    quint64 hash = FNV_OFFSET_BASIS;
+
+    hashValue(hash, currentTurnNumber_);
+    hashValue(hash, currentPlayerIndex_);
+    hashValue(hash, gameOver_);
+
+    auto ownerIndex = [this](const std::shared_ptr<Course::PlayerBase>& owner){
+        return static_cast<qint64>(playerIndex(owner));
+    };
+
+    for(std::shared_ptr<Player> player : players_){
+        hashString(hash, player->getName());
+        for(int r=MONEY; r<=ORE; r++){
+            hashValue(hash, (*player->getResourceMap())[
+                      static_cast<BasicResource>(r)]);
+        }
+    }
+
+    // Claims, row by row. The object manager indexes owners in turn order
+    for(quint8 owner : objectManager_->getOwnerRaster()){
+        hashValue(hash, owner < players_.size() ? static_cast<qint64>(owner)
+                                                : static_cast<qint64>(-1));
+    }
+
+    // Buildings and workers in tile order so storage order doesn't matter
+    for(std::shared_ptr<Course::TileBase> tile :
+        objectManager_->getActiveTiles()){
+        hashValue(hash, tile->getCoordinate().x());
+        hashValue(hash, tile->getCoordinate().y());
+
+        for(std::shared_ptr<Course::BuildingBase> building :
+            tile->getBuildings()){
+            hashString(hash, building->getType());
+            hashValue(hash, ownerIndex(building->getOwner()));
+            hashValue(hash, holdRemaining(building));
+        }
+        for(std::shared_ptr<Course::WorkerBase> worker : tile->getWorkers()){
+            hashString(hash, worker->getType());
+            hashValue(hash, ownerIndex(worker->getOwner()));
+            hashValue(hash, worker->getResourceFocus());
+        }
+    }
+
+    return hash;
+}
+
+void GameManager::setActionLog(const std::shared_ptr<ActionLog> &log)
+{
+    actionLog_ = log;
+}
+
+std::shared_ptr<ActionLog> GameManager::getActionLog()
+{
+    return actionLog_;
+}
+
+void GameManager::setStatsRecorder(
+        const std::shared_ptr<StatsRecorder> &recorder)
+{
+    statsRecorder_ = recorder;
+}
+
+std::shared_ptr<StatsRecorder> GameManager::getStatsRecorder()
+{
+    return statsRecorder_;
 }
 
 std::pair<int, int> GameManager::getMapSize()
@@ -80,109 +505,312 @@ std::pair<int, int> GameManager::getMapSize()
 
 void GameManager::claimArea(MapItem* tile)
 {
-    if (tile->getTileObject()->getOwner() != nullptr) {
-        // If the tile has owner already, can't claim
-        throw Course::OwnerConflict(ALREADY_OWNED_TILE.toStdString());
-    }
+    claimArea(tile->getCoordinate());
+}
+
+void GameManager::claimArea(const Course::Coordinate &coordinate)
+{
+    throwActionError(canClaimArea(coordinate));
+    std::shared_ptr<Course::TileBase> tile = getTileOrThrow(coordinate);
 
     if(!gameEventHandler_->modifyResources(players_.at(currentPlayerIndex_),
                                           CLAIM_COST)){
-        throw Course::IllegalAction(NOT_ENOUGH_MONEY.toStdString());
+        throwActionError(ActionError::NOT_ENOUGH_MONEY);
     }
 
     std::shared_ptr<Course::PlayerBase> player = players_.at(currentPlayerIndex_);
-    tile->getTileObject()->setOwner(player);
-	player->addObject(tile->getTileObject());
+    tile->setOwner(player);
+	player->addObject(tile);
+
+    GameAction action;
+    action.type = ActionType::CLAIM;
+    action.x = coordinate.x();
+    action.y = coordinate.y();
+    recordAction(action);
+}
+
+ActionError GameManager::canClaimArea(
+        const Course::Coordinate &coordinate) const
+{
+    // The probes read the type, owner and space of the tile without
+    // creating it, so forks don't build every tile they look at
+    if(objectManager_->getTileTag(coordinate) == TypeTag::UNKNOWN){
+        return ActionError::NO_TILE;
+    }
+    if(objectManager_->getTileOwner(coordinate) != nullptr){
+        return ActionError::ALREADY_OWNED;
+    }
+    if(!canAfford(CLAIM_COST, 1)){
+        return ActionError::NOT_ENOUGH_MONEY;
+    }
+    return ActionError::NONE;
+}
+
+ActionError GameManager::canAddBuilding(const Course::Coordinate &coordinate,
+                                        const QString &building) const
+{
+    const BuildingEntry* entry = ObjectRegistry::findBuilding(building);
+    return canAddBuilding(coordinate,
+                          entry != nullptr ? entry->tag : TypeTag::UNKNOWN);
+}
+
+ActionError GameManager::canAddBuilding(const Course::Coordinate &coordinate,
+                                        TypeTag building) const
+{
+    TypeTag tileTag = objectManager_->getTileTag(coordinate);
+    if(tileTag == TypeTag::UNKNOWN){
+        return ActionError::NO_TILE;
+    }
+    if(!objectManager_->hasSpaceForBuildings(coordinate,
+                                             OBJECT_TILE_SPACES)){
+        return ActionError::NO_BUILDING_SPACE;
+    }
+    if(objectManager_->getTileOwner(coordinate) !=
+            players_.at(currentPlayerIndex_)){
+        return ActionError::NOT_OWNED;
+    }
+
+    const BuildingEntry* entry = ObjectRegistry::building(building);
+    if(entry == nullptr){
+        return ActionError::UNKNOWN_TYPE;
+    }
+    // Space, owner and terrain are everything canBePlacedOnTile of the
+    // registered buildings checks, so no building is created for it.
+    // Oceans and lakes only take water buildings.
+    if(!canPlaceBuilding(entry->tag, tileTag)){
+        return ActionError::CANT_BE_BUILT;
+    }
+    if(!canAfford(entry->cost, -1)){
+        return ActionError::NOT_ENOUGH_RESOURCES;
+    }
+    return ActionError::NONE;
+}
+
+ActionError GameManager::canAddWorkers(const Course::Coordinate &coordinate,
+                                       const QString &worker,
+                                       unsigned int count) const
+{
+    const WorkerEntry* entry = ObjectRegistry::findWorker(worker);
+    return canAddWorkers(coordinate,
+                         entry != nullptr ? entry->tag : TypeTag::UNKNOWN,
+                         count);
+}
+
+ActionError GameManager::canAddWorkers(const Course::Coordinate &coordinate,
+                                       TypeTag worker,
+                                       unsigned int count) const
+{
+    if(objectManager_->getTileTag(coordinate) == TypeTag::UNKNOWN){
+        return ActionError::NO_TILE;
+    }
+    if(objectManager_->getTileOwner(coordinate) !=
+            players_.at(currentPlayerIndex_)){
+        return ActionError::NOT_OWNED;
+    }
+
+    const WorkerEntry* entry = ObjectRegistry::worker(worker);
+    if(entry == nullptr){
+        return ActionError::UNKNOWN_TYPE;
+    }
+    if(!objectManager_->hasSpaceForWorkers(coordinate, OBJECT_TILE_SPACES *
+                                           static_cast<int>(count))){
+        return ActionError::NO_WORKER_SPACE;
+    }
+    if(!canAfford(entry->cost, -static_cast<int>(count))){
+        return ActionError::NOT_ENOUGH_RESOURCES;
+    }
+    return ActionError::NONE;
+}
+
+bool GameManager::canAfford(const Course::ResourceMap &change,
+                            int times) const
+{
+    const Course::ResourceMap& resources =
+            *players_.at(currentPlayerIndex_)->getResourceMap();
+
+    // Same rule as GameEventHandler::modifyResources: nothing may go
+    // below zero, without building the merged map
+    for(const auto& resource : resources){
+        auto changed = change.find(resource.first);
+        int amount = changed != change.end() ? changed->second * times : 0;
+        if(resource.second + amount < 0){
+            return false;
+        }
+    }
+    for(const auto& changed : change){
+        if(resources.count(changed.first) == 0 &&
+                changed.second * times < 0){
+            return false;
+        }
+    }
+    return true;
 }
 
 void GameManager::doTurn()
 {
+    PV_PROFILE_SCOPE("doTurn");
+
+    // Workers are fed and paid before anything is produced
+    payUpkeep(*gameEventHandler_, players_, objectManager_->getWorkers());
+
     // List of tiles that didn't have enough resources to operate
     std::vector<std::shared_ptr<Course::TileBase>> poorTiles;
 
-    for(auto tile : objectManager_->getTiles()){
+    // Tiles without buildings or workers produce nothing
+    const auto& activeTiles = objectManager_->getActiveTiles();
+    PV_PROFILE_COUNT("activeTiles", activeTiles.size());
+    for(auto tile : activeTiles){
         // If not enough resources
         if(!tile->generateResources()){
             poorTiles.push_back(tile);
         }
     }
 
+    PV_PROFILE_COUNT("poorTiles", poorTiles.size());
+
     // Test if poorTiles have enough resources now after other
     // tiles have generated them
     for(auto tile : poorTiles){
-        // Find mapitem of the tile
-        MapItem* mapItem = nullptr;
-        for(auto m : gameScene_->items()){
-            mapItem = static_cast<Game::MapItem*>(m);
-
-            if(mapItem->getTileObject() == tile){
-                break;
-            }
+        for(auto w : tile->getWorkers()){
+            detachWorker(w);
         }
-        if(mapItem != nullptr){
-            for(auto w : tile->getWorkers()){
-                removeWorkerOnTile(mapItem, w);
-            }
 
-            for(auto b : tile->getBuildings()){
-                removeBuildingOnTile(mapItem, b);
-            }
+        for(auto b : tile->getBuildings()){
+            detachBuilding(b);
         }
     }
 }
 
-void GameManager::calculateScores()
+void GameManager::endTurn()
 {
-    playerScores_.clear();
-    for(std::shared_ptr<Player> p : players_){
-        std::string name = p->getName();
-        playerScores_.insert(std::pair<std::string, int>(name, 0));
+    PV_PROFILE_TURN(currentTurnNumber_);
+    PV_PROFILE_SCOPE("endTurn");
 
-        // Add resources
-        Course::ResourceMap resources = *(p->getResourceMap());
-        addResourcesToScore(name, resources);
-    }
-
-    // Add buildings and workers
-    for(std::shared_ptr<Course::TileBase> tile : objectManager_->getTiles()){
-        if(tile->getOwner() != nullptr){
-            playerScores_[tile->getOwner()->getName()] += 50;
+    if(!gameOver_){
+        // Production is what doTurn adds to the resources
+        std::vector<qint32> resourcesBefore;
+        if(statsRecorder_ != nullptr){
+            resourcesBefore = resourceTotals();
         }
 
-        for(std::shared_ptr<Course::BuildingBase> building : tile->getBuildings()){
-            if(building->getOwner() != nullptr){
-                std::string owner = building->getOwner()->getName();
-                addResourcesToScore(owner, building->BUILD_COST);
+        doTurn();
+
+        if(statsRecorder_ != nullptr){
+            std::vector<qint32> resourcesAfter = resourceTotals();
+            for(unsigned int i=0; i<players_.size(); i++){
+                roundProduction_.at(i) +=
+                        resourcesAfter.at(i) - resourcesBefore.at(i);
             }
         }
-        for(std::shared_ptr<Course::WorkerBase> worker : tile->getWorkers()){
-            std::string owner = worker->getOwner()->getName();
-            addResourcesToScore(owner, worker->RECRUITMENT_COST);
-        }
     }
+    else{
+        return;
+    }
+
+    finishTurn();
 }
 
-void GameManager::addResourcesToScore(std::string name,
-                                      Course::ResourceMap resources)
+int GameManager::skipTurns(int count)
 {
-    playerScores_[name] += resources[WOOD];
-    playerScores_[name] += resources[FOOD];
-    playerScores_[name] += resources[STONE];
-    playerScores_[name] += resources[ORE] * 2;
-    playerScores_[name] += resources[MONEY] * 2;
+    PV_PROFILE_SCOPE("skipTurns");
+
+    int ended = 0;
+    while(ended < count && !gameOver_){
+        int playerCount = players_.size();
+        int turnsLeft = (totalTurnCount_ - currentTurnNumber_) * playerCount
+                + playerCount - currentPlayerIndex_;
+
+        SteadyTurns steady = planSteadyTurns(players_, objectManager_,
+                                             productionForecast_);
+        int repeats = std::min({steady.repeats, count - ended, turnsLeft});
+        // Turn with a scheduled effect is the last one of the same kind
+        repeats = static_cast<int>(
+                    std::min<qint64>(repeats, timers_.nextDue()));
+        if(repeats == 0){
+            endTurn();
+            ended++;
+        } else{
+            applySteadyTurns(steady, repeats);
+            ended += repeats;
+        }
+    }
+    return ended;
 }
 
-void GameManager::endTurn()
+void GameManager::applySteadyTurns(const SteadyTurns &steady, int repeats)
 {
-    if(!gameOver_){
-        doTurn();
+    // Upkeep leaves the workers like this on every turn
+    const std::vector<std::shared_ptr<Course::WorkerBase>>& workers =
+            objectManager_->getWorkers();
+    for(unsigned int i=0; i<workers.size(); i++){
+        workers.at(i)->setSatisfaction(
+                    satisfactionValue(steady.satisfaction.at(i)));
     }
-    else{
+
+    // Log and statistics look at every turn
+    if(actionLog_ != nullptr || statsRecorder_ != nullptr){
+        for(int turn=0; turn<repeats; turn++){
+            for(unsigned int i=0; i<players_.size(); i++){
+                gameEventHandler_->modifyResources(players_.at(i),
+                                                   steady.change.at(i));
+                if(statsRecorder_ != nullptr){
+                    for(const auto& resource : steady.change.at(i)){
+                        roundProduction_.at(i) += resource.second;
+                    }
+                }
+            }
+            finishTurn();
+        }
         return;
     }
 
+    for(unsigned int i=0; i<players_.size(); i++){
+        Course::ResourceMap change = steady.change.at(i);
+        for(auto& resource : change){
+            resource.second *= repeats;
+        }
+        gameEventHandler_->modifyResources(players_.at(i), change);
+    }
+
+    timers_.advance(repeats);
+
+    int playerTurns = currentPlayerIndex_ + repeats;
+    currentTurnNumber_ += playerTurns / players_.size();
+    currentPlayerIndex_ = playerTurns % players_.size();
+    if(currentTurnNumber_ > totalTurnCount_){
+        gameOver_ = true;
+        currentTurnNumber_ = totalTurnCount_;
+    }
+}
+
+quint64 GameManager::scheduleEffect(unsigned int turns,
+                                    const TurnTimers::Effect &effect)
+{
+    return timers_.schedule(turns, effect);
+}
+
+void GameManager::cancelEffect(quint64 id)
+{
+    timers_.cancel(id);
+}
+
+void GameManager::finishTurn()
+{
+    // Effects due after the production of this turn
+    timers_.advance();
+
+    GameAction action;
+    action.type = ActionType::END_TURN;
+    recordAction(action);
+
+    // Checksum of the state the turn produced
+    TurnChecksum checksum = {currentTurnNumber_, currentPlayerIndex_, 0};
+
     // Increment if last player during this turn
     if(currentPlayerIndex_ == static_cast<int>(players_.size()-1)){
+        if(statsRecorder_ != nullptr){
+            recordStats(currentTurnNumber_);
+        }
         currentTurnNumber_ += 1;
         currentPlayerIndex_ = 0;
 
@@ -193,237 +821,440 @@ void GameManager::endTurn()
     } else{
         currentPlayerIndex_ += 1;
     }
+
+    if(actionLog_ != nullptr){
+        checksum.hash = getStateHash();
+        actionLog_->recordChecksum(checksum);
+    }
 }
 
 void GameManager::addBuildingOnTile(MapItem* selectedItem, QString building)
 {
-    std::shared_ptr<Course::TileBase> tile =
-            objectManager_->getTile(selectedItem->getTileObject()->getCoordinate());
-    if(tile->hasSpaceForBuildings(1) == false){
-        throw Course::IllegalAction(TOO_MANY_BUILDINGS.toStdString());
-    }
-    if(selectedItem->getTileObject()->getOwner() != players_.at(currentPlayerIndex_)){
-        throw Course::OwnerConflict(NOT_OWNED_TILE.toStdString());
+    addBuildingOnTile(selectedItem->getCoordinate(), building);
+}
+
+void GameManager::addBuildingOnTile(const Course::Coordinate &coordinate,
+                                    QString building)
+{
+    throwActionError(canAddBuilding(coordinate, building));
+    std::shared_ptr<Course::TileBase> tile = getTileOrThrow(coordinate);
+    const BuildingEntry* entry = ObjectRegistry::findBuilding(building);
+
+    std::shared_ptr<Course::BuildingBase> actualBuilding = entry->create(
+                gameEventHandler_, objectManager_,
+                players_.at(currentPlayerIndex_));
+
+    // Placed before paying, a refused building has nothing to undo
+    tile->addBuilding(actualBuilding);
+    Course::ResourceMap buildCost = Course::multiplyResourceMap(
+                entry->cost, Game::RESOURCEMAP_NEGATIVE);
+    if(!gameEventHandler_->modifyResources(players_.at(currentPlayerIndex_),
+                                          buildCost)){
+        tile->removeBuilding(actualBuilding);
+        throwActionError(ActionError::NOT_ENOUGH_RESOURCES);
     }
 
-    // Test if enough resources. Has to be done as last test currently
-    Course::ResourceMap cost;
+    objectManager_->addBuilding(actualBuilding);
+    actualBuilding->onBuildAction();
+    scheduleHoldRelease(actualBuilding);
+    scoreLedger_.addAsset(actualBuilding->getOwner(),
+                          actualBuilding->BUILD_COST);
 
-    if(building ==  FARM){
-        cost = Course::ConstResourceMaps::FARM_BUILD_COST;
-    } else if(building == HQ){
-        cost = Course::ConstResourceMaps::HQ_BUILD_COST;
-    } else if(building == OUTPOST){
-        cost = Course::ConstResourceMaps::OUTPOST_BUILD_COST;
-    } else if(building == LAKE_COTTAGE){
-        cost = Game::LAKE_COTTAGE_BUILD_COST;
-    } else if(building == MINE){
-        cost = Game::MINE_BUILD_COST;
-    } else if(building == FISHING_BOAT){
-        cost = Game::FISHING_BOAT_BUILD_COST;
+    // Graphics
+    MapItem* selectedItem = getMapItem(coordinate);
+    if(selectedItem != nullptr){
+        selectedItem->setBuildingOnTile(building);
+        gameScene_->update(selectedItem->boundingRect());
     }
 
-    // Check if can be built
-    std::shared_ptr<Course::BuildingBase> actualBuilding = createBuilding(building);
+    GameAction action;
+    action.type = ActionType::BUILD;
+    action.x = coordinate.x();
+    action.y = coordinate.y();
+    action.name = building;
+    recordAction(action);
+}
 
-    if(!actualBuilding->canBePlacedOnTile(tile)){
-        throw Course::IllegalAction(CANT_BE_BUILT.toStdString());
+std::shared_ptr<Course::BuildingBase> GameManager::createBuilding(
+        const QString& type, const std::shared_ptr<Player>& owner)
+{
+    const BuildingEntry* entry = ObjectRegistry::findBuilding(type);
+    if(entry == nullptr){
+        return nullptr;
+    }
+    return entry->create(gameEventHandler_, objectManager_, owner);
+}
+
+void GameManager::removeBuildingOnTile(MapItem *selectedItem, std::shared_ptr<BuildingBase> building)
+{
+    std::shared_ptr<Course::TileBase> tile =
+            getTileOrThrow(selectedItem->getCoordinate());
+    std::vector<std::shared_ptr<Course::BuildingBase>> buildings =
+            tile->getBuildings();
+
+    for(unsigned int i=0; i<buildings.size(); i++){
+        if(buildings.at(i) == building){
+            removeBuildingOnTile(selectedItem->getCoordinate(), i);
+            return;
+        }
     }
 
-    // Check for Ocean
-    if(selectedItem->getTileObject()->getType() == OCEAN.toStdString() && building != FISHING_BOAT){
-        throw Course::IllegalAction(CANT_BE_BUILT.toStdString());
+    throw Course::KeyError("Building not found");
+}
+
+void GameManager::removeBuildingOnTile(const Course::Coordinate &coordinate,
+                                       unsigned int index)
+{
+    std::vector<std::shared_ptr<Course::BuildingBase>> buildings =
+            getTileOrThrow(coordinate)->getBuildings();
+    if(index >= buildings.size()){
+        throw Course::KeyError("Building not found");
     }
 
-    // Check for Lake
-    if(selectedItem->getTileObject()->getType() == LAKE.toStdString() &&
-            !(building == FISHING_BOAT || building == LAKE_COTTAGE)){
-        throw Course::IllegalAction(CANT_BE_BUILT.toStdString());
+    detachBuilding(buildings.at(index));
+
+    GameAction action;
+    action.type = ActionType::REMOVE_BUILDING;
+    action.x = coordinate.x();
+    action.y = coordinate.y();
+    action.value = index;
+    recordAction(action);
+}
+
+void GameManager::addWorkerOnTile(MapItem *selectedItem, QString worker)
+{
+    addWorkerOnTile(selectedItem->getCoordinate(), worker);
+}
+
+void GameManager::addWorkerOnTile(const Course::Coordinate &coordinate,
+                                  QString worker)
+{
+    addWorkersOnTile(coordinate, worker, 1);
+}
+
+void GameManager::addWorkersOnTile(MapItem *selectedItem, QString worker,
+                                   unsigned int count)
+{
+    addWorkersOnTile(selectedItem->getCoordinate(), worker, count);
+}
+
+void GameManager::addWorkersOnTile(const Course::Coordinate &coordinate,
+                                   QString worker, unsigned int count)
+{
+    if(count == 0){
+        return;
     }
 
-    Course::ResourceMap buildCost = Course::multiplyResourceMap(
-                cost, Game::RESOURCEMAP_NEGATIVE);
+    throwActionError(canAddWorkers(coordinate, worker, count));
+    std::shared_ptr<Course::TileBase> tile = getTileOrThrow(coordinate);
+    const WorkerEntry* entry = ObjectRegistry::findWorker(worker);
+
+    // The whole batch is paid at once
+    Course::ResourceMap buildCost;
+    for(const auto& resource : entry->cost){
+        buildCost[resource.first] =
+                -resource.second * static_cast<int>(count);
+    }
     if(!gameEventHandler_->modifyResources(players_.at(currentPlayerIndex_),
                                           buildCost)){
-        throw Course::IllegalAction(NOT_ENOUGH_RESOURCES.toStdString());
+        throwActionError(ActionError::NOT_ENOUGH_RESOURCES);
     }
 
-    objectManager_->addBuilding(actualBuilding);
-    tile->addBuilding(actualBuilding);
-    actualBuilding->onBuildAction();
+    std::vector<std::shared_ptr<Course::WorkerBase>> workers;
+    workers.reserve(count);
+    while(workers.size() < count){
+        workers.push_back(entry->create(gameEventHandler_, objectManager_,
+                                        players_.at(currentPlayerIndex_)));
+    }
 
-    // Graphics
-    selectedItem->setBuildingOnTile(building);
-    gameScene_->update(selectedItem->boundingRect());
+    MapItem* selectedItem = getMapItem(coordinate);
+    for(const std::shared_ptr<Course::WorkerBase>& actualWorker : workers){
+        objectManager_->addWorker(actualWorker);
+        tile->addWorker(actualWorker);
+        scoreLedger_.addAsset(actualWorker->getOwner(),
+                              actualWorker->RECRUITMENT_COST);
+        if(selectedItem != nullptr){
+            selectedItem->setWorkerOnTile(worker);
+        }
+
+        // Logged one by one so replays see the same workers
+        GameAction action;
+        action.type = ActionType::RECRUIT;
+        action.x = coordinate.x();
+        action.y = coordinate.y();
+        action.name = worker;
+        recordAction(action);
+    }
+
+    // Graphics, once for the whole batch
+    if(selectedItem != nullptr){
+        gameScene_->update(selectedItem->boundingRect());
+        gameScene_->tileInfo(QString::fromStdString(tile->getType()),
+                             selectedItem,
+                             selectedItem->getItem(),
+                             tile->getType());
+    }
 }
 
-std::shared_ptr<Course::BuildingBase> GameManager::createBuilding(
-        QString& type)
-{
-    std::shared_ptr<Course::BuildingBase> building;
-
-    if(type ==  FARM){
-            building = std::make_shared<Course::Farm>(gameEventHandler_, objectManager_,
-                                        players_.at(currentPlayerIndex_));
-    } else if(type == HQ){
-        building = std::make_shared<Course::HeadQuarters>(gameEventHandler_, objectManager_,
-                                    players_.at(currentPlayerIndex_));
-    } else if(type == OUTPOST){
-        building = std::make_shared<Course::Outpost>(gameEventHandler_, objectManager_,
-                                    players_.at(currentPlayerIndex_));
-    } else if(type == LAKE_COTTAGE){
-        building = std::make_shared<Game::Cottage>(gameEventHandler_, objectManager_,
-                                    players_.at(currentPlayerIndex_));
-    } else if(type == MINE){
-        building = std::make_shared<Game::Mine>(gameEventHandler_, objectManager_,
-                                    players_.at(currentPlayerIndex_));
-    } else if(type == FISHING_BOAT){
-        building = std::make_shared<Game::FishingBoat>(gameEventHandler_, objectManager_,
-                                    players_.at(currentPlayerIndex_));
-    } else{
+std::shared_ptr<WorkerBase> GameManager::createWorker(
+        const QString &type, const std::shared_ptr<Player>& owner)
+{
+    const WorkerEntry* entry = ObjectRegistry::findWorker(type);
+    if(entry == nullptr){
         return nullptr;
     }
-
-    return building;
+    return entry->create(gameEventHandler_, objectManager_, owner);
 }
 
-void GameManager::removeBuildingOnTile(MapItem *selectedItem, std::shared_ptr<BuildingBase> building)
+void GameManager::removeWorkerOnTile(MapItem* selectedItem, std::shared_ptr<WorkerBase> worker)
 {
-    selectedItem->removeBuildingOnTile(QString::fromStdString(building->getType()));
-    gameScene_->update(selectedItem->boundingRect());
-    objectManager_->removeBuilding(building);
+    std::shared_ptr<Course::TileBase> tile =
+            getTileOrThrow(selectedItem->getCoordinate());
+    std::vector<std::shared_ptr<Course::WorkerBase>> workers =
+            tile->getWorkers();
+
+    for(unsigned int i=0; i<workers.size(); i++){
+        if(workers.at(i) == worker){
+            removeWorkerOnTile(selectedItem->getCoordinate(), i);
+            return;
+        }
+    }
+
+    throw Course::KeyError("Worker not found");
 }
 
-void GameManager::addWorkerOnTile(MapItem *selectedItem, QString worker)
+void GameManager::removeWorkerOnTile(const Course::Coordinate &coordinate,
+                                     unsigned int index)
 {
-    if (selectedItem->getTileObject()->getOwner() !=
-                        players_.at(currentPlayerIndex_)) {
-        throw Course::OwnerConflict(NOT_OWNED_TILE.toStdString());
+    std::vector<std::shared_ptr<Course::WorkerBase>> workers =
+            getTileOrThrow(coordinate)->getWorkers();
+    if(index >= workers.size()){
+        throw Course::KeyError("Worker not found");
     }
 
-    ResourceMap cost;
+    detachWorker(workers.at(index));
+
+    GameAction action;
+    action.type = ActionType::FREE_WORKER;
+    action.x = coordinate.x();
+    action.y = coordinate.y();
+    action.value = index;
+    recordAction(action);
+}
 
-    if (worker == WORKER_BASIC) {
-        cost = Course::ConstResourceMaps::BW_RECRUITMENT_COST;
-    } else if (worker == WORKER_FARMER) {
-        cost = Game::FARMER_RECRUITMENT_COST;
-    } else if (worker == WORKER_MINER) {
-        cost = Game::MINER_RECRUITMENT_COST;
+void GameManager::applyAction(const GameAction &action)
+{
+    Course::Coordinate coordinate(action.x, action.y);
+
+    switch(action.type){
+    case ActionType::CLAIM:
+        claimArea(coordinate);
+        break;
+    case ActionType::BUILD:
+        addBuildingOnTile(coordinate, action.name);
+        break;
+    case ActionType::REMOVE_BUILDING:
+        removeBuildingOnTile(coordinate, action.value);
+        break;
+    case ActionType::RECRUIT:
+        addWorkerOnTile(coordinate, action.name);
+        break;
+    case ActionType::FREE_WORKER:
+        removeWorkerOnTile(coordinate, action.value);
+        break;
+    case ActionType::SELL:
+        sellResource(action.resource, action.value);
+        break;
+    case ActionType::END_TURN:
+        endTurn();
+        break;
     }
-    Course::ResourceMap buildCost = Course::multiplyResourceMap(
-                cost, Game::RESOURCEMAP_NEGATIVE);
+}
 
-    if(!gameEventHandler_->modifyResources(players_.at(currentPlayerIndex_),
-                                          buildCost)){
+void GameManager::sellResource(Course::BasicResource resource, int amount)
+{
+    if(amount <= 0 || resource == NONE || resource == MONEY){
         throw Course::IllegalAction(NOT_ENOUGH_RESOURCES.toStdString());
     }
 
-    std::shared_ptr<Course::TileBase> tile =
-            objectManager_->getTile(selectedItem->getTileObject()->getCoordinate());
+    // Ore is worth double
+    int value = resource == ORE ? amount * 2 : amount;
 
-    // Graphics
-    selectedItem->setWorkerOnTile(worker);
-
-    // Create worker
-    std::shared_ptr<Course::WorkerBase> actualWorker = createWorker(worker);
-    objectManager_->addWorker(actualWorker);
-    tile->addWorker(actualWorker);
-    gameScene_->update(selectedItem->boundingRect());
-    gameScene_->tileInfo(QString::fromStdString(selectedItem->getTileObject()->getType()),
-                         selectedItem,
-                         selectedItem->getItem(),
-                         selectedItem->getTileObject()->getType());
-}
-
-std::shared_ptr<WorkerBase> GameManager::createWorker(QString &type)
-{
-    std::shared_ptr<Course::WorkerBase> worker;
-
-    if(type == WORKER_BASIC){
-        worker = std::make_shared<Course::BasicWorker>(gameEventHandler_, objectManager_,
-                                                      players_.at(currentPlayerIndex_), 1,
-                                                      Course::ConstResourceMaps::BW_RECRUITMENT_COST,
-                                                       BW_WORKER_EFFICIENCY);
-    } else if(type == WORKER_FARMER){
-        worker = std::make_shared<Game::Farmer>(gameEventHandler_, objectManager_,
-                                                      players_.at(currentPlayerIndex_));
-    } else if(type == WORKER_MINER){
-        worker = std::make_shared<Game::Miner>(gameEventHandler_, objectManager_,
-                                                      players_.at(currentPlayerIndex_));
-    } /*else if(type == WORKER_SABOTEUR){
-        worker = std::make_shared<Course::BasicWorker>(gameEventHandler_, objectManager_,
-                                                      players_.at(currentPlayerIndex_));
-    }*/
-
-    return worker;
+    std::shared_ptr<Player> player = players_.at(currentPlayerIndex_);
+    if(!gameEventHandler_->modifyResource(player, resource, -amount)){
+        throw Course::IllegalAction(NOT_ENOUGH_RESOURCES.toStdString());
+    }
+    gameEventHandler_->modifyResource(player, MONEY, value);
+
+    GameAction action;
+    action.type = ActionType::SELL;
+    action.resource = resource;
+    action.value = amount;
+    recordAction(action);
 }
 
-void GameManager::removeWorkerOnTile(MapItem* selectedItem, std::shared_ptr<WorkerBase> worker)
+void GameManager::detachBuilding(const std::shared_ptr<BuildingBase> &building)
+{
+    MapItem* mapItem = getMapItem(building->getCoordinate());
+    if(mapItem != nullptr){
+        mapItem->removeBuildingOnTile(QString::fromStdString(building->getType()));
+        gameScene_->update(mapItem->boundingRect());
+    }
+    objectManager_->removeBuilding(building);
+    scoreLedger_.removeAsset(building->getOwner(), building->BUILD_COST);
+
+    auto hold = holdTimers_.find(building.get());
+    if(hold != holdTimers_.end()){
+        timers_.cancel(hold->second);
+        holdTimers_.erase(hold);
+    }
+}
+
+void GameManager::scheduleHoldRelease(
+        const std::shared_ptr<Course::BuildingBase> &building)
+{
+    // Outposts keep their markers without being held by them
+    if(!building->isHeld()){
+        return;
+    }
+
+    std::weak_ptr<Course::BuildingBase> held = building;
+    holdTimers_[building.get()] = timers_.schedule(
+                building->holdCount(), [this, held](){
+        std::shared_ptr<Course::BuildingBase> building = held.lock();
+        if(building == nullptr){
+            return;
+        }
+        holdTimers_.erase(building.get());
+        building->addHoldMarkers(-building->holdCount());
+        objectManager_->tileProductionChanged(building->getCoordinate());
+    });
+}
+
+int GameManager::holdRemaining(
+        const std::shared_ptr<Course::BuildingBase> &building)
+{
+    auto hold = holdTimers_.find(building.get());
+    if(hold != holdTimers_.end()){
+        return timers_.remaining(hold->second);
+    }
+    return building->holdCount();
+}
+
+void GameManager::detachWorker(const std::shared_ptr<WorkerBase> &worker)
 {
-    selectedItem->removeWorkerOnTile(QString::fromStdString(worker->getType()));
-    gameScene_->update(selectedItem->boundingRect());
+    MapItem* mapItem = getMapItem(worker->getCoordinate());
+    if(mapItem != nullptr){
+        mapItem->removeWorkerOnTile(QString::fromStdString(worker->getType()));
+        gameScene_->update(mapItem->boundingRect());
+    }
     objectManager_->removeWorker(worker);
+    scoreLedger_.removeAsset(worker->getOwner(), worker->RECRUITMENT_COST);
 }
 
-ResourceMap GameManager::calculateResourceProduction(std::shared_ptr<TileBase> tile)
+std::shared_ptr<TileBase> GameManager::getTileOrThrow(
+        const Course::Coordinate &coordinate)
 {
-    ResourceMapDouble worker_efficiency = RESOURCEMAP_ZERO_DOUBLE;
-    ResourceMap total_production;
+    std::shared_ptr<Course::TileBase> tile = objectManager_->getTile(coordinate);
+    if(tile == nullptr){
+        throw Course::IllegalAction(CANT_BE_BUILT.toStdString());
+    }
+    return tile;
+}
 
-    std::vector<std::shared_ptr<Course::WorkerBase>> workers = tile->getWorkers();
-    std::vector<std::shared_ptr<Course::BuildingBase>> buildings = tile->getBuildings();
+MapItem *GameManager::getMapItem(const Course::Coordinate &coordinate)
+{
+    if(gameScene_ == nullptr){
+        return nullptr;
+    }
+    return gameScene_->getMapItem(coordinate);
+}
 
-    for(std::shared_ptr<Course::WorkerBase> work_it : workers)
-    {
-        // Copied from basicworker
-        auto player = work_it->getOwner();
-        double satisfaction = 0;
-        BasicResource focus = work_it->getResourceFocus();
-
-        ResourceMapDouble final_modifier;
-
-        if (gameEventHandler_->modifyResource(player, BasicResource::FOOD, -1, false))
-        {
-            satisfaction = 0.5;
-            if (gameEventHandler_->modifyResource(player, BasicResource::MONEY, -1, false))
-            {
-                satisfaction = 1;
-            }
-        }
+void GameManager::recordAction(const GameAction &action)
+{
+    if(actionLog_ != nullptr){
+        actionLog_->record(action);
+    }
+}
 
-        if( focus != BasicResource::NONE )
-        {
-            final_modifier[focus] =
-                    work_it->WORKER_EFFICIENCY.at(focus) * (satisfaction + 0.25);
+void GameManager::recordStats(int turn)
+{
+    PV_PROFILE_SCOPE("recordStats");
+    statsRecorder_->beginRound(turn);
+
+    std::vector<qint32> buildings(players_.size(), 0);
+    std::vector<qint32> workers(players_.size(), 0);
+    for(const std::shared_ptr<Course::BuildingBase>& building :
+        objectManager_->getBuildings()){
+        int index = playerIndex(building->getOwner());
+        if(index >= 0){
+            buildings.at(index)++;
         }
-        else
-        {
-            for( auto it = work_it->WORKER_EFFICIENCY.begin();
-                 it != work_it->WORKER_EFFICIENCY.end();
-                 ++it )
-            {
-                final_modifier[it->first] = it->second * satisfaction;
-            }
+    }
+    for(const std::shared_ptr<Course::WorkerBase>& worker :
+        objectManager_->getWorkers()){
+        int index = playerIndex(worker->getOwner());
+        if(index >= 0){
+            workers.at(index)++;
         }
+    }
 
-        // Copy ends
-
-        ResourceMapDouble current_efficiency = final_modifier;
+    const Stat resourceStats[] = {Stat::MONEY, Stat::FOOD, Stat::WOOD,
+                                  Stat::STONE, Stat::ORE};
+    const BasicResource resources[] = {MONEY, FOOD, WOOD, STONE, ORE};
 
-        worker_efficiency = mergeResourceMapDoubles(worker_efficiency, current_efficiency);
+    for(unsigned int i=0; i<players_.size(); i++){
+        const Course::ResourceMap& owned = *players_.at(i)->getResourceMap();
+        for(unsigned int r=0; r<5; r++){
+            auto it = owned.find(resources[r]);
+            statsRecorder_->set(i, resourceStats[r],
+                                it == owned.end() ? 0 : it->second);
+        }
+        statsRecorder_->set(i, Stat::TERRITORY, static_cast<qint32>(
+                                objectManager_->getTerritorySize(
+                                    players_.at(i))));
+        statsRecorder_->set(i, Stat::BUILDINGS, buildings.at(i));
+        statsRecorder_->set(i, Stat::WORKERS, workers.at(i));
+        statsRecorder_->set(i, Stat::PRODUCTION, roundProduction_.at(i));
+        statsRecorder_->set(i, Stat::SCORE, scoreLedger_.getScore(i));
     }
 
-    total_production = multiplyResourceMap(tile->BASE_PRODUCTION, worker_efficiency);
+    roundProduction_.assign(players_.size(), 0);
+}
 
-    for(std::shared_ptr<Course::BuildingBase> build_it : buildings)
-    {
-        ResourceMap current_production = build_it->getProduction();
+std::vector<qint32> GameManager::resourceTotals()
+{
+    std::vector<qint32> totals;
+    totals.reserve(players_.size());
+    for(const std::shared_ptr<Player>& player : players_){
+        qint32 total = 0;
+        for(const auto& resource : *player->getResourceMap()){
+            total += resource.second;
+        }
+        totals.push_back(total);
+    }
+    return totals;
+}
 
-        total_production = mergeResourceMaps(total_production,
-                                             current_production);
+int GameManager::playerIndex(
+        const std::shared_ptr<Course::PlayerBase> &player) const
+{
+    for(unsigned int i=0; i<players_.size(); i++){
+        if(players_.at(i) == player){
+            return i;
+        }
     }
+    return -1;
+}
 
-    return total_production;
+ResourceMap GameManager::calculateResourceProduction(std::shared_ptr<TileBase> tile)
+{
+    return productionForecast_.getProduction(tile);
+}
+
+std::vector<int> GameManager::getProductionValues()
+{
+    return productionForecast_.getValues();
 }
 
 int GameManager::getTurnCount()
@@ -454,32 +1285,69 @@ std::shared_ptr<Player> GameManager::getCurrentPlayer()
     return players_.at(currentPlayerIndex_);
 }
 
-std::map<int, std::string> GameManager::getScores()
+int GameManager::getCurrentPlayerIndex()
 {
-    calculateScores();
-    std::map<int, std::string> ordered;
-    for(const auto& i : playerScores_){
-        ordered.insert(std::pair<int, std::string>(i.second, i.first));
+    return currentPlayerIndex_;
+}
+
+std::vector<ScoreEntry> GameManager::getScores()
+{
+    PV_PROFILE_SCOPE("getScores");
+    return scoreLedger_.getLeaderboard();
+}
+
+std::vector<std::pair<std::string, int>> GameManager::getPlayerScores()
+{
+    std::vector<std::pair<std::string, int>> scores;
+    for(const ScoreEntry& entry : scoreLedger_.getScores()){
+        scores.push_back(std::make_pair(entry.name, entry.score));
     }
 
-    return ordered;
+    return scores;
+}
+
+void GameManager::setBiomeConfig(
+        const std::shared_ptr<const BiomeConfig> &config)
+{
+    biomeConfig_ = config;
+}
+
+void GameManager::setPlayerPolicy(int index,
+                                  const std::shared_ptr<PlayerPolicy> &policy)
+{
+    if(index < 0 || index >= static_cast<int>(players_.size())){
+        throw Course::KeyError("No player " + std::to_string(index));
+    }
+    if(index >= static_cast<int>(policies_.size())){
+        policies_.resize(index + 1);
+    }
+    policies_.at(index) = policy;
+}
+
+std::shared_ptr<PlayerPolicy> GameManager::getPlayerPolicy(int index) const
+{
+    if(index < 0 || index >= static_cast<int>(policies_.size())){
+        return nullptr;
+    }
+    return policies_.at(index);
+}
+
+std::shared_ptr<ObjectManager> GameManager::getObjectManager()
+{
+    return objectManager_;
 }
 
 void GameManager::GenerateWorld()
 {
+    PV_PROFILE_SCOPE("generateWorld");
+
     //Course::WorldGenerator& worldGenerator = Course::WorldGenerator::getInstance();
     /*worldGenerator.addConstructor<Course::Forest>(FOREST_RARITY);
     worldGenerator.addConstructor<Course::Grassland>(GRASSLAND_RARITY);
     worldGenerator.addConstructor<Game::Mountain>(MOUNTAIN_RARITY);*/
 
-    WorldGeneratorPerlin& worldGenerator = WorldGeneratorPerlin::getInstance();
-    worldGenerator.addConstructor<Game::Ocean>(0, 0.2);
-    worldGenerator.addConstructor<Course::Forest>(0.2, 0.6);
-    worldGenerator.addConstructor<Game::Lake>(0.4,0.41);
-    worldGenerator.addConstructor<Game::Lake>(0.5,0.51);
-    worldGenerator.addConstructor<Course::Grassland>(0.5, 0.8);
-    worldGenerator.addConstructor<Game::Mountain>(0.8, 1);
-
+    // Generators share the immutable biome configuration
+    WorldGeneratorPerlin worldGenerator(biomeConfig_);
 	worldGenerator.generateMap(mapWidth_, mapHeight_, seed_,
                                objectManager_, gameEventHandler_);
 }
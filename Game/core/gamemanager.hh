@@ -26,29 +26,69 @@
 #include "workers/farmer.hh"
 #include "workers/miner.hh"
 
+#include "core/actionerror.hh"
+#include "core/actionlog.hh"
 #include "core/gameobject.h"
+#include "core/mapsnapshot.hh"
+#include "core/objectregistry.hh"
 #include "core/player.hh"
+#include "core/productionforecast.hh"
 #include "core/resourcemaps.h"
+#include "core/scoreledger.hh"
+#include "core/statsrecorder.hh"
+#include "core/steadyturns.hh"
+#include "core/turntimers.hh"
+#include "core/upkeep.hh"
 #include "core/worldgenerator.h"
 #include "core/worldgeneratorperlin.hh"
 
 #include "exceptions/illegalaction.h"
 #include "exceptions/ownerconflict.h"
 
+#include <atomic>
+#include <functional>
 #include <vector>
 #include <QString>
 
 namespace Game {
 
+class PlayerPolicy;
+
+/**
+ * @brief Captured state of a game, see GameManager::fork. Any amount of
+ * forks can share one.
+ */
+struct ForkPoint
+{
+    std::shared_ptr<MapSnapshot> snapshot;
+    // Tiles each player has claimed in claim order, snapshots don't list
+    // them
+    std::vector<std::vector<Course::Coordinate>> claims;
+};
+
 /**
  * @brief The GameManager class is an interface between Game GUI,
  * ObjectManager and GameEventHandler. The class also keeps track of player
  * and game turns / rounds.
+ * GameScene may be nullptr in which case the game runs without graphics.
  */
 class GameManager
 
 {
 public:
+    /**
+     * @brief Generates the world in chunks
+     * @param chunkColumns - Columns per chunk
+     * @param onChunk - Gets each chunk on the generating thread
+     * @param cancel - Stops the generation before the next chunk once set,
+     * may be nullptr
+     * @return False if cancelled
+     */
+    using WorldJob = std::function<bool(
+            unsigned int chunkColumns,
+            const WorldGeneratorPerlin::ChunkHandler& onChunk,
+            const std::atomic<bool>* cancel)>;
+
 	GameManager(std::shared_ptr<GameEventHandler> geh,
                 std::shared_ptr<ObjectManager> om,
                 std::shared_ptr<GameScene> gs,
@@ -58,6 +98,7 @@ public:
 	/**
 	 * @brief Add players to the game
 	 * @param players - list of players
+	 * @note Turn order is the alphabetical order of the names
 	 */
 	void addPlayers(std::unordered_map<QString, QColor> players);
 
@@ -92,6 +133,13 @@ public:
 	 */
 	void setSeed(int seed);
 
+    /**
+     * @brief Sets the biomes the world is generated with
+     * @param config - Biome configuration, may be shared with other games
+     * @pre Called before startGame
+     */
+    void setBiomeConfig(const std::shared_ptr<const BiomeConfig>& config);
+
 	/**
 	 * @brief Starts the game if everything is ok
 	 * @return bool indicating whether all settings are valid and/or set
@@ -99,6 +147,88 @@ public:
 	 * would make no sense and this would return false
 	 */
 	bool startGame();
+
+    /**
+     * @brief Starts a game whose world is generated in chunks, see
+     * getWorldJob. startGame does all the steps at once.
+     * @return False if the settings aren't valid, same as startGame
+     * @post Exception guarantee: Basic
+     * @note Call addWorldChunk for every chunk and finishWorld after the
+     * last one before doing any actions
+     */
+    bool beginGame();
+
+    /**
+     * @brief Gets a job that generates the tiles of the world in chunks of
+     * columns without adding them, see WorldGeneratorPerlin::generateChunks.
+     * The job keeps what it uses alive so it can run on another thread and
+     * outlive the game.
+     * @pre beginGame has returned true
+     * @post Exception guarantee: Strong
+     */
+    WorldJob getWorldJob() const;
+
+    /**
+     * @brief Adds a chunk of the world job to the map and the scene
+     * @param tiles - Tiles of the chunk, chunks are added in order
+     * @post Exception guarantee: Basic
+     */
+    void addWorldChunk(
+            const std::vector<std::shared_ptr<Course::TileBase>>& tiles);
+
+    /**
+     * @brief Starts the turns after the last chunk has been added
+     * @post Exception guarantee: No-throw
+     */
+    void finishWorld();
+
+    /**
+     * @brief Saves the game state to a snapshot file
+     * @param path - Path of the snapshot file
+     * @pre Game has been started
+     * @post Exception guarantee: No-throw
+     * @return True if the file was written
+     */
+    bool saveGame(const QString& path);
+
+    /**
+     * @brief Restores a saved game instead of starting a new one.
+     * The tiles are read straight from the memory mapped file and only
+     * tiles with buildings or workers are created right away.
+     * @param snapshot - Opened snapshot
+     * @pre No players added and the game has not been started.
+     * GameScene has the size of the snapshot map
+     * @post Exception guarantee: Basic
+     * @return False if the snapshot has no players or an object could not
+     * be placed back on its tile. The game is not usable then.
+     */
+    bool loadGame(const std::shared_ptr<MapSnapshot>& snapshot);
+
+    /**
+     * @brief Captures the game state in memory for fork
+     * @pre Game has been started
+     * @post Exception guarantee: Basic
+     */
+    ForkPoint captureState();
+
+    /**
+     * @brief Creates a game that continues from a captured state like a
+     * loaded game. Forks share the tile records of the snapshot and create
+     * tile objects only for the tiles they touch, so forking copies the
+     * rasters, players and objects but not the map.
+     * @param point - Captured state
+     * @post Exception guarantee: Basic
+     * @return Game without graphics, action log or statistics
+     * @note Hold-markers are the only scheduled effects carried over
+     */
+    static std::unique_ptr<GameManager> fork(const ForkPoint& point);
+
+    /**
+     * @brief Forks the current state, see captureState
+     * @post Exception guarantee: Basic
+     */
+    std::unique_ptr<GameManager> fork();
+
     /**
      * @brief Gets the map size in tiles
      * @return Map size as a pair
@@ -115,6 +245,64 @@ public:
      */
     void claimArea(MapItem* tile);
 
+    /**
+     * @brief Claims the tile on the coordinate for the current player
+     * @param coordinate - Coordinate of the tile
+     * @post Exception guarantee: Strong
+     * @exceptions OwnerConflict - already owned
+     * @exceptions IllegalAction - not enough money or no tile
+     */
+    void claimArea(const Course::Coordinate& coordinate);
+
+    ///// Action queries /////
+    // Checked in the same order as the acting methods, which throw the
+    // first error found. None of these throw or allocate, so they suit
+    // probing many candidates.
+
+    /**
+     * @brief Tells if the current player could claim the tile now
+     * @param coordinate - Coordinate of the tile
+     * @return NONE or why claimArea would fail
+     * @post Exception guarantee: No-throw
+     */
+    ActionError canClaimArea(const Course::Coordinate& coordinate) const;
+
+    /**
+     * @brief Tells if the current player could build on the tile now.
+     * Covers the placement rules of the building too.
+     * @param coordinate - Coordinate of the tile
+     * @param building - Building name, see constants.hh
+     * @return NONE or why addBuildingOnTile would fail
+     * @post Exception guarantee: No-throw
+     */
+    ActionError canAddBuilding(const Course::Coordinate& coordinate,
+                               const QString& building) const;
+
+    /**
+     * @copydoc canAddBuilding
+     */
+    ActionError canAddBuilding(const Course::Coordinate& coordinate,
+                               TypeTag building) const;
+
+    /**
+     * @brief Tells if the current player could recruit workers to the
+     * tile now
+     * @param coordinate - Coordinate of the tile
+     * @param worker - Worker name, see constants.hh
+     * @param count - Amount of workers
+     * @return NONE or why addWorkersOnTile would fail
+     * @post Exception guarantee: No-throw
+     */
+    ActionError canAddWorkers(const Course::Coordinate& coordinate,
+                              const QString& worker,
+                              unsigned int count = 1) const;
+
+    /**
+     * @copydoc canAddWorkers
+     */
+    ActionError canAddWorkers(const Course::Coordinate& coordinate,
+                              TypeTag worker, unsigned int count = 1) const;
+
     // Buildings
     /**
      * @brief Adds building to selected tile
@@ -126,6 +314,17 @@ public:
      * @exceptions IllegalAction - Cannot be placed / not enough resources
      */
     void addBuildingOnTile(MapItem* selectedItem, QString building);
+
+    /**
+     * @brief Adds building to the tile on the coordinate
+     * @param coordinate - Coordinate of the tile
+     * @param building - Building name as a string, see constants.hh
+     * @post Exception guarantee: Strong
+     * @exceptions OwnerConflict - Not owned by the current player
+     * @exceptions IllegalAction - Cannot be placed / not enough resources
+     */
+    void addBuildingOnTile(const Course::Coordinate& coordinate,
+                           QString building);
     /**
      * @brief removeBuildingOnTile
      * @param selectedItem - Selected MapItem
@@ -136,6 +335,16 @@ public:
      */
     void removeBuildingOnTile(MapItem* selectedItem, std::shared_ptr<BuildingBase> building);
 
+    /**
+     * @brief Removes building from the tile on the coordinate
+     * @param coordinate - Coordinate of the tile
+     * @param index - Index of the building in the tile's buildings
+     * @post Exception guarantee: Strong
+     * @exceptions KeyError - No such building
+     */
+    void removeBuildingOnTile(const Course::Coordinate& coordinate,
+                              unsigned int index);
+
     // Workers
     /**
      * @brief addWorkerOnTile
@@ -148,6 +357,43 @@ public:
      * @note - Does not check if the tile has space for the worker
      */
     void addWorkerOnTile(MapItem* selectedItem, QString worker);
+
+    /**
+     * @brief Adds worker to the tile on the coordinate
+     * @param coordinate - Coordinate of the tile
+     * @param worker - Worker name as a string, see constants.hh
+     * @post Exception guarantee: Strong
+     * @exceptions OwnerConflict - Not owned by the current player
+     * @exceptions IllegalAction - Not enough resources or no space on tile
+     */
+    void addWorkerOnTile(const Course::Coordinate& coordinate, QString worker);
+
+    /**
+     * @brief Recruits several workers of one type to the selected tile
+     * @param selectedItem - Selected MapItem
+     * @param worker - Worker name as a string, see constants.hh
+     * @param count - Amount of workers
+     * @pre Must be valid MapItem
+     * @post Exception guarantee: Strong
+     * @exceptions See addWorkersOnTile(coordinate, worker, count)
+     */
+    void addWorkersOnTile(MapItem* selectedItem, QString worker,
+                          unsigned int count);
+
+    /**
+     * @brief Recruits several workers of one type as one transaction:
+     * either all of them are added and paid with one resource change, or
+     * none. The tile is repainted and its info sent once.
+     * @param coordinate - Coordinate of the tile
+     * @param worker - Worker name as a string, see constants.hh
+     * @param count - Amount of workers, 0 does nothing
+     * @post Exception guarantee: Strong
+     * @exceptions OwnerConflict - Not owned by the current player
+     * @exceptions IllegalAction - Not enough resources for all of them or
+     * no space on tile for all of them
+     */
+    void addWorkersOnTile(const Course::Coordinate& coordinate,
+                          QString worker, unsigned int count);
     /**
      * @brief removeWorkerOnTile
      * @param selectedItem - Selected MapItem
@@ -158,16 +404,85 @@ public:
      */
     void removeWorkerOnTile(MapItem* selectedItem, std::shared_ptr<Course::WorkerBase> worker);
 
+    /**
+     * @brief Removes worker from the tile on the coordinate
+     * @param coordinate - Coordinate of the tile
+     * @param index - Index of the worker in the tile's workers
+     * @post Exception guarantee: Strong
+     * @exceptions KeyError - No such worker
+     */
+    void removeWorkerOnTile(const Course::Coordinate& coordinate,
+                            unsigned int index);
+
+    /**
+     * @brief Sells resources of the current player for money
+     * @param resource - Resource to sell, ore is worth double
+     * @param amount - Amount to sell, one ore gives two money
+     * @post Exception guarantee: Strong
+     * @exceptions IllegalAction - Not enough resources
+     */
+    void sellResource(Course::BasicResource resource, int amount);
+
+    /**
+     * @brief Does a logged action for the current player
+     * @param action - Action, see ActionLog
+     * @post Exception guarantee: Strong, END_TURN No-throw
+     * @exceptions Any exception the acting method throws for the action
+     */
+    void applyAction(const GameAction& action);
+
+    /**
+     * @brief Calculates a hash of the whole game state: turn, resources,
+     * claims, buildings and workers
+     * @post Exception guarantee: No-throw
+     * @return FNV-1a hash, same on every platform for the same state
+     */
+    quint64 getStateHash();
+
+    /**
+     * @brief Sets the log that actions and turn checksums are recorded to
+     * @param log - Log or nullptr to stop recording
+     * @pre Set before startGame so the settings get recorded
+     */
+    void setActionLog(const std::shared_ptr<ActionLog>& log);
+
+    /**
+     * @brief Gets the action log
+     * @return Log or nullptr if not recording
+     */
+    std::shared_ptr<ActionLog> getActionLog();
+
+    /**
+     * @brief Sets the recorder that gets statistics after every round
+     * @param recorder - Recorder or nullptr to stop recording
+     * @pre Set before startGame or loadGame so it can reserve its space
+     */
+    void setStatsRecorder(const std::shared_ptr<StatsRecorder>& recorder);
+
+    /**
+     * @brief Gets the statistics recorder
+     * @return Recorder or nullptr if not recording
+     */
+    std::shared_ptr<StatsRecorder> getStatsRecorder();
+
     /**
      * @brief calculateResourceProduction
      * @param tile - Selected tile
      * @pre Must be valid tile
-     * @post Exception guarantee: No-throw
-     * @return Resource production of the tile
+     * @post Exception guarantee: Basic
+     * @return Resource production of the tile next turn
+     * @note Cached until the tile or the upkeep of its workers changes
      */
     Course::ResourceMap calculateResourceProduction(
             std::shared_ptr<Course::TileBase> tile);
 
+    /**
+     * @brief Gets the value of next turn's production of every tile
+     * @post Exception guarantee: Basic
+     * @return Values row by row, 0 for tiles without buildings and workers
+     */
+    std::vector<int> getProductionValues();
+
     /**
      * @brief Gets the total turn count of the game
      * @post Exception guarantee: No-throw
@@ -197,6 +512,56 @@ public:
      */
     void endTurn();
 
+    /**
+     * @brief Ends turns without any player acting, same as calling endTurn
+     * count times.
+     *
+     * Turns that only repeat the upkeep and production of the turn before
+     * are added up at once, see planSteadyTurns. Turns around the events
+     * that change them are played with endTurn.
+     * @param count - Amount of turns to end
+     * @return Amount of turns ended, less than count if the game ended
+     * @post Exception guarantee: Basic
+     */
+    int skipTurns(int count);
+
+    /**
+     * @brief Schedules an effect for a later turn
+     * @param turns - Amount of turns to end before the effect, at least 1
+     * @param effect - Runs after the production of the last of those turns
+     * @return Id for cancelEffect
+     * @post Exception guarantee: Basic
+     */
+    quint64 scheduleEffect(unsigned int turns,
+                           const TurnTimers::Effect& effect);
+
+    /**
+     * @brief Cancels a scheduled effect that hasn't run yet
+     * @param id - Id from scheduleEffect
+     * @post Exception guarantee: No-throw
+     */
+    void cancelEffect(quint64 id);
+
+    /**
+     * @brief Makes a player a computer player
+     * @param index - Turn order index of the player
+     * @param policy - Policy that plays the player's turns, nullptr for a
+     * human player
+     * @pre Players have been added
+     * @post Exception guarantee: Strong
+     * @note The game doesn't run the policy itself, whoever ends the turns
+     * plays the turns of computer players, see planTurn
+     */
+    void setPlayerPolicy(int index, const std::shared_ptr<PlayerPolicy>& policy);
+
+    /**
+     * @brief Gets the policy of a player
+     * @param index - Turn order index of the player
+     * @return Policy or nullptr for a human player
+     * @post Exception guarantee: No-throw
+     */
+    std::shared_ptr<PlayerPolicy> getPlayerPolicy(int index) const;
+
     /**
      * @brief Gets the current player object
      * @post Exception guarantee: No-throw
@@ -205,10 +570,34 @@ public:
     std::shared_ptr<Player> getCurrentPlayer();
 
     /**
-     * @brief Fetches the game scores and orders them
-     * @return Ordered score data
+     * @brief Gets the turn order index of the current player
+     * @post Exception guarantee: No-throw
+     * @return Player index
+     */
+    int getCurrentPlayerIndex();
+
+    /**
+     * @brief Gets the game scores from best to worst
+     * @post Exception guarantee: Strong
+     * @return Scores, players with equal scores in turn order
+     * @note Scores are kept up to date during the game so this is cheap
+     * enough to call every turn
      */
-    std::map<int, std::string> getScores();
+    std::vector<ScoreEntry> getScores();
+
+    /**
+     * @brief Gets the score of every player
+     * @post Exception guarantee: No-throw
+     * @return Names and scores in turn order
+     */
+    std::vector<std::pair<std::string, int>> getPlayerScores();
+
+    /**
+     * @brief Gets the object manager of the game
+     * @return ObjectManager
+     * @note Used by computer players to look at the map
+     */
+    std::shared_ptr<ObjectManager> getObjectManager();
 
 	bool gameStarted_ = false;
 	bool gameOver_ = false;
@@ -217,20 +606,101 @@ private:
     /**
      * @brief Creates Building object for addBuildingOnTile
      * @param type - Building name as string
+     * @param owner - Owner of the building
      * @pre Valid building type
      * @post Exception guarantee: No-throw
      * @return Building object
      */
-    std::shared_ptr<Course::BuildingBase> createBuilding(QString& type);
+    std::shared_ptr<Course::BuildingBase> createBuilding(
+            const QString& type, const std::shared_ptr<Player>& owner);
 
     /**
      * @brief Creates Worker object for addWorkerOnTile
      * @param type - Worker name as string
+     * @param owner - Owner of the worker
      * @pre Valid worker type
      * @post Exception guarantee: No-throw
      * @return Worker object
      */
-    std::shared_ptr<Course::WorkerBase> createWorker(QString& type);
+    std::shared_ptr<Course::WorkerBase> createWorker(
+            const QString& type, const std::shared_ptr<Player>& owner);
+
+    /**
+     * @brief Recreates the buildings and workers of a snapshot.
+     * Nothing is charged and build actions are not run again.
+     * @param snapshot - Opened snapshot
+     * @post Exception guarantee: Basic
+     */
+    void restoreObjects(const MapSnapshot& snapshot);
+
+    /**
+     * @brief Removes building from its tile, objectmanager and graphics
+     * @param building - Building to remove
+     * @post Exception guarantee: Strong
+     */
+    void detachBuilding(const std::shared_ptr<BuildingBase>& building);
+
+    /**
+     * @brief Removes worker from its tile, objectmanager and graphics
+     * @param worker - Worker to remove
+     * @post Exception guarantee: Strong
+     */
+    void detachWorker(const std::shared_ptr<WorkerBase>& worker);
+
+    /**
+     * @brief Gets the tile on coordinate
+     * @exceptions IllegalAction - No tile on coordinate
+     */
+    std::shared_ptr<TileBase> getTileOrThrow(
+            const Course::Coordinate& coordinate);
+
+    /**
+     * @brief Tells if the current player has the resources for a change
+     * applied some times
+     * @param change - Resource change, for example a negated cost
+     * @param times - Multiplier of the change, negative for costs
+     * @post Exception guarantee: No-throw
+     */
+    bool canAfford(const Course::ResourceMap& change, int times) const;
+
+    /**
+     * @brief Gets the map item of the coordinate
+     * @return MapItem or nullptr when running without graphics
+     */
+    MapItem* getMapItem(const Course::Coordinate& coordinate);
+
+    /**
+     * @brief Collects the records of a snapshot of the game
+     * @param header - Header without the counts and offsets
+     */
+    void exportSnapshot(SnapshotHeader& header,
+                        std::vector<SnapshotPlayer>& players,
+                        std::vector<SnapshotTile>& tiles,
+                        std::vector<SnapshotObject>& objects);
+
+    /**
+     * @brief Records the action if a log is set
+     */
+    void recordAction(const GameAction& action);
+
+    /**
+     * @brief Records the statistics of every player for a finished round
+     * @param turn - Turn number of the round
+     * @pre Stats recorder is set
+     */
+    void recordStats(int turn);
+
+    /**
+     * @brief Sums the resources of every player
+     * @return Totals in turn order
+     */
+    std::vector<qint32> resourceTotals();
+
+    /**
+     * @brief Finds the turn order index of a player
+     * @return Index or -1 if not a player of this game
+     */
+    int playerIndex(const std::shared_ptr<Course::PlayerBase>& player) const;
 
     /**
      * @brief Generates the world
@@ -245,29 +715,56 @@ private:
     void doTurn();
 
     /**
-     * @brief Calculates the score of the game
+     * @brief Records the ended turn and changes to the next player
+     * @post Exception guarantee: No-throw
+     */
+    void finishTurn();
+
+    /**
+     * @brief Applies steady turns to the players without playing them
+     * @param steady - Turns planned from the current state
+     * @param repeats - Amount of turns to apply, at most steady.repeats
+     * @post Exception guarantee: Basic
+     */
+    void applySteadyTurns(const SteadyTurns& steady, int repeats);
+
+    /**
+     * @brief Schedules the hold-markers of a building to be removed once
+     * as many turns have ended
+     * @post Exception guarantee: Basic
      */
-    void calculateScores();
+    void scheduleHoldRelease(
+            const std::shared_ptr<Course::BuildingBase>& building);
 
     /**
-     * @brief Calculates scores based on player resources
-     * @param name of the player
-     * @param resources of the player
+     * @brief Gets the turns a building is still held for
+     * @return Turns, the hold-markers of buildings that ignore them
      */
-    void addResourcesToScore(std::string name,
-                             Course::ResourceMap resources);
+    int holdRemaining(const std::shared_ptr<Course::BuildingBase>& building);
 
     std::shared_ptr<GameEventHandler> gameEventHandler_ = nullptr;
     std::shared_ptr<ObjectManager> objectManager_ = nullptr;
     std::shared_ptr<GameScene> gameScene_ = nullptr;
     QWidget* parent_ = nullptr;
+    std::shared_ptr<ActionLog> actionLog_ = nullptr;
+    std::shared_ptr<StatsRecorder> statsRecorder_ = nullptr;
+    // Production of each player during the round being played
+    std::vector<qint32> roundProduction_;
+    std::shared_ptr<const BiomeConfig> biomeConfig_ =
+            BiomeConfig::defaultConfig();
 
 	int totalTurnCount_ = 30;	// Default
 	int currentTurnNumber_ = 1;
 
     std::vector<std::shared_ptr<Player>> players_;
 	int currentPlayerIndex_ = 0;
-    std::map<std::string, int> playerScores_;
+    // Policies of computer players by turn order, may be shorter
+    std::vector<std::shared_ptr<PlayerPolicy>> policies_;
+    ScoreLedger scoreLedger_;
+    ProductionForecast productionForecast_;
+    TurnTimers timers_;
+    // Timers removing the hold-markers of buildings
+    std::unordered_map<const Course::BuildingBase*, quint64> holdTimers_;
 
 	int mapWidth_ = 30;	// Default
 	int mapHeight_ = 20;// Default
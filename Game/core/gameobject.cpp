@@ -13,99 +13,110 @@
 namespace Course {
 
 // Private static variables must be initialized this way.
-unsigned int GameObject::c_next_id = 0;
+std::atomic<ObjectId> GameObject::c_next_id(0);
 
 GameObject::GameObject(const GameObject &original):
-    ID(GameObject::c_next_id),
+    ID(allocateId(original.OBJECTMANAGER.lock())),
     EVENTHANDLER(original.EVENTHANDLER),
-    OBJECTMANAGER(original.OBJECTMANAGER)
+    OBJECTMANAGER(original.OBJECTMANAGER),
+    m_coordinate(original.m_coordinate),
+    m_has_coordinate(original.m_has_coordinate)
 {
     m_owner = original.m_owner;
-    if(original.m_coordinate)
-    {
-        m_coordinate = std::make_unique<Coordinate>(*original.m_coordinate);
-    }
-    else
-    {
-        m_coordinate = nullptr;
-    }
     m_descriptions = original.m_descriptions;
-    ++c_next_id;
 }
 
 GameObject::GameObject(const std::shared_ptr<iGameEventHandler>& eventhandler,
                        const std::shared_ptr<iObjectManager>& objectmanager):
-    ID(GameObject::c_next_id),
+    ID(allocateId(objectmanager)),
     EVENTHANDLER(eventhandler),
     OBJECTMANAGER(objectmanager),
     m_owner(std::shared_ptr<PlayerBase>(nullptr)),
-    m_coordinate(),
+    m_coordinate(0, 0),
+    m_has_coordinate(false),
     m_descriptions({})
 {
-    ++c_next_id;
 }
 
 GameObject::GameObject(const std::shared_ptr<PlayerBase>& owner,
                        const std::shared_ptr<iGameEventHandler>& eventhandler,
                        const std::shared_ptr<iObjectManager>& objectmanager):
-    ID(GameObject::c_next_id),
+    ID(allocateId(objectmanager)),
     EVENTHANDLER(eventhandler),
     OBJECTMANAGER(objectmanager),
     m_owner(owner),
-    m_coordinate(),
+    m_coordinate(0, 0),
+    m_has_coordinate(false),
     m_descriptions({})
 {
-    ++c_next_id;
 }
 
 GameObject::GameObject(const Coordinate& coordinate,
                        const std::shared_ptr<PlayerBase>& owner,
                        const std::shared_ptr<iGameEventHandler>& eventhandler,
                        const std::shared_ptr<iObjectManager>& objectmanager):
-    ID(GameObject::c_next_id),
+    ID(allocateId(objectmanager)),
     EVENTHANDLER(eventhandler),
     OBJECTMANAGER(objectmanager),
     m_owner(owner),
-    m_coordinate(),
+    m_coordinate(coordinate),
+    m_has_coordinate(true),
     m_descriptions({})
 {
-    m_coordinate = std::make_unique<Coordinate>(coordinate);
-    ++c_next_id;
 }
 
 GameObject::GameObject(const Coordinate& coordinate,
                        const std::shared_ptr<iGameEventHandler>& eventhandler,
                        const std::shared_ptr<iObjectManager>& objectmanager):
-    ID(GameObject::c_next_id),
+    ID(allocateId(objectmanager)),
     EVENTHANDLER(eventhandler),
     OBJECTMANAGER(objectmanager),
     m_owner(std::shared_ptr<PlayerBase>(nullptr)),
-    m_coordinate(),
+    m_coordinate(coordinate),
+    m_has_coordinate(true),
     m_descriptions({})
 {
-    m_coordinate = std::make_unique<Coordinate>(coordinate);
-    ++c_next_id;
 }
 
 
+ObjectId GameObject::allocateId(
+        const std::shared_ptr<iObjectManager>& objectmanager)
+{
+    if(objectmanager)
+    {
+        return objectmanager->allocateId();
+    }
+    return c_next_id++;
+}
+
 void GameObject::setOwner(const std::shared_ptr<PlayerBase>& owner)
 {
     m_owner = std::weak_ptr<PlayerBase>(owner);
+
+    // The world keeps a raster of tile owners
+    if(m_has_coordinate &&
+            Game::typeTraits(getTypeTag()).kind == Game::TypeKind::TILE){
+        std::shared_ptr<iObjectManager> objectmanager = OBJECTMANAGER.lock();
+        if(objectmanager != nullptr){
+            objectmanager->tileOwnerChanged(m_coordinate, owner);
+        }
+    }
 }
 
 void GameObject::setCoordinate(const std::shared_ptr<Coordinate>& coordinate)
 {
-    m_coordinate = std::make_unique<Coordinate>(*coordinate);
+    setCoordinate(*coordinate);
 }
 
 void GameObject::setCoordinate(const Coordinate& coordinate)
 {
-    m_coordinate = std::make_unique<Coordinate>(coordinate);
+    m_coordinate = coordinate;
+    m_has_coordinate = true;
 }
 
 void GameObject::unsetCoordinate()
 {
-    m_coordinate = std::unique_ptr<Coordinate>(nullptr);
+    m_has_coordinate = false;
 }
 
 void GameObject::setDescriptions(const DescriptionMap& descriptions)
@@ -152,20 +163,20 @@ std::shared_ptr<PlayerBase> GameObject::getOwner() const
 
 std::shared_ptr<Coordinate> GameObject::getCoordinatePtr() const
 {
-    if(m_coordinate)
+    if(m_has_coordinate)
     {
-        return std::make_shared<Coordinate>(*m_coordinate);
+        return std::make_shared<Coordinate>(m_coordinate);
     }
     return nullptr;
 }
 
-Coordinate GameObject::getCoordinate() const
+const Coordinate& GameObject::getCoordinate() const
 {
-    if( not m_coordinate )
+    if( not m_has_coordinate )
     {
         throw InvalidPointer("GameObject has no Coordinate.");
     }
-    return Coordinate(*m_coordinate);
+    return m_coordinate;
 }
 
 std::string GameObject::getDescription(const std::string& key) const
@@ -188,6 +199,11 @@ std::string GameObject::getType() const
     return "GameObject";
 }
 
+Game::TypeTag GameObject::getTypeTag() const
+{
+    return Game::TypeTag::UNKNOWN;
+}
+
 bool GameObject::hasSameOwnerAs(
         const std::shared_ptr<GameObject> &other) const
 {
@@ -202,16 +218,12 @@ bool GameObject::hasSameCoordinateAs(
     {
         return false;
     }
-    if(not m_coordinate)
+    if(not m_has_coordinate or not other->m_has_coordinate)
     {
-        if(not other->getCoordinatePtr())
-        {
-            return true;
-        }
-        return false;
+        return m_has_coordinate == other->m_has_coordinate;
     }
 
-    return m_coordinate->operator ==(*(other->getCoordinatePtr().get()));
+    return m_coordinate == other->m_coordinate;
 }
 
 std::shared_ptr<iGameEventHandler> GameObject::lockEventHandler() const
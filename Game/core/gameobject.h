@@ -5,8 +5,10 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <atomic>
 
 #include "coordinate.h"
+#include "typetags.hh"
 
 namespace Course {
 
@@ -109,6 +111,8 @@ public:
      * @brief Change GameObject's "owner".
      * @param owner a shared pointer to the new "owner".
      * @post Exception guarantee: No-throw
+     * @note For tiles the ObjectManager is told about the change so its
+     * owner raster stays in sync.
      */
     virtual void setOwner(const std::shared_ptr<PlayerBase>& owner) final;
 
@@ -210,11 +214,34 @@ public:
 
     /**
      * @brief Returns GameObject's current coordinate.
+     * @return Reference to the coordinate stored in the GameObject, valid
+     * until the coordinate is changed.
      * @post Exception guaranee: Strong
      * @exception
      * InvalidPointer - If the GameObject doesn't have a coordinate.
      */
-    virtual Coordinate getCoordinate() const final;
+    virtual const Coordinate& getCoordinate() const final;
+
+    /**
+     * @brief Tells if the GameObject has a coordinate.
+     * @post Exception guarantee: No-throw
+     */
+    bool hasCoordinate() const
+    {
+        return m_has_coordinate;
+    }
+
+    /**
+     * @brief Returns GameObject's coordinate without copying or throwing.
+     * Use this in loops that read positions of many objects.
+     * @return Pointer to the stored coordinate or nullptr if the
+     * GameObject has no coordinate. Valid until the coordinate is changed.
+     * @post Exception guarantee: No-throw
+     */
+    const Coordinate* peekCoordinate() const
+    {
+        return m_has_coordinate ? &m_coordinate : nullptr;
+    }
 
     /**
      * @brief Returns the map of descriptions in GameObject.
@@ -233,6 +260,14 @@ public:
      */
     virtual std::string getType() const;
 
+    /**
+     * @brief Returns the compile time tag of the Object's class.
+     * @return TypeTag, UNKNOWN for classes without a tag.
+     * @post Exception guarantee: No-throw
+     * @note Use this instead of comparing getType() strings.
+     */
+    virtual Game::TypeTag getTypeTag() const;
+
     /**
      * @brief Function to compare if objects have same owner.
      * * @param other The other GameObject
@@ -277,10 +312,21 @@ private:
     const std::weak_ptr<iObjectManager> OBJECTMANAGER;
 
     std::weak_ptr<PlayerBase> m_owner;
-    std::unique_ptr<Coordinate> m_coordinate;
+    // Stored inline, m_has_coordinate tells if it is set
+    Coordinate m_coordinate;
+    bool m_has_coordinate;
     std::map<std::string, std::string> m_descriptions;
 
-    static ObjectId c_next_id;
+    /**
+     * @brief Gets the ID for a new object from its ObjectManager
+     * @param objectmanager - ObjectManager of the world, may be nullptr
+     * @return Per world ID, or a process wide one without an ObjectManager
+     */
+    static ObjectId allocateId(
+            const std::shared_ptr<iObjectManager>& objectmanager);
+
+    // Only used for objects that have no ObjectManager
+    static std::atomic<ObjectId> c_next_id;
 };
 
 }
@@ -0,0 +1,304 @@
+#include "mapsnapshot.hh"
+#include "constants/constants.hh"
+#include "core/basicresources.h"
+
+#include <cstring>
+#include <unordered_map>
+
+namespace Game {
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = {'P', 'V', 'S', 'N', 'A', 'P', 0, 0};
+const quint32 SNAPSHOT_ENDIAN_MARKER = 0x01020304;
+
+// Index in these lists is the code stored in the snapshot.
+// Never reorder, only append.
+const std::vector<TypeTag> TILE_TYPES = {
+    TypeTag::UNKNOWN, TypeTag::FOREST, TypeTag::GRASSLAND, TypeTag::LAKE,
+    TypeTag::MOUNTAIN, TypeTag::OCEAN
+};
+const std::vector<std::string> BUILDING_TYPES = {
+    "Farm", "HeadQuarters", "Outpost", "Mine", "Fishing Boat", "Lake Cottage"
+};
+const std::vector<QString> BUILDING_NAMES = {
+    FARM, HQ, OUTPOST, MINE, FISHING_BOAT, LAKE_COTTAGE
+};
+const std::vector<std::string> WORKER_TYPES = {
+    "BasicWorker", "Farmer", "Miner"
+};
+const std::vector<QString> WORKER_NAMES = {
+    WORKER_BASIC, WORKER_FARMER, WORKER_MINER
+};
+
+}
+
+std::shared_ptr<MapSnapshot> MapSnapshot::open(const QString &path)
+{
+    std::shared_ptr<MapSnapshot> snapshot(new MapSnapshot());
+    snapshot->file_ = std::make_unique<QFile>(path);
+
+    if(!snapshot->file_->open(QIODevice::ReadOnly)){
+        return nullptr;
+    }
+
+    qint64 size = snapshot->file_->size();
+    if(size < static_cast<qint64>(sizeof(SnapshotHeader))){
+        return nullptr;
+    }
+
+    snapshot->data_ = snapshot->file_->map(0, size);
+    if(snapshot->data_ == nullptr){
+        return nullptr;
+    }
+
+    snapshot->header_ = reinterpret_cast<const SnapshotHeader*>(
+                snapshot->data_);
+    if(!snapshot->validate(size)){
+        return nullptr;
+    }
+
+    snapshot->locateSections();
+    return snapshot;
+}
+
+std::shared_ptr<MapSnapshot> MapSnapshot::create(
+        SnapshotHeader header,
+        const std::vector<SnapshotPlayer> &players,
+        const std::vector<SnapshotTile> &tiles,
+        const std::vector<SnapshotObject> &objects)
+{
+    layout(header, players, tiles, objects);
+
+    std::shared_ptr<MapSnapshot> snapshot(new MapSnapshot());
+    std::vector<uchar>& buffer = snapshot->buffer_;
+    buffer.resize(header.objectOffset +
+                  objects.size() * sizeof(SnapshotObject));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+    std::memcpy(buffer.data() + header.playerOffset, players.data(),
+                players.size() * sizeof(SnapshotPlayer));
+    std::memcpy(buffer.data() + header.tileOffset, tiles.data(),
+                tiles.size() * sizeof(SnapshotTile));
+    std::memcpy(buffer.data() + header.objectOffset, objects.data(),
+                objects.size() * sizeof(SnapshotObject));
+
+    snapshot->data_ = buffer.data();
+    snapshot->header_ = reinterpret_cast<const SnapshotHeader*>(
+                snapshot->data_);
+    snapshot->locateSections();
+    return snapshot;
+}
+
+bool MapSnapshot::write(const QString &path,
+                        SnapshotHeader header,
+                        const std::vector<SnapshotPlayer> &players,
+                        const std::vector<SnapshotTile> &tiles,
+                        const std::vector<SnapshotObject> &objects)
+{
+    layout(header, players, tiles, objects);
+
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        return false;
+    }
+
+    qint64 expected = header.objectOffset +
+            objects.size() * sizeof(SnapshotObject);
+    qint64 written = file.write(reinterpret_cast<const char*>(&header),
+                                sizeof(header));
+    written += file.write(reinterpret_cast<const char*>(players.data()),
+                          players.size() * sizeof(SnapshotPlayer));
+    written += file.write(reinterpret_cast<const char*>(tiles.data()),
+                          tiles.size() * sizeof(SnapshotTile));
+    written += file.write(reinterpret_cast<const char*>(objects.data()),
+                          objects.size() * sizeof(SnapshotObject));
+
+    return written == expected;
+}
+
+MapSnapshot::~MapSnapshot()
+{
+    if(file_ != nullptr && data_ != nullptr){
+        file_->unmap(const_cast<uchar*>(data_));
+    }
+}
+
+const SnapshotHeader &MapSnapshot::header() const
+{
+    return *header_;
+}
+
+const SnapshotPlayer &MapSnapshot::player(unsigned int index) const
+{
+    return players_[index];
+}
+
+const SnapshotTile &MapSnapshot::tile(unsigned int index) const
+{
+    return tiles_[index];
+}
+
+const SnapshotObject &MapSnapshot::object(unsigned int index) const
+{
+    return objects_[index];
+}
+
+quint8 MapSnapshot::tileTypeCode(TypeTag tag)
+{
+    for(unsigned int i=1; i<TILE_TYPES.size(); i++){
+        if(TILE_TYPES.at(i) == tag){
+            return i;
+        }
+    }
+    return SNAPSHOT_TILE_UNKNOWN;
+}
+
+TypeTag MapSnapshot::tileTypeTag(quint8 code)
+{
+    if(code < TILE_TYPES.size()){
+        return TILE_TYPES.at(code);
+    }
+    return TypeTag::UNKNOWN;
+}
+
+quint8 MapSnapshot::objectTypeCode(SnapshotObjectKind kind,
+                                   const std::string &type)
+{
+    const std::vector<std::string>& types =
+            kind == SNAPSHOT_BUILDING ? BUILDING_TYPES : WORKER_TYPES;
+
+    for(unsigned int i=0; i<types.size(); i++){
+        if(types.at(i) == type){
+            return i;
+        }
+    }
+    return 0xFF;
+}
+
+QString MapSnapshot::objectTypeName(SnapshotObjectKind kind, quint8 code)
+{
+    const std::vector<QString>& names =
+            kind == SNAPSHOT_BUILDING ? BUILDING_NAMES : WORKER_NAMES;
+
+    if(code < names.size()){
+        return names.at(code);
+    }
+    return EMPTY;
+}
+
+void MapSnapshot::layout(SnapshotHeader &header,
+                         const std::vector<SnapshotPlayer> &players,
+                         const std::vector<SnapshotTile> &tiles,
+                         const std::vector<SnapshotObject> &objects)
+{
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.endianMarker = SNAPSHOT_ENDIAN_MARKER;
+    header.playerCount = players.size();
+    header.playerOffset = sizeof(SnapshotHeader);
+    header.tileCount = tiles.size();
+    header.tileOffset = header.playerOffset +
+            players.size() * sizeof(SnapshotPlayer);
+    header.objectCount = objects.size();
+    header.objectOffset = header.tileOffset +
+            tiles.size() * sizeof(SnapshotTile);
+}
+
+void MapSnapshot::locateSections()
+{
+    players_ = reinterpret_cast<const SnapshotPlayer*>(
+                data_ + header_->playerOffset);
+    tiles_ = reinterpret_cast<const SnapshotTile*>(
+                data_ + header_->tileOffset);
+    objects_ = reinterpret_cast<const SnapshotObject*>(
+                data_ + header_->objectOffset);
+}
+
+bool MapSnapshot::validate(qint64 size) const
+{
+    if(std::memcmp(header_->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0
+            || header_->version != SNAPSHOT_VERSION
+            || header_->endianMarker != SNAPSHOT_ENDIAN_MARKER){
+        return false;
+    }
+
+    if(header_->mapWidth <= 0 || header_->mapHeight <= 0 ||
+            static_cast<qint64>(header_->mapWidth) * header_->mapHeight
+            != header_->tileCount){
+        return false;
+    }
+
+    // Every section must lie completely inside the file
+    qint64 playerEnd = static_cast<qint64>(header_->playerOffset) +
+            static_cast<qint64>(header_->playerCount) * sizeof(SnapshotPlayer);
+    qint64 tileEnd = static_cast<qint64>(header_->tileOffset) +
+            static_cast<qint64>(header_->tileCount) * sizeof(SnapshotTile);
+    qint64 objectEnd = static_cast<qint64>(header_->objectOffset) +
+            static_cast<qint64>(header_->objectCount) * sizeof(SnapshotObject);
+
+    if(playerEnd > size || tileEnd > size || objectEnd > size ||
+            header_->playerOffset % alignof(SnapshotPlayer) != 0 ||
+            header_->tileOffset % alignof(SnapshotTile) != 0 ||
+            header_->objectOffset % alignof(SnapshotObject) != 0){
+        return false;
+    }
+
+    if(header_->currentTurnNumber < 1 || header_->currentPlayerIndex < 0 ||
+            static_cast<quint32>(header_->currentPlayerIndex) >=
+            header_->playerCount){
+        return false;
+    }
+
+    // Tiles are made lazily, codes outside the list couldn't be made at
+    // all. SNAPSHOT_TILE_UNKNOWN is a coordinate without a tile.
+    const SnapshotTile* tiles = reinterpret_cast<const SnapshotTile*>(
+                data_ + header_->tileOffset);
+    for(quint32 i=0; i<header_->tileCount; i++){
+        if(tiles[i].type >= TILE_TYPES.size()){
+            return false;
+        }
+    }
+
+    // Objects must be placeable where they are, restoring them can't fail
+    const SnapshotObject* objects = reinterpret_cast<const SnapshotObject*>(
+                data_ + header_->objectOffset);
+    // Buildings and workers placed on each tile so far
+    std::unordered_map<quint32, std::pair<unsigned int, unsigned int>> used;
+    for(quint32 i=0; i<header_->objectCount; i++){
+        const SnapshotObject& object = objects[i];
+        if(object.tileIndex >= header_->tileCount ||
+                object.owner >= header_->playerCount){
+            return false;
+        }
+        const SnapshotTile& tile = tiles[object.tileIndex];
+        if(tile.type == SNAPSHOT_TILE_UNKNOWN){
+            return false;
+        }
+
+        std::pair<unsigned int, unsigned int>& count = used[object.tileIndex];
+        if(object.kind == SNAPSHOT_BUILDING){
+            if(object.type >= BUILDING_TYPES.size() || object.hold < 0 ||
+                    (tile.owner != SNAPSHOT_NO_OWNER &&
+                     tile.owner != object.owner) ||
+                    // Same terrain rule as Building::canBePlacedOnTile
+                    (typeTraits(typeTagFromName(
+                                    BUILDING_TYPES.at(object.type))).placement &
+                     tagBit(TILE_TYPES.at(tile.type))) == 0 ||
+                    ++count.first > tile.maxBuildings){
+                return false;
+            }
+        } else if(object.kind == SNAPSHOT_WORKER){
+            if(object.type >= WORKER_TYPES.size() ||
+                    object.focus > Course::ORE ||
+                    tile.owner != object.owner ||
+                    ++count.second > tile.maxWorkers){
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,264 @@
+#ifndef MAPSNAPSHOT_HH
+#define MAPSNAPSHOT_HH
+
+#include "core/typetags.hh"
+
+#include <QString>
+#include <QFile>
+#include <QtGlobal>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Version of the snapshot layout. Bump whenever any of the
+ * structures below change.
+ */
+const quint32 SNAPSHOT_VERSION = 1;
+
+/**
+ * @brief Owner index stored for tiles that nobody has claimed
+ */
+const quint8 SNAPSHOT_NO_OWNER = 0xFF;
+
+/**
+ * @brief Tile type codes stored in the snapshot
+ */
+enum SnapshotTileType : quint8 {
+    SNAPSHOT_TILE_UNKNOWN = 0,
+    SNAPSHOT_TILE_FOREST = 1,
+    SNAPSHOT_TILE_GRASSLAND = 2,
+    SNAPSHOT_TILE_LAKE = 3,
+    SNAPSHOT_TILE_MOUNTAIN = 4,
+    SNAPSHOT_TILE_OCEAN = 5
+};
+
+/**
+ * @brief Kind of a placeable object stored in the snapshot
+ */
+enum SnapshotObjectKind : quint8 {
+    SNAPSHOT_BUILDING = 0,
+    SNAPSHOT_WORKER = 1
+};
+
+/**
+ * @brief File header. Offsets are in bytes from the beginning of the file.
+ */
+struct SnapshotHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 endianMarker;
+    qint32 mapWidth;
+    qint32 mapHeight;
+    qint32 seed;
+    qint32 totalTurnCount;
+    qint32 currentTurnNumber;
+    qint32 currentPlayerIndex;
+    quint32 playerCount;
+    quint32 playerOffset;
+    quint32 tileCount;
+    quint32 tileOffset;
+    quint32 objectCount;
+    quint32 objectOffset;
+};
+
+/**
+ * @brief Player record. Resources are indexed with Course::BasicResource.
+ */
+struct SnapshotPlayer
+{
+    char name[32];
+    quint32 rgba;
+    qint32 resources[6];
+};
+
+/**
+ * @brief Tile record. Tiles are stored row by row (index = y * width + x).
+ * Production is indexed with Course::BasicResource.
+ */
+struct SnapshotTile
+{
+    quint8 type;
+    quint8 owner;
+    quint8 maxBuildings;
+    quint8 maxWorkers;
+    qint16 production[6];
+};
+
+/**
+ * @brief Building or worker record
+ */
+struct SnapshotObject
+{
+    quint32 tileIndex;
+    quint8 kind;
+    quint8 type;
+    quint8 owner;
+    quint8 focus;
+    qint32 hold;
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "Snapshot header layout changed");
+static_assert(sizeof(SnapshotPlayer) == 60, "Snapshot player layout changed");
+static_assert(sizeof(SnapshotTile) == 16, "Snapshot tile layout changed");
+static_assert(sizeof(SnapshotObject) == 12, "Snapshot object layout changed");
+
+/**
+ * @brief The MapSnapshot class is a read-only view to a saved game.
+ * The file is memory mapped and the tile array is used as is, so opening
+ * a snapshot costs only the page faults of the parts that are read.
+ * Snapshots can also be kept in memory and shared by many games, see
+ * GameManager::fork.
+ */
+class MapSnapshot
+{
+public:
+    /**
+     * @brief Opens and maps a snapshot file
+     * @param path - Path of the snapshot file
+     * @post Exception guarantee: No-throw
+     * @return Snapshot or nullptr if the file is missing or invalid
+     */
+    static std::shared_ptr<MapSnapshot> open(const QString& path);
+
+    /**
+     * @brief Writes a snapshot file
+     * @param path - Path of the snapshot file
+     * @param header - Header, counts and offsets are filled in here
+     * @param players - Player records
+     * @param tiles - Tile records, row by row
+     * @param objects - Building and worker records
+     * @post Exception guarantee: No-throw
+     * @return True if the whole file was written
+     */
+    static bool write(const QString& path,
+                      SnapshotHeader header,
+                      const std::vector<SnapshotPlayer>& players,
+                      const std::vector<SnapshotTile>& tiles,
+                      const std::vector<SnapshotObject>& objects);
+
+    /**
+     * @brief Creates a snapshot in memory with the same layout as the file
+     * @param header - Header, counts and offsets are filled in here
+     * @param players - Player records
+     * @param tiles - Tile records, row by row
+     * @param objects - Building and worker records
+     * @post Exception guarantee: Strong
+     * @return Snapshot
+     */
+    static std::shared_ptr<MapSnapshot> create(
+            SnapshotHeader header,
+            const std::vector<SnapshotPlayer>& players,
+            const std::vector<SnapshotTile>& tiles,
+            const std::vector<SnapshotObject>& objects);
+
+    MapSnapshot(const MapSnapshot&) = delete;
+    MapSnapshot& operator=(const MapSnapshot&) = delete;
+
+    ~MapSnapshot();
+
+    /**
+     * @brief Gets the snapshot header
+     * @post Exception guarantee: No-throw
+     */
+    const SnapshotHeader& header() const;
+
+    /**
+     * @brief Gets a player record
+     * @param index - Player index
+     * @pre index < header().playerCount
+     * @post Exception guarantee: No-throw
+     */
+    const SnapshotPlayer& player(unsigned int index) const;
+
+    /**
+     * @brief Gets a tile record
+     * @param index - Tile index, y * width + x
+     * @pre index < header().tileCount
+     * @post Exception guarantee: No-throw
+     */
+    const SnapshotTile& tile(unsigned int index) const;
+
+    /**
+     * @brief Gets a building or worker record
+     * @param index - Object index
+     * @pre index < header().objectCount
+     * @post Exception guarantee: No-throw
+     */
+    const SnapshotObject& object(unsigned int index) const;
+
+    /**
+     * @brief Converts a tile type tag to snapshot code
+     * @param tag - Tile type tag
+     * @post Exception guarantee: No-throw
+     */
+    static quint8 tileTypeCode(TypeTag tag);
+
+    /**
+     * @brief Converts a snapshot code to tile type tag
+     * @param code - Snapshot tile code
+     * @post Exception guarantee: No-throw
+     * @return Tag or UNKNOWN
+     */
+    static TypeTag tileTypeTag(quint8 code);
+
+    /**
+     * @brief Converts a building or worker type name to snapshot code
+     * @param kind - Building or worker
+     * @param type - Type as returned by getType()
+     * @post Exception guarantee: No-throw
+     * @return Code or 0xFF if the type is not known
+     */
+    static quint8 objectTypeCode(SnapshotObjectKind kind,
+                                 const std::string& type);
+
+    /**
+     * @brief Converts a snapshot code to the name used by GameManager
+     * @param kind - Building or worker
+     * @param code - Snapshot code
+     * @post Exception guarantee: No-throw
+     * @return Name, see constants.hh. Empty if code is not known
+     */
+    static QString objectTypeName(SnapshotObjectKind kind, quint8 code);
+
+private:
+    MapSnapshot() = default;
+
+    /**
+     * @brief Fills in the identification, counts and offsets of a header
+     */
+    static void layout(SnapshotHeader& header,
+                       const std::vector<SnapshotPlayer>& players,
+                       const std::vector<SnapshotTile>& tiles,
+                       const std::vector<SnapshotObject>& objects);
+
+    /**
+     * @brief Checks that the counts and offsets fit in the mapped file,
+     * the turn and current player are valid, every tile type code is
+     * known and every object fits the terrain, owner and capacity of its
+     * tile
+     */
+    bool validate(qint64 size) const;
+
+    /**
+     * @brief Points the sections to data_ at the header offsets
+     */
+    void locateSections();
+
+    std::unique_ptr<QFile> file_;
+    // Contents of snapshots created in memory
+    std::vector<uchar> buffer_;
+    const uchar* data_ = nullptr;
+    const SnapshotHeader* header_ = nullptr;
+    const SnapshotPlayer* players_ = nullptr;
+    const SnapshotTile* tiles_ = nullptr;
+    const SnapshotObject* objects_ = nullptr;
+};
+
+}
+
+#endif // MAPSNAPSHOT_HH
@@ -0,0 +1,236 @@
+#ifndef NEIGHBOURRANGE_HH
+#define NEIGHBOURRANGE_HH
+
+#include "core/coordinate.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <initializer_list>
+#include <iterator>
+
+namespace Game {
+
+/**
+ * @brief Which coordinates count as neighbours
+ */
+enum class Connectivity {
+    // Up, down, left and right. Distance is |dx| + |dy|
+    FOUR,
+    // Diagonals too. Distance is max(|dx|, |dy|)
+    EIGHT
+};
+
+/**
+ * @brief The NeighbourRange class iterates the coordinates around a centre
+ * without allocating. The centre itself is never included.
+ *
+ * With EIGHT connectivity and no clipping the coordinates and their order
+ * are the same as in Coordinate::neighbours(radius).
+ * @code
+ * for(Course::Coordinate c : NeighbourRange(centre, 2).clippedTo(w, h)){
+ *     ...
+ * }
+ * @endcode
+ */
+class NeighbourRange
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Course::Coordinate;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Course::Coordinate;
+
+        Course::Coordinate operator*() const
+        {
+            return Course::Coordinate(x_, y_);
+        }
+
+        iterator& operator++()
+        {
+            y_ = range_->firstRow(x_, y_ + 1);
+            skipEmptyColumns();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+
+        bool operator==(const iterator& other) const
+        {
+            return x_ == other.x_ && y_ == other.y_;
+        }
+
+        bool operator!=(const iterator& other) const
+        {
+            return !(*this == other);
+        }
+
+    private:
+        friend class NeighbourRange;
+
+        iterator(const NeighbourRange* range, int x, int y) :
+            range_(range), x_(x), y_(y)
+        {
+        }
+
+        // Moves to the next column that has rows left, or to end()
+        void skipEmptyColumns()
+        {
+            while(y_ == NO_ROW && x_ <= range_->maxX_){
+                x_++;
+                if(x_ <= range_->maxX_){
+                    y_ = range_->firstRow(x_, INT_MIN);
+                }
+            }
+            if(y_ == NO_ROW){
+                x_ = range_->maxX_ + 1;
+                y_ = 0;
+            }
+        }
+
+        const NeighbourRange* range_;
+        int x_;
+        int y_;
+    };
+
+    /**
+     * @brief Constructor for the class
+     * @param centre - Coordinate whose neighbours are iterated
+     * @param radius - Largest distance from the centre
+     * @param connectivity - How distance is measured
+     * @param ringOnly - Only coordinates exactly radius away
+     */
+    explicit NeighbourRange(const Course::Coordinate& centre,
+                            int radius = 1,
+                            Connectivity connectivity = Connectivity::EIGHT,
+                            bool ringOnly = false) :
+        centreX_(centre.x()),
+        centreY_(centre.y()),
+        radius_(std::max(radius, 0)),
+        connectivity_(connectivity),
+        ringOnly_(ringOnly),
+        minX_(centreX_ - radius_),
+        maxX_(centreX_ + radius_),
+        minY_(centreY_ - radius_),
+        maxY_(centreY_ + radius_)
+    {
+    }
+
+    /**
+     * @brief Leaves out coordinates outside a width x height map
+     * @param width - Map width, valid x is 0...width-1
+     * @param height - Map height, valid y is 0...height-1
+     * @return Copy of this range with the limits
+     * @note Returns a copy so a temporary range can be clipped in a
+     * range-for without dangling
+     */
+    NeighbourRange clippedTo(int width, int height) const
+    {
+        NeighbourRange clipped(*this);
+        clipped.minX_ = std::max(minX_, 0);
+        clipped.minY_ = std::max(minY_, 0);
+        clipped.maxX_ = std::min(maxX_, width - 1);
+        clipped.maxY_ = std::min(maxY_, height - 1);
+        return clipped;
+    }
+
+    iterator begin() const
+    {
+        if(minX_ > maxX_){
+            return end();
+        }
+        iterator first(this, minX_, firstRow(minX_, INT_MIN));
+        first.skipEmptyColumns();
+        return first;
+    }
+
+    iterator end() const
+    {
+        return iterator(this, maxX_ + 1, 0);
+    }
+
+    /**
+     * @brief Tells if a coordinate is part of the range
+     * @param coordinate - Any coordinate
+     */
+    bool contains(const Course::Coordinate& coordinate) const
+    {
+        return coordinate.x() >= minX_ && coordinate.x() <= maxX_ &&
+                firstRow(coordinate.x(), coordinate.y()) == coordinate.y();
+    }
+
+    int getRadius() const
+    {
+        return radius_;
+    }
+
+private:
+    static const int NO_ROW = INT_MAX;
+
+    /**
+     * @brief Finds the first row at or after from in column x
+     * @return Row or NO_ROW if the column has none left
+     */
+    int firstRow(int x, int from) const
+    {
+        int dx = std::abs(x - centreX_);
+        int reach = connectivity_ == Connectivity::EIGHT ? radius_
+                                                         : radius_ - dx;
+        if(reach < 0){
+            return NO_ROW;
+        }
+
+        // On rings most columns only have the top and bottom rows
+        bool endsOnly = ringOnly_ &&
+                !(connectivity_ == Connectivity::EIGHT && dx == radius_);
+        int top = centreY_ - reach;
+        int bottom = centreY_ + reach;
+
+        if(endsOnly){
+            for(int y : {top, bottom}){
+                if(y >= from && isRow(x, y)){
+                    return y;
+                }
+            }
+            return NO_ROW;
+        }
+
+        for(int y = std::max(std::max(from, top), minY_);
+            y <= std::min(bottom, maxY_); y++){
+            if(isRow(x, y)){
+                return y;
+            }
+        }
+        return NO_ROW;
+    }
+
+    bool isRow(int x, int y) const
+    {
+        return y >= minY_ && y <= maxY_ && !(x == centreX_ && y == centreY_);
+    }
+
+    int centreX_;
+    int centreY_;
+    int radius_;
+    Connectivity connectivity_;
+    bool ringOnly_;
+
+    // Box the coordinates are taken from, inclusive
+    int minX_;
+    int maxX_;
+    int minY_;
+    int maxY_;
+};
+
+}
+
+#endif // NEIGHBOURRANGE_HH
@@ -0,0 +1,83 @@
+#include "objectpool.hh"
+
+namespace Game {
+
+namespace {
+
+/**
+ * @brief Rounds the size up so every block in a chunk stays aligned
+ */
+std::size_t alignedSize(std::size_t size)
+{
+    const std::size_t alignment = alignof(std::max_align_t);
+    if(size < sizeof(void*)){
+        size = sizeof(void*);
+    }
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+}
+
+BlockPool::BlockPool(std::size_t blockSize, std::size_t blocksPerChunk) :
+    blockSize_(alignedSize(blockSize)),
+    blocksPerChunk_(blocksPerChunk == 0 ? 1 : blocksPerChunk)
+{
+}
+
+void *BlockPool::allocate()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if(freeList_ == nullptr){
+        // new[] of unsigned char is aligned for any type of its size
+        std::unique_ptr<unsigned char[]> chunk(
+                    new unsigned char[blockSize_ * blocksPerChunk_]);
+        chunks_.reserve(chunks_.size() + 1);
+
+        // Link the blocks in address order
+        for(std::size_t i = blocksPerChunk_; i > 0; i--){
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(
+                        chunk.get() + (i - 1) * blockSize_);
+            block->next = freeList_;
+            freeList_ = block;
+        }
+        chunks_.push_back(std::move(chunk));
+    }
+
+    FreeBlock* block = freeList_;
+    freeList_ = block->next;
+    used_++;
+    return block;
+}
+
+void BlockPool::deallocate(void *block) noexcept
+{
+    if(block == nullptr){
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = freeList_;
+    freeList_ = freed;
+    used_--;
+}
+
+std::size_t BlockPool::getBlockSize() const
+{
+    return blockSize_;
+}
+
+std::size_t BlockPool::getUsedCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return used_;
+}
+
+std::size_t BlockPool::getCapacity()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return chunks_.size() * blocksPerChunk_;
+}
+
+}
@@ -0,0 +1,161 @@
+#ifndef OBJECTPOOL_HH
+#define OBJECTPOOL_HH
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief The BlockPool class hands out memory blocks of one size.
+ * Blocks are carved from larger chunks and returned blocks are kept in a
+ * free list, so creating and destroying objects of the same type reuses
+ * the same memory instead of going to the heap every time.
+ * Chunks are only released when the pool is destroyed.
+ */
+class BlockPool
+{
+public:
+    /**
+     * @brief Constructor for the class
+     * @param blockSize - Size of one block in bytes
+     * @param blocksPerChunk - Blocks allocated at once when the pool is empty
+     */
+    explicit BlockPool(std::size_t blockSize,
+                       std::size_t blocksPerChunk = 64);
+
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    /**
+     * @brief Takes a block from the pool
+     * @post Exception guarantee: Strong
+     * @exceptions std::bad_alloc - A new chunk couldn't be allocated
+     * @return Block of getBlockSize() bytes aligned for any scalar type
+     */
+    void* allocate();
+
+    /**
+     * @brief Returns a block to the pool
+     * @param block - Block from allocate() of this pool
+     * @post Exception guarantee: No-throw
+     */
+    void deallocate(void* block) noexcept;
+
+    /**
+     * @brief Gets the size of the blocks after alignment
+     * @post Exception guarantee: No-throw
+     */
+    std::size_t getBlockSize() const;
+
+    /**
+     * @brief Gets the amount of blocks currently handed out
+     * @post Exception guarantee: No-throw
+     */
+    std::size_t getUsedCount();
+
+    /**
+     * @brief Gets the amount of blocks in all chunks
+     * @post Exception guarantee: No-throw
+     */
+    std::size_t getCapacity();
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    const std::size_t blockSize_;
+    const std::size_t blocksPerChunk_;
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<unsigned char[]>> chunks_;
+    FreeBlock* freeList_ = nullptr;
+    std::size_t used_ = 0;
+};
+
+/**
+ * @brief The PoolAllocator class is a standard allocator that takes single
+ * objects from a BlockPool shared by every allocator of the same type.
+ * Arrays go to the normal heap.
+ *
+ * Use it through makePooled so the object and its shared_ptr control
+ * block live in one pooled block.
+ */
+template<typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t count)
+    {
+        if(count != 1){
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(pool().allocate());
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept
+    {
+        if(count != 1){
+            ::operator delete(pointer);
+            return;
+        }
+        pool().deallocate(pointer);
+    }
+
+    /**
+     * @brief Gets the pool of this type. Every thread uses the same
+     * pool, so blocks freed on a worker thread that has exited are reused
+     * by the others.
+     * @note Pools are never destroyed so objects released during program
+     * exit can still return their blocks.
+     */
+    static BlockPool& pool()
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t),
+                      "BlockPool only aligns to max_align_t");
+        static BlockPool* instance = new BlockPool(sizeof(T));
+        return *instance;
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept
+{
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) noexcept
+{
+    return false;
+}
+
+/**
+ * @brief Creates a shared object in the pool of its type.
+ * Works like std::make_shared.
+ * @param args - Constructor parameters of T
+ * @return Shared pointer to the new object
+ */
+template<typename T, typename... Args>
+std::shared_ptr<T> makePooled(Args&&... args)
+{
+    return std::allocate_shared<T>(PoolAllocator<T>(),
+                                   std::forward<Args>(args)...);
+}
+
+}
+
+#endif // OBJECTPOOL_HH
@@ -0,0 +1,180 @@
+#include "objectregistry.hh"
+#include "core/objectpool.hh"
+#include "constants/constants.hh"
+#include "constants/resourcemaps2.h"
+#include "core/resourcemaps.h"
+
+#include "buildings/farm.h"
+#include "buildings/cottage.h"
+#include "buildings/headquarters.h"
+#include "buildings/mine.h"
+#include "buildings/outpost.h"
+#include "buildings/fishingboat.hh"
+
+#include "workers/basicworker.h"
+#include "workers/farmer.hh"
+#include "workers/miner.hh"
+
+#include <array>
+
+namespace Game {
+
+namespace {
+
+const unsigned int TAG_COUNT = static_cast<unsigned int>(TypeTag::COUNT);
+
+/**
+ * @brief Factory for buildings that are created with their default costs.
+ * Buildings and workers come from per type pools because late games
+ * create and destroy a lot of them.
+ */
+template<typename T>
+std::shared_ptr<Course::BuildingBase> makeBuilding(
+        const std::shared_ptr<GameEventHandler>& geh,
+        const std::shared_ptr<ObjectManager>& om,
+        const std::shared_ptr<Player>& owner)
+{
+    return makePooled<T>(geh, om, owner);
+}
+
+/**
+ * @brief Factory for workers that are created with their default costs
+ */
+template<typename T>
+std::shared_ptr<Course::WorkerBase> makeWorker(
+        const std::shared_ptr<GameEventHandler>& geh,
+        const std::shared_ptr<ObjectManager>& om,
+        const std::shared_ptr<Player>& owner)
+{
+    return makePooled<T>(geh, om, owner);
+}
+
+// BasicWorker uses the game's efficiency instead of the course default
+std::shared_ptr<Course::WorkerBase> makeBasicWorker(
+        const std::shared_ptr<GameEventHandler>& geh,
+        const std::shared_ptr<ObjectManager>& om,
+        const std::shared_ptr<Player>& owner)
+{
+    return makePooled<Course::BasicWorker>(
+                geh, om, owner, 1,
+                Course::ConstResourceMaps::BW_RECRUITMENT_COST,
+                BW_WORKER_EFFICIENCY);
+}
+
+const std::vector<BuildingEntry>& buildingTable()
+{
+    static const std::vector<BuildingEntry> table = {
+        {TypeTag::FARM, FARM,
+         Course::ConstResourceMaps::FARM_BUILD_COST,
+         Course::ConstResourceMaps::FARM_PRODUCTION,
+         FARM_IMAGE, &makeBuilding<Course::Farm>},
+        {TypeTag::HEADQUARTERS, HQ,
+         Course::ConstResourceMaps::HQ_BUILD_COST,
+         Course::ConstResourceMaps::HQ_PRODUCTION,
+         HQ_IMAGE, &makeBuilding<Course::HeadQuarters>},
+        {TypeTag::OUTPOST, OUTPOST,
+         Course::ConstResourceMaps::OUTPOST_BUILD_COST,
+         Course::ConstResourceMaps::OUTPOST_PRODUCTION,
+         OUTPOST_IMAGE, &makeBuilding<Course::Outpost>},
+        {TypeTag::MINE, MINE,
+         MINE_BUILD_COST, MINE_PRODUCTION,
+         MINE_IMAGE, &makeBuilding<Mine>},
+        {TypeTag::FISHING_BOAT, FISHING_BOAT,
+         FISHING_BOAT_BUILD_COST, FISHING_BOAT_PRODUCTION,
+         SHIP_IMAGE, &makeBuilding<FishingBoat>},
+        {TypeTag::LAKE_COTTAGE, LAKE_COTTAGE,
+         LAKE_COTTAGE_BUILD_COST, LAKE_COTTAGE_PRODUCTION,
+         LAKE_COTTAGE_IMAGE, &makeBuilding<Cottage>}
+    };
+    return table;
+}
+
+const std::vector<WorkerEntry>& workerTable()
+{
+    static const std::vector<WorkerEntry> table = {
+        {TypeTag::BASIC_WORKER, WORKER_BASIC,
+         Course::ConstResourceMaps::BW_RECRUITMENT_COST,
+         BW_WORKER_EFFICIENCY, &makeBasicWorker},
+        {TypeTag::FARMER, WORKER_FARMER,
+         FARMER_RECRUITMENT_COST, FARMER_EFFICIENCY, &makeWorker<Farmer>},
+        {TypeTag::MINER, WORKER_MINER,
+         MINER_RECRUITMENT_COST, MINER_EFFICIENCY, &makeWorker<Miner>}
+    };
+    return table;
+}
+
+/**
+ * @brief Builds a tag indexed lookup over a table
+ */
+template<typename Entry>
+std::array<const Entry*, TAG_COUNT> indexByTag(
+        const std::vector<Entry>& table)
+{
+    std::array<const Entry*, TAG_COUNT> index;
+    index.fill(nullptr);
+    for(const Entry& entry : table){
+        index[static_cast<unsigned int>(entry.tag)] = &entry;
+    }
+    return index;
+}
+
+}
+
+TagMask BuildingEntry::placement() const
+{
+    return typeTraits(tag).placement;
+}
+
+const BuildingEntry *ObjectRegistry::building(TypeTag tag)
+{
+    static const std::array<const BuildingEntry*, TAG_COUNT> index =
+            indexByTag(buildingTable());
+
+    if(tag >= TypeTag::COUNT){
+        return nullptr;
+    }
+    return index[static_cast<unsigned int>(tag)];
+}
+
+const WorkerEntry *ObjectRegistry::worker(TypeTag tag)
+{
+    static const std::array<const WorkerEntry*, TAG_COUNT> index =
+            indexByTag(workerTable());
+
+    if(tag >= TypeTag::COUNT){
+        return nullptr;
+    }
+    return index[static_cast<unsigned int>(tag)];
+}
+
+const BuildingEntry *ObjectRegistry::findBuilding(const QString &name)
+{
+    for(const BuildingEntry& entry : buildingTable()){
+        if(entry.name == name){
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const WorkerEntry *ObjectRegistry::findWorker(const QString &name)
+{
+    for(const WorkerEntry& entry : workerTable()){
+        if(entry.name == name){
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+const std::vector<BuildingEntry> &ObjectRegistry::buildings()
+{
+    return buildingTable();
+}
+
+const std::vector<WorkerEntry> &ObjectRegistry::workers()
+{
+    return workerTable();
+}
+
+}
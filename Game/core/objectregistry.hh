@@ -0,0 +1,122 @@
+#ifndef OBJECTREGISTRY_HH
+#define OBJECTREGISTRY_HH
+
+#include "core/basicresources.h"
+#include "core/typetags.hh"
+#include "buildings/buildingbase.h"
+#include "workers/workerbase.h"
+#include "interfaces/gameeventhandler.hh"
+#include "interfaces/objectmanager.hh"
+#include "core/player.hh"
+
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+namespace Game {
+
+using BuildingFactory = std::shared_ptr<Course::BuildingBase>(*)(
+    const std::shared_ptr<GameEventHandler>&,
+    const std::shared_ptr<ObjectManager>&,
+    const std::shared_ptr<Player>&);
+
+using WorkerFactory = std::shared_ptr<Course::WorkerBase>(*)(
+    const std::shared_ptr<GameEventHandler>&,
+    const std::shared_ptr<ObjectManager>&,
+    const std::shared_ptr<Player>&);
+
+/**
+ * @brief Everything the game needs to know about a building type
+ */
+struct BuildingEntry
+{
+    TypeTag tag;
+    // Name shown in the UI and stored in action logs, see constants.hh
+    QString name;
+    Course::ResourceMap cost;
+    Course::ResourceMap production;
+    // Image drawn on the tile and in the build panel
+    QString image;
+    BuildingFactory create;
+
+    /**
+     * @brief Gets the tiles the building can be placed on
+     * @return Mask of tile tags, see TYPE_TRAITS
+     */
+    TagMask placement() const;
+};
+
+/**
+ * @brief Everything the game needs to know about a worker type
+ */
+struct WorkerEntry
+{
+    TypeTag tag;
+    // Name shown in the UI and stored in action logs, see constants.hh
+    QString name;
+    Course::ResourceMap cost;
+    Course::ResourceMapDouble efficiency;
+    WorkerFactory create;
+};
+
+/**
+ * @brief The ObjectRegistry class holds one entry per building and worker
+ * type. Entries are indexed by TypeTag so a lookup is an array access.
+ * Names are resolved to entries once where they enter the game (UI,
+ * action logs, snapshots), everything after that works with the entry.
+ *
+ * Adding a building or worker type means adding its TypeTag and traits
+ * and one line to the table in objectregistry.cpp.
+ */
+class ObjectRegistry
+{
+public:
+    /**
+     * @brief Gets the entry of a building type
+     * @param tag - Building tag
+     * @post Exception guarantee: No-throw
+     * @return Entry or nullptr if the tag is not a registered building
+     */
+    static const BuildingEntry* building(TypeTag tag);
+
+    /**
+     * @brief Gets the entry of a worker type
+     * @param tag - Worker tag
+     * @post Exception guarantee: No-throw
+     * @return Entry or nullptr if the tag is not a registered worker
+     */
+    static const WorkerEntry* worker(TypeTag tag);
+
+    /**
+     * @brief Finds a building type by its UI name
+     * @param name - Building name, see constants.hh
+     * @post Exception guarantee: No-throw
+     * @return Entry or nullptr if no building has the name
+     */
+    static const BuildingEntry* findBuilding(const QString& name);
+
+    /**
+     * @brief Finds a worker type by its UI name
+     * @param name - Worker name, see constants.hh
+     * @post Exception guarantee: No-throw
+     * @return Entry or nullptr if no worker has the name
+     */
+    static const WorkerEntry* findWorker(const QString& name);
+
+    /**
+     * @brief Gets every building type in the order they are listed in UI
+     * @post Exception guarantee: No-throw
+     */
+    static const std::vector<BuildingEntry>& buildings();
+
+    /**
+     * @brief Gets every worker type in the order they are listed in UI
+     * @post Exception guarantee: No-throw
+     */
+    static const std::vector<WorkerEntry>& workers();
+};
+
+}
+
+#endif // OBJECTREGISTRY_HH
@@ -1,19 +1,21 @@
 #include "perlinnoise.hh"
-#include <iostream>
+#include "core/profiler.hh"
 
 namespace Game {
 
 
 PerlinNoise::PerlinNoise(unsigned int width, unsigned int height, unsigned int seed)
 {
+    PV_PROFILE_SCOPE("perlinNoise");
+
     outputWidth_ = width;
     outputHeight_ = height;
 
-    srand(seed);
+    std::mt19937 random(seed);
 
     // Fill noiseSeed_ with random 0..1 and perlinNoise_ with zeros
     for(unsigned int i=0; i<outputWidth_*outputHeight_; i++){
-        noiseSeed_.push_back((float)rand() / (float)RAND_MAX);
+        noiseSeed_.push_back((float)random() / (float)random.max());
         perlinNoise_.push_back(0);
     }
 
@@ -81,9 +83,6 @@ void PerlinNoise::normaliseNoise()
         }
     }
 
-	//std::cout << "Noise max: " + std::to_string(noiseMax) << std::endl;
-	//std::cout << "Noise min: " + std::to_string(noiseMin) << std::endl;
-
     // Centralise noise based on min and max
     for(long unsigned int i=0; i<perlinNoise_.size(); i++){
         perlinNoise_.at(i) = (perlinNoise_.at(i)-noiseMin) / (noiseMax-noiseMin);
@@ -101,9 +100,6 @@ void PerlinNoise::normaliseNoise()
             if(n > noiseMax){noiseMax = n;}
         }
     }
-
-	//std::cout << "Noise max: " + std::to_string(noiseMax) << std::endl;
-	//std::cout << "Noise min: " + std::to_string(noiseMin) << std::endl;
 }
 
 void PerlinNoise::smoothSquare(int range)
@@ -130,7 +126,6 @@ void PerlinNoise::smoothSquare(int range)
                 sum += perlinNoise_.at(index);
             }
         }
-        //std::cout << sum/((2*range+1)*(2*range+1)) << std::endl;
         tempNoise.push_back(sum/((2*range+1)*(2*range+1)));
     }
 
@@ -0,0 +1,191 @@
+#include "productionforecast.hh"
+#include "constants/resourcemaps2.h"
+#include "core/scoreledger.hh"
+#include "core/profiler.hh"
+
+namespace Game {
+
+ProductionForecast::ProductionForecast(
+        const std::shared_ptr<ObjectManager> &objectmanager) :
+    objectmanager_(objectmanager)
+{
+}
+
+void ProductionForecast::setPlayers(
+        const std::vector<std::shared_ptr<Player> > &players)
+{
+    players_ = players;
+    entries_.clear();
+    plannedWorkers_.clear();
+    workerCounts_.clear();
+    limits_.clear();
+    planned_.clear();
+}
+
+const Course::ResourceMap &ProductionForecast::getProduction(
+        const std::shared_ptr<Course::TileBase> &tile)
+{
+    updatePlan();
+    return entryFor(tile).production;
+}
+
+std::vector<int> ProductionForecast::getValues()
+{
+    std::pair<int, int> size = objectmanager_->getMapSize();
+    std::vector<int> values(size.first * size.second, 0);
+    updatePlan();
+
+    for(const std::shared_ptr<Course::TileBase>& tile :
+        objectmanager_->getActiveTiles()){
+        const Course::Coordinate& coordinate = tile->getCoordinate();
+        values.at(coordinate.y() * size.first + coordinate.x()) =
+                entryFor(tile).value;
+    }
+    return values;
+}
+
+std::vector<Course::ResourceMap> ProductionForecast::getActiveProductions()
+{
+    const auto& activeTiles = objectmanager_->getActiveTiles();
+    std::vector<Course::ResourceMap> productions;
+    productions.reserve(activeTiles.size());
+    updatePlan();
+
+    for(const std::shared_ptr<Course::TileBase>& tile : activeTiles){
+        productions.push_back(entryFor(tile).production);
+    }
+    return productions;
+}
+
+unsigned int ProductionForecast::getCalculationCount() const
+{
+    return calculations_;
+}
+
+unsigned int ProductionForecast::getPlanCount() const
+{
+    return plans_;
+}
+
+void ProductionForecast::updatePlan()
+{
+    const std::vector<std::shared_ptr<Course::WorkerBase>>& workers =
+            objectmanager_->getWorkers();
+
+    bool changed = workers.size() != plannedWorkers_.size() ||
+            workerCounts_.size() != players_.size();
+    for(unsigned int i=0; !changed && i<workers.size(); i++){
+        changed = workers.at(i)->ID != plannedWorkers_.at(i);
+    }
+    if(changed){
+        plannedWorkers_.clear();
+        workerCounts_.assign(players_.size(), 0);
+        limits_.clear();
+        for(const std::shared_ptr<Course::WorkerBase>& worker : workers){
+            plannedWorkers_.push_back(worker->ID);
+            for(unsigned int i=0; i<players_.size(); i++){
+                if(players_.at(i) == worker->getOwner()){
+                    workerCounts_.at(i)++;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Resources matter only when they feed or pay another amount of workers
+    limits_.resize(players_.size(), std::make_pair(-1, -1));
+    for(unsigned int i=0; i<players_.size(); i++){
+        std::pair<int, int> limits = upkeepLimits(
+                    *players_.at(i)->getResourceMap(), workerCounts_.at(i));
+        if(limits != limits_.at(i)){
+            limits_.at(i) = limits;
+            changed = true;
+        }
+    }
+    if(!changed){
+        return;
+    }
+
+    PV_PROFILE_COUNT("ProductionForecast::plan", 1);
+    UpkeepPlan plan = planUpkeep(players_, workers);
+    planned_.clear();
+    planned_.reserve(workers.size());
+    for(unsigned int i=0; i<workers.size(); i++){
+        planned_[workers.at(i).get()] = plan.satisfaction.at(i);
+    }
+    plans_++;
+}
+
+Satisfaction ProductionForecast::plannedFor(
+        const Course::WorkerBase *worker) const
+{
+    auto found = planned_.find(worker);
+    return found != planned_.end() ? found->second : Satisfaction::HUNGRY;
+}
+
+ProductionForecast::Entry &ProductionForecast::entryFor(
+        const std::shared_ptr<Course::TileBase> &tile)
+{
+    std::pair<int, int> size = objectmanager_->getMapSize();
+    unsigned int tileCount = size.first * size.second;
+    if(entries_.size() != tileCount){
+        entries_.assign(tileCount, Entry());
+    }
+
+    const Course::Coordinate& coordinate = tile->getCoordinate();
+    Entry& entry = entries_.at(coordinate.y() * size.first + coordinate.x());
+
+    quint64 revision = objectmanager_->getTileRevision(coordinate);
+    if(entry.revision == revision && entry.plan == plans_){
+        return entry;
+    }
+
+    // A new plan may still give these workers the same satisfaction
+    std::vector<std::shared_ptr<Course::WorkerBase>> workers =
+            tile->getWorkers();
+    bool same = entry.revision == revision &&
+            entry.satisfaction.size() == workers.size();
+    for(unsigned int i=0; same && i<workers.size(); i++){
+        same = entry.satisfaction.at(i) == plannedFor(workers.at(i).get());
+    }
+    entry.plan = plans_;
+    if(same){
+        return entry;
+    }
+
+    PV_PROFILE_COUNT("ProductionForecast::calculate", 1);
+    calculations_++;
+    entry.revision = revision;
+    entry.satisfaction.clear();
+    for(const std::shared_ptr<Course::WorkerBase>& worker : workers){
+        entry.satisfaction.push_back(plannedFor(worker.get()));
+    }
+    entry.production = calculate(tile, entry.satisfaction);
+    entry.value = ScoreLedger::resourceValue(entry.production);
+    return entry;
+}
+
+Course::ResourceMap ProductionForecast::calculate(
+        const std::shared_ptr<Course::TileBase> &tile,
+        const std::vector<Satisfaction>& satisfaction)
+{
+    Course::ResourceMapDouble efficiency = RESOURCEMAP_ZERO_DOUBLE;
+    std::vector<std::shared_ptr<Course::WorkerBase>> workers =
+            tile->getWorkers();
+    for(unsigned int i=0; i<workers.size(); i++){
+        efficiency = Course::mergeResourceMapDoubles(
+                    efficiency, workers.at(i)->workEfficiency(
+                        satisfactionValue(satisfaction.at(i))));
+    }
+
+    Course::ResourceMap production =
+            Course::multiplyResourceMap(tile->BASE_PRODUCTION, efficiency);
+    for(const std::shared_ptr<Course::BuildingBase>& building :
+        tile->getBuildings()){
+        production = Course::mergeResourceMaps(
+                    production, building->getNextProduction());
+    }
+    return production;
+}
+
+}
@@ -0,0 +1,144 @@
+#ifndef PRODUCTIONFORECAST_HH
+#define PRODUCTIONFORECAST_HH
+
+#include "core/player.hh"
+#include "core/resourcemaps.h"
+#include "core/upkeep.hh"
+#include "interfaces/objectmanager.hh"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief The ProductionForecast class tells what tiles will produce at the
+ * end of the turn without touching the players or the buildings.
+ *
+ * Forecasts are cached per tile. A forecast is calculated again only when
+ * the revision of the tile in the ObjectManager changes or when the upkeep
+ * the players can afford now gives the workers on the tile another
+ * satisfaction, see planUpkeep. The upkeep itself is planned again only
+ * when the workers change or a player can feed or pay another amount of
+ * them, see upkeepLimits.
+ */
+class ProductionForecast
+{
+public:
+    /**
+     * @brief Constructor for the class
+     * @param objectmanager - Object manager that has the tiles and workers
+     */
+    explicit ProductionForecast(
+            const std::shared_ptr<ObjectManager>& objectmanager);
+
+    /**
+     * @brief Sets the players whose upkeep is planned and forgets all
+     * forecasts
+     * @param players - Players in turn order
+     * @post Exception guarantee: Basic
+     */
+    void setPlayers(const std::vector<std::shared_ptr<Player>>& players);
+
+    /**
+     * @brief Gets the production of a tile for the next turn
+     * @param tile - Any tile of the object manager
+     * @post Exception guarantee: Basic
+     * @return Forecast, valid until the next call
+     */
+    const Course::ResourceMap& getProduction(
+            const std::shared_ptr<Course::TileBase>& tile);
+
+    /**
+     * @brief Gets the value of the next production of every tile
+     * @post Exception guarantee: Basic
+     * @return Values row by row, see ScoreLedger::resourceValue. Tiles
+     * without buildings and workers are 0.
+     */
+    std::vector<int> getValues();
+
+    /**
+     * @brief Gets the next production of every tile with buildings or
+     * workers
+     * @post Exception guarantee: Basic
+     * @return Forecasts in the order of ObjectManager::getActiveTiles
+     */
+    std::vector<Course::ResourceMap> getActiveProductions();
+
+    /**
+     * @brief Gets how many forecasts have been calculated since creation
+     * @post Exception guarantee: No-throw
+     */
+    unsigned int getCalculationCount() const;
+
+    /**
+     * @brief Gets how many times the upkeep has been planned since creation
+     * @post Exception guarantee: No-throw
+     */
+    unsigned int getPlanCount() const;
+
+private:
+    using WorkerSatisfaction =
+            std::unordered_map<const Course::WorkerBase*, Satisfaction>;
+
+    struct Entry
+    {
+        // 0 is never a tile revision
+        quint64 revision = 0;
+        // Upkeep plan the satisfaction was checked against
+        unsigned int plan = 0;
+        // Satisfaction of the workers of the tile in tile order
+        std::vector<Satisfaction> satisfaction;
+        int value = 0;
+        Course::ResourceMap production;
+    };
+
+    /**
+     * @brief Plans the upkeep of all workers for the next turn if the
+     * workers or the upkeep limits of a player have changed
+     */
+    void updatePlan();
+
+    /**
+     * @brief Gets the planned satisfaction of a worker
+     * @return HUNGRY for workers not in the plan
+     */
+    Satisfaction plannedFor(const Course::WorkerBase* worker) const;
+
+    /**
+     * @brief Gets the cached entry of a tile, calculating it if needed
+     * @pre updatePlan has been called
+     */
+    Entry& entryFor(const std::shared_ptr<Course::TileBase>& tile);
+
+    /**
+     * @brief Calculates the production of a tile
+     * @param satisfaction - Satisfaction of the workers in tile order
+     */
+    static Course::ResourceMap calculate(
+            const std::shared_ptr<Course::TileBase>& tile,
+            const std::vector<Satisfaction>& satisfaction);
+
+    std::shared_ptr<ObjectManager> objectmanager_;
+    std::vector<std::shared_ptr<Player>> players_;
+    // Row by row like the ObjectManager rasters
+    std::vector<Entry> entries_;
+    unsigned int calculations_ = 0;
+
+    // IDs of the workers the plan was made for in recruitment order.
+    // Pooled workers can reuse the address of a removed one, IDs are not
+    // reused.
+    std::vector<Course::ObjectId> plannedWorkers_;
+    // Amount of plannedWorkers_ of each player
+    std::vector<int> workerCounts_;
+    // upkeepLimits of each player when planned
+    std::vector<std::pair<int, int>> limits_;
+    WorkerSatisfaction planned_;
+    // Number of the current plan, 0 is before the first one
+    unsigned int plans_ = 0;
+};
+
+}
+
+#endif // PRODUCTIONFORECAST_HH
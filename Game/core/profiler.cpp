@@ -0,0 +1,214 @@
+#include "profiler.hh"
+
+#include <QFile>
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+namespace Game {
+
+namespace {
+
+// Small ids for the trace instead of std::thread::id
+std::atomic<unsigned int> nextThread{1};
+thread_local unsigned int currentThread = 0;
+thread_local int currentTurn = 0;
+
+unsigned int threadId()
+{
+    if(currentThread == 0){
+        currentThread = nextThread.fetch_add(1);
+    }
+    return currentThread;
+}
+
+std::string escaped(const char* text)
+{
+    std::string result;
+    for(const char* c = text; *c != 0; c++){
+        if(*c == '"' || *c == '\\'){
+            result += '\\';
+        }
+        result += *c;
+    }
+    return result;
+}
+
+bool writeFile(const QString& path, const std::string& data)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        return false;
+    }
+    return file.write(data.data(), data.size()) ==
+            static_cast<qint64>(data.size());
+}
+
+/**
+ * @brief Sums entries whose names are equal strings in different
+ * translation units
+ */
+std::map<std::pair<int, std::string>, std::pair<qint64, qint64>> byName(
+        const std::map<std::pair<int, const char*>, std::pair<qint64, qint64>>&
+        entries)
+{
+    std::map<std::pair<int, std::string>, std::pair<qint64, qint64>> merged;
+    for(const auto& entry : entries){
+        auto& sum = merged[std::make_pair(entry.first.first,
+                                          std::string(entry.first.second))];
+        sum.first += entry.second.first;
+        sum.second += entry.second.second;
+    }
+    return merged;
+}
+
+}
+
+Profiler &Profiler::getInstance()
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() :
+    epoch_(std::chrono::steady_clock::now())
+{
+}
+
+qint64 Profiler::now() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - epoch_).count();
+}
+
+void Profiler::addEvent(const char *name, qint64 start, qint64 duration)
+{
+    unsigned int thread = threadId();
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Totals& totals = timers_[std::make_pair(currentTurn, name)];
+    totals.calls++;
+    totals.total += duration;
+
+    if(events_.size() < MAX_EVENTS){
+        events_.push_back({name, start, duration, thread, currentTurn});
+    }
+}
+
+void Profiler::count(const char *name, qint64 amount)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    counters_[std::make_pair(currentTurn, name)].total += amount;
+}
+
+void Profiler::setTurn(int turn)
+{
+    currentTurn = turn;
+}
+
+void Profiler::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_.clear();
+    timers_.clear();
+    counters_.clear();
+}
+
+unsigned int Profiler::getEventCount()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return events_.size();
+}
+
+qint64 Profiler::getTotal(int turn, const char *name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    qint64 total = 0;
+    for(const auto& entry : timers_){
+        if(entry.first.first == turn &&
+                std::string(entry.first.second) == name){
+            total += entry.second.total;
+        }
+    }
+    return total;
+}
+
+bool Profiler::writeChromeTrace(const QString &path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::ostringstream json;
+    json << "{\"traceEvents\":[";
+    bool first = true;
+    for(const ProfileEvent& event : events_){
+        json << (first ? "\n" : ",\n");
+        first = false;
+        json << "{\"name\":\"" << escaped(event.name)
+             << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+             << ",\"ts\":" << event.start << ",\"dur\":" << event.duration
+             << ",\"args\":{\"turn\":" << event.turn << "}}";
+    }
+
+    // Counters as one sample per turn, turn number as the time
+    for(const auto& counter : counters_){
+        json << (first ? "\n" : ",\n");
+        first = false;
+        json << "{\"name\":\"" << escaped(counter.first.second)
+             << "\",\"ph\":\"C\",\"pid\":2,\"ts\":" << counter.first.first
+             << ",\"args\":{\"value\":" << counter.second.total << "}}";
+    }
+    json << "\n]}\n";
+
+    return writeFile(path, json.str());
+}
+
+bool Profiler::writeTurnSummary(const QString &path)
+{
+    std::map<std::pair<int, const char*>, std::pair<qint64, qint64>> timers;
+    std::map<std::pair<int, const char*>, std::pair<qint64, qint64>> counters;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for(const auto& entry : timers_){
+            timers[entry.first] = std::make_pair(entry.second.calls,
+                                                 entry.second.total);
+        }
+        for(const auto& entry : counters_){
+            counters[entry.first] = std::make_pair(0, entry.second.total);
+        }
+    }
+
+    std::ostringstream csv;
+    csv << "turn,name,calls,total_us\n";
+    for(const auto& entry : byName(timers)){
+        csv << entry.first.first << "," << entry.first.second << ","
+            << entry.second.first << "," << entry.second.second << "\n";
+    }
+    for(const auto& entry : byName(counters)){
+        csv << entry.first.first << "," << entry.first.second << ",,"
+            << entry.second.second << "\n";
+    }
+
+    return writeFile(path, csv.str());
+}
+
+bool Profiler::writeFiles(const QString &prefix)
+{
+    bool trace = writeChromeTrace(prefix + ".trace.json");
+    bool summary = writeTurnSummary(prefix + ".turns.csv");
+    return trace && summary;
+}
+
+ScopedTimer::ScopedTimer(const char *name) :
+    name_(name),
+    start_(Profiler::getInstance().now())
+{
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    Profiler& profiler = Profiler::getInstance();
+    profiler.addEvent(name_, start_, profiler.now() - start_);
+}
+
+}
@@ -0,0 +1,177 @@
+#ifndef PROFILER_HH
+#define PROFILER_HH
+
+#include <QString>
+#include <QtGlobal>
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief One finished scoped timer
+ */
+struct ProfileEvent
+{
+    const char* name;
+    // Microseconds since the profiler was created
+    qint64 start;
+    qint64 duration;
+    unsigned int thread;
+    int turn;
+};
+
+/**
+ * @brief The Profiler class collects scoped timers and counters of the
+ * hot paths and writes them as a Chrome trace (chrome://tracing or
+ * Perfetto) and as a per turn summary.
+ *
+ * Use it through the PV_PROFILE_ macros below. They compile to nothing
+ * unless PV_PROFILING is defined, with qmake: CONFIG+=profiling
+ * @code
+ * void GameManager::doTurn()
+ * {
+ *     PV_PROFILE_SCOPE("doTurn");
+ *     PV_PROFILE_COUNT("activeTiles", tiles.size());
+ * }
+ * @endcode
+ * Names must be string literals, they are stored as pointers.
+ */
+class Profiler
+{
+public:
+    /**
+     * @brief Gets the process wide profiler
+     */
+    static Profiler& getInstance();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /**
+     * @brief Gets the time used by the events
+     * @return Microseconds since the profiler was created
+     */
+    qint64 now() const;
+
+    /**
+     * @brief Stores a finished timer
+     * @param name - Timer name
+     * @param start - Start time from now()
+     * @param duration - Length in microseconds
+     * @note Thread safe
+     */
+    void addEvent(const char* name, qint64 start, qint64 duration);
+
+    /**
+     * @brief Adds to a counter of the current turn
+     * @param name - Counter name
+     * @param amount - Added amount
+     * @note Thread safe
+     */
+    void count(const char* name, qint64 amount);
+
+    /**
+     * @brief Sets the turn the calling thread is working on. Timers and
+     * counters are summed per turn.
+     * @param turn - Turn number
+     */
+    void setTurn(int turn);
+
+    /**
+     * @brief Drops everything recorded so far
+     */
+    void clear();
+
+    /**
+     * @brief Gets the amount of events kept for the trace
+     */
+    unsigned int getEventCount();
+
+    /**
+     * @brief Gets the summed time of a timer during a turn
+     * @return Microseconds, 0 if the timer didn't run on that turn
+     */
+    qint64 getTotal(int turn, const char* name);
+
+    /**
+     * @brief Writes the events in the Chrome trace event format
+     * @param path - File to write
+     * @return True if the whole file was written
+     */
+    bool writeChromeTrace(const QString& path);
+
+    /**
+     * @brief Writes the per turn sums as CSV: turn,name,calls,total_us.
+     * Counters have the counted amount as total and no calls.
+     * @param path - File to write
+     * @return True if the whole file was written
+     */
+    bool writeTurnSummary(const QString& path);
+
+    /**
+     * @brief Writes both files, prefix.trace.json and prefix.turns.csv
+     * @return True if both were written
+     */
+    bool writeFiles(const QString& prefix);
+
+private:
+    Profiler();
+
+    struct Totals
+    {
+        qint64 calls = 0;
+        qint64 total = 0;
+    };
+
+    // Events kept for the trace, the sums are updated after this too
+    static const std::size_t MAX_EVENTS = 1000000;
+
+    const std::chrono::steady_clock::time_point epoch_;
+
+    std::mutex mutex_;
+    std::vector<ProfileEvent> events_;
+    // Keyed by turn and name. Counters have no calls.
+    std::map<std::pair<int, const char*>, Totals> timers_;
+    std::map<std::pair<int, const char*>, Totals> counters_;
+};
+
+/**
+ * @brief The ScopedTimer class times its own lifetime to the Profiler
+ */
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const char* name);
+    ~ScopedTimer();
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* name_;
+    qint64 start_;
+};
+
+}
+
+#ifdef PV_PROFILING
+#define PV_PROFILE_CONCAT_(a, b) a##b
+#define PV_PROFILE_CONCAT(a, b) PV_PROFILE_CONCAT_(a, b)
+#define PV_PROFILE_SCOPE(name) \
+    ::Game::ScopedTimer PV_PROFILE_CONCAT(pvProfileTimer, __LINE__)(name)
+#define PV_PROFILE_COUNT(name, amount) \
+    ::Game::Profiler::getInstance().count(name, amount)
+#define PV_PROFILE_TURN(turn) \
+    ::Game::Profiler::getInstance().setTurn(turn)
+#else
+#define PV_PROFILE_SCOPE(name) ((void)0)
+#define PV_PROFILE_COUNT(name, amount) ((void)0)
+#define PV_PROFILE_TURN(turn) ((void)0)
+#endif
+
+#endif // PROFILER_HH
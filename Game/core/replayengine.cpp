@@ -0,0 +1,117 @@
+#include "replayengine.hh"
+
+#include <exception>
+#include <sstream>
+
+namespace Game {
+
+ReplayEngine::ReplayEngine(const ActionLog &log) :
+    log_(log)
+{
+}
+
+ReplayResult ReplayEngine::run(bool stopOnDivergence)
+{
+    ReplayResult result;
+
+    std::shared_ptr<GameEventHandler> geh =
+            std::make_shared<GameEventHandler>();
+    std::shared_ptr<ObjectManager> om = std::make_shared<ObjectManager>();
+    gameManager_ = std::make_shared<GameManager>(geh, om, nullptr, nullptr);
+
+    for(const auto& player : log_.getPlayers()){
+        gameManager_->addPlayer(player);
+    }
+    gameManager_->setTurnCount(log_.getTurnCount());
+    gameManager_->setMapSize(log_.getMapWidth(), log_.getMapHeight());
+    gameManager_->setSeed(log_.getSeed());
+
+    bool started = false;
+    try{
+        started = gameManager_->startGame();
+    }
+    catch(const std::exception&){
+        // Settings of a malformed log, such as a huge map
+    }
+    if(!started){
+        result.matches = false;
+        result.divergenceIndex = 0;
+        result.message = "Game could not be started";
+        return result;
+    }
+
+    const std::vector<GameAction>& actions = log_.getActions();
+    const std::vector<TurnChecksum>& expected = log_.getChecksums();
+
+    for(unsigned int i=0; i<actions.size(); i++){
+        const GameAction& action = actions.at(i);
+        TurnChecksum checksum = {gameManager_->getCurrentTurnNumber(),
+                                 gameManager_->getCurrentPlayerIndex(), 0};
+
+        bool rejected = false;
+        std::string error;
+        try{
+            apply(action);
+        }
+        catch(const Course::BaseException& e){
+            rejected = true;
+            error = e.msg();
+        }
+        catch(const std::exception& e){
+            // Malformed entries may fail outside the game rules
+            rejected = true;
+            error = e.what();
+        }
+
+        if(rejected){
+            if(result.matches){
+                result.matches = false;
+                result.divergenceIndex = i;
+                std::ostringstream message;
+                message << "Action " << i << " rejected on turn "
+                        << checksum.turn << ": " << error;
+                result.message = message.str();
+            }
+            if(stopOnDivergence){
+                return result;
+            }
+        }
+
+        if(action.type != ActionType::END_TURN){
+            continue;
+        }
+
+        checksum.hash = gameManager_->getStateHash();
+        unsigned int turnIndex = result.checksums.size();
+        result.checksums.push_back(checksum);
+
+        if(turnIndex < expected.size() &&
+                expected.at(turnIndex).hash != checksum.hash &&
+                result.matches){
+            result.matches = false;
+            result.divergenceIndex = i;
+            std::ostringstream message;
+            message << "State differs after turn " << checksum.turn
+                    << " of player " << checksum.playerIndex + 1;
+            result.message = message.str();
+
+            if(stopOnDivergence){
+                return result;
+            }
+        }
+    }
+
+    return result;
+}
+
+std::shared_ptr<GameManager> ReplayEngine::getGameManager()
+{
+    return gameManager_;
+}
+
+void ReplayEngine::apply(const GameAction &action)
+{
+    gameManager_->applyAction(action);
+}
+
+}
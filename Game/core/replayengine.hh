@@ -0,0 +1,70 @@
+#ifndef REPLAYENGINE_HH
+#define REPLAYENGINE_HH
+
+#include "core/actionlog.hh"
+#include "core/gamemanager.hh"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Result of a replay
+ */
+struct ReplayResult
+{
+    // False if an action was rejected or a checksum didn't match
+    bool matches = true;
+    // Index of the first action that was rejected or ended a turn with
+    // a different state, -1 if none
+    int divergenceIndex = -1;
+    // Description of the first divergence
+    std::string message;
+    // State hash after every ended turn
+    std::vector<TurnChecksum> checksums;
+};
+
+/**
+ * @brief The ReplayEngine class plays a logged game again without graphics
+ * and compares the state after every turn to the checksums in the log.
+ * The first turn whose state differs is reported.
+ */
+class ReplayEngine
+{
+public:
+    /**
+     * @brief Constructor for the class
+     * @param log - Log to replay
+     */
+    explicit ReplayEngine(const ActionLog& log);
+
+    /**
+     * @brief Plays the whole log
+     * @param stopOnDivergence - Stop at the first difference
+     * @post Exception guarantee: No-throw
+     * @return Per turn checksums and the first divergence
+     */
+    ReplayResult run(bool stopOnDivergence = true);
+
+    /**
+     * @brief Gets the game manager of the last run
+     * @return GameManager or nullptr if not run yet
+     */
+    std::shared_ptr<GameManager> getGameManager();
+
+private:
+    /**
+     * @brief Applies one action to the game
+     * @exceptions Any exception the GameManager throws for the action
+     */
+    void apply(const GameAction& action);
+
+    const ActionLog& log_;
+    std::shared_ptr<GameManager> gameManager_ = nullptr;
+};
+
+}
+
+#endif // REPLAYENGINE_HH
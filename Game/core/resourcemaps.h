@@ -8,6 +8,7 @@ namespace Course {
 namespace ConstResourceMaps {
 
 const ResourceMap EMPTY = {};
+const ResourceMapDouble EMPTY_DOUBLE = {};
 
 // Building - Farm
 const ResourceMap FARM_BUILD_COST = {
@@ -0,0 +1,91 @@
+#include "scoreledger.hh"
+#include "constants/constants.hh"
+#include "constants/resourcemaps2.h"
+
+#include <algorithm>
+
+namespace Game {
+
+ScoreLedger::ScoreLedger(const std::shared_ptr<ObjectManager> &objectmanager) :
+    objectmanager_(objectmanager)
+{
+}
+
+void ScoreLedger::setPlayers(const std::vector<std::shared_ptr<Player> > &players)
+{
+    players_ = players;
+    assets_.assign(players_.size(), 0);
+}
+
+void ScoreLedger::addAsset(const std::shared_ptr<Course::PlayerBase> &owner,
+                           const Course::ResourceMap &cost)
+{
+    int index = indexOf(owner);
+    if(index >= 0){
+        assets_.at(index) += resourceValue(cost);
+    }
+}
+
+void ScoreLedger::removeAsset(const std::shared_ptr<Course::PlayerBase> &owner,
+                              const Course::ResourceMap &cost)
+{
+    int index = indexOf(owner);
+    if(index >= 0){
+        assets_.at(index) -= resourceValue(cost);
+    }
+}
+
+int ScoreLedger::getScore(unsigned int index) const
+{
+    const std::shared_ptr<Player>& player = players_.at(index);
+    int score = resourceValue(*player->getResourceMap()) + assets_.at(index);
+    if(objectmanager_ != nullptr){
+        score += CLAIM_SCORE *
+                static_cast<int>(objectmanager_->getTerritorySize(player));
+    }
+    return score;
+}
+
+std::vector<ScoreEntry> ScoreLedger::getScores() const
+{
+    std::vector<ScoreEntry> scores;
+    scores.reserve(players_.size());
+    for(unsigned int i=0; i<players_.size(); i++){
+        scores.push_back({players_.at(i)->getName(), getScore(i)});
+    }
+    return scores;
+}
+
+std::vector<ScoreEntry> ScoreLedger::getLeaderboard() const
+{
+    std::vector<ScoreEntry> scores = getScores();
+    std::stable_sort(scores.begin(), scores.end(),
+                     [](const ScoreEntry& a, const ScoreEntry& b){
+        return a.score > b.score;
+    });
+    return scores;
+}
+
+int ScoreLedger::resourceValue(const Course::ResourceMap &resources)
+{
+    int value = 0;
+    for(const auto& resource : resources){
+        auto weight = RESOURCE_SCORE_WEIGHTS.find(resource.first);
+        if(weight != RESOURCE_SCORE_WEIGHTS.end()){
+            value += resource.second * weight->second;
+        }
+    }
+    return value;
+}
+
+int ScoreLedger::indexOf(const std::shared_ptr<Course::PlayerBase> &player) const
+{
+    for(unsigned int i=0; i<players_.size(); i++){
+        if(players_.at(i) == player){
+            return i;
+        }
+    }
+    return -1;
+}
+
+}
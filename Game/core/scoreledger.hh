@@ -0,0 +1,110 @@
+#ifndef SCORELEDGER_HH
+#define SCORELEDGER_HH
+
+#include "core/player.hh"
+#include "core/resourcemaps.h"
+#include "interfaces/objectmanager.hh"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Score of one player
+ */
+struct ScoreEntry
+{
+    std::string name;
+    int score;
+};
+
+/**
+ * @brief The ScoreLedger class keeps the scores of the players up to date
+ * while the game goes on, so reading them doesn't go through the map.
+ *
+ * A score is made of the resources of the player, the tiles it has claimed
+ * and the costs of its buildings and workers. Buildings and workers are
+ * booked when they are placed and removed. Resources and claimed tiles are
+ * read from the Player and the ObjectManager which keep them current.
+ */
+class ScoreLedger
+{
+public:
+    /**
+     * @brief Constructor for the class
+     * @param objectmanager - Object manager that counts the claimed tiles
+     */
+    explicit ScoreLedger(const std::shared_ptr<ObjectManager>& objectmanager);
+
+    /**
+     * @brief Sets the players and clears the booked buildings and workers
+     * @param players - Players in turn order
+     * @post Exception guarantee: Basic
+     */
+    void setPlayers(const std::vector<std::shared_ptr<Player>>& players);
+
+    /**
+     * @brief Books a building or a worker to its owner
+     * @param owner - Owner, objects of unknown players are ignored
+     * @param cost - Build or recruitment cost
+     * @post Exception guarantee: No-throw
+     */
+    void addAsset(const std::shared_ptr<Course::PlayerBase>& owner,
+                  const Course::ResourceMap& cost);
+
+    /**
+     * @brief Removes a building or a worker booked with addAsset
+     * @param owner - Owner, objects of unknown players are ignored
+     * @param cost - Same cost the object was booked with
+     * @post Exception guarantee: No-throw
+     */
+    void removeAsset(const std::shared_ptr<Course::PlayerBase>& owner,
+                     const Course::ResourceMap& cost);
+
+    /**
+     * @brief Gets the score of a player
+     * @param index - Turn order index of the player
+     * @post Exception guarantee: Strong
+     * @exceptions std::out_of_range - No player with the index
+     */
+    int getScore(unsigned int index) const;
+
+    /**
+     * @brief Gets the scores of all players
+     * @post Exception guarantee: Strong
+     * @return Scores in turn order
+     */
+    std::vector<ScoreEntry> getScores() const;
+
+    /**
+     * @brief Gets the scores of all players from best to worst
+     * @post Exception guarantee: Strong
+     * @return Scores, players with equal scores in turn order
+     */
+    std::vector<ScoreEntry> getLeaderboard() const;
+
+    /**
+     * @brief Calculates the score value of resources
+     * @param resources - Any resources
+     * @post Exception guarantee: No-throw
+     */
+    static int resourceValue(const Course::ResourceMap& resources);
+
+private:
+    /**
+     * @brief Finds the turn order index of a player
+     * @return Index or -1 if not one of the players
+     */
+    int indexOf(const std::shared_ptr<Course::PlayerBase>& player) const;
+
+    std::shared_ptr<ObjectManager> objectmanager_;
+    std::vector<std::shared_ptr<Player>> players_;
+    // Value of the buildings and workers of each player
+    std::vector<int> assets_;
+};
+
+}
+
+#endif // SCORELEDGER_HH
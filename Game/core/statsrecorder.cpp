@@ -0,0 +1,168 @@
+#include "statsrecorder.hh"
+
+#include <QFile>
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace Game {
+
+namespace {
+
+const char STATS_MAGIC[8] = {'P', 'V', 'S', 'T', 'A', 'T', 'S', 0};
+const quint32 STATS_ENDIAN_MARKER = 0x01020304;
+
+const std::array<const char*, STAT_COUNT> STAT_NAMES = {
+    "money", "food", "wood", "stone", "ore",
+    "territory", "buildings", "workers", "production", "score"
+};
+
+bool writeFile(const QString& path, const std::string& data)
+{
+    QFile file(path);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate)){
+        return false;
+    }
+    return file.write(data.data(), data.size()) ==
+            static_cast<qint64>(data.size());
+}
+
+}
+
+void StatsRecorder::start(const std::vector<std::shared_ptr<Player> > &players,
+                          int rounds)
+{
+    names_.clear();
+    colors_.clear();
+    for(const std::shared_ptr<Player>& player : players){
+        names_.push_back(player->getName());
+        colors_.push_back(player->getColor());
+    }
+
+    unsigned int reserved = rounds > 0 ? rounds : 0;
+    turns_.clear();
+    turns_.reserve(reserved);
+    for(std::vector<qint32>& column : columns_){
+        column.clear();
+        column.reserve(reserved * names_.size());
+    }
+}
+
+void StatsRecorder::beginRound(int turn)
+{
+    turns_.push_back(turn);
+    for(std::vector<qint32>& column : columns_){
+        column.resize(column.size() + names_.size(), 0);
+    }
+}
+
+void StatsRecorder::set(unsigned int player, Stat stat, qint32 value)
+{
+    std::vector<qint32>& column = columns_[static_cast<unsigned int>(stat)];
+    column[column.size() - names_.size() + player] = value;
+}
+
+qint32 StatsRecorder::get(Stat stat, unsigned int round,
+                          unsigned int player) const
+{
+    if(player >= names_.size()){
+        throw std::out_of_range("No such player");
+    }
+    return columns_.at(static_cast<unsigned int>(stat)).at(
+                round * names_.size() + player);
+}
+
+const std::vector<qint32> &StatsRecorder::getColumn(Stat stat) const
+{
+    return columns_[static_cast<unsigned int>(stat)];
+}
+
+int StatsRecorder::getTurn(unsigned int round) const
+{
+    return turns_.at(round);
+}
+
+unsigned int StatsRecorder::getPlayerCount() const
+{
+    return names_.size();
+}
+
+unsigned int StatsRecorder::getRoundCount() const
+{
+    return turns_.size();
+}
+
+const std::string &StatsRecorder::getPlayerName(unsigned int player) const
+{
+    return names_.at(player);
+}
+
+QColor StatsRecorder::getPlayerColor(unsigned int player) const
+{
+    return colors_.at(player);
+}
+
+bool StatsRecorder::exportCsv(const QString &path) const
+{
+    std::ostringstream csv;
+    csv << "turn,player";
+    for(const char* name : STAT_NAMES){
+        csv << "," << name;
+    }
+    csv << "\n";
+
+    for(unsigned int round=0; round<turns_.size(); round++){
+        for(unsigned int player=0; player<names_.size(); player++){
+            csv << turns_.at(round) << "," << names_.at(player);
+            for(const std::vector<qint32>& column : columns_){
+                csv << "," << column.at(round * names_.size() + player);
+            }
+            csv << "\n";
+        }
+    }
+
+    return writeFile(path, csv.str());
+}
+
+bool StatsRecorder::exportBinary(const QString &path) const
+{
+    StatsHeader header = {};
+    std::memcpy(header.magic, STATS_MAGIC, sizeof(header.magic));
+    header.version = STATS_VERSION;
+    header.endianMarker = STATS_ENDIAN_MARKER;
+    header.playerCount = names_.size();
+    header.roundCount = turns_.size();
+    header.statCount = STAT_COUNT;
+    header.playerOffset = sizeof(StatsHeader);
+    header.turnOffset = header.playerOffset +
+            names_.size() * sizeof(StatsPlayer);
+    header.columnOffset = header.turnOffset + turns_.size() * sizeof(qint32);
+
+    std::string data(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(unsigned int i=0; i<names_.size(); i++){
+        StatsPlayer record = {};
+        std::strncpy(record.name, names_.at(i).c_str(),
+                     sizeof(record.name) - 1);
+        record.rgba = colors_.at(i).rgba();
+        data.append(reinterpret_cast<const char*>(&record), sizeof(record));
+    }
+    data.append(reinterpret_cast<const char*>(turns_.data()),
+                turns_.size() * sizeof(qint32));
+    for(const std::vector<qint32>& column : columns_){
+        data.append(reinterpret_cast<const char*>(column.data()),
+                    column.size() * sizeof(qint32));
+    }
+
+    return writeFile(path, data);
+}
+
+const char *StatsRecorder::statName(Stat stat)
+{
+    if(stat >= Stat::COUNT){
+        return "";
+    }
+    return STAT_NAMES[static_cast<unsigned int>(stat)];
+}
+
+}
@@ -0,0 +1,179 @@
+#ifndef STATSRECORDER_HH
+#define STATSRECORDER_HH
+
+#include "core/player.hh"
+
+#include <QColor>
+#include <QString>
+#include <QtGlobal>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Values recorded for every player at the end of every round
+ */
+enum class Stat : unsigned int {
+    MONEY,
+    FOOD,
+    WOOD,
+    STONE,
+    ORE,
+    // Claimed tiles
+    TERRITORY,
+    BUILDINGS,
+    WORKERS,
+    // Resources the tiles produced during the round, all types summed
+    PRODUCTION,
+    SCORE,
+    COUNT
+};
+
+const unsigned int STAT_COUNT = static_cast<unsigned int>(Stat::COUNT);
+
+/**
+ * @brief Version of the binary statistics layout
+ */
+const quint32 STATS_VERSION = 1;
+
+/**
+ * @brief Binary file header. Offsets are in bytes from the beginning of
+ * the file. Turn numbers are roundCount qint32 values and the columns are
+ * statCount blocks of roundCount * playerCount qint32 values in Stat order,
+ * each round by round and the players in turn order.
+ */
+struct StatsHeader
+{
+    char magic[8];
+    quint32 version;
+    quint32 endianMarker;
+    quint32 playerCount;
+    quint32 roundCount;
+    quint32 statCount;
+    quint32 playerOffset;
+    quint32 turnOffset;
+    quint32 columnOffset;
+};
+
+/**
+ * @brief Player record of the binary file
+ */
+struct StatsPlayer
+{
+    char name[32];
+    quint32 rgba;
+};
+
+/**
+ * @brief The StatsRecorder class keeps per round statistics of a game in
+ * one column per Stat. Space for the whole game is reserved when it starts
+ * so recording a round only writes to the columns.
+ *
+ * GameManager records to it only when one is set, games without a recorder
+ * pay nothing.
+ */
+class StatsRecorder
+{
+public:
+    StatsRecorder() = default;
+
+    /**
+     * @brief Prepares for a new game, earlier rounds are dropped
+     * @param players - Players in turn order
+     * @param rounds - Rounds to reserve space for
+     * @post Exception guarantee: Basic
+     */
+    void start(const std::vector<std::shared_ptr<Player>>& players,
+               int rounds);
+
+    /**
+     * @brief Adds a round with every value zero. set writes to it.
+     * @param turn - Turn number of the round
+     * @post Exception guarantee: Strong
+     */
+    void beginRound(int turn);
+
+    /**
+     * @brief Sets a value of the latest round
+     * @param player - Turn order index of the player
+     * @param stat - Recorded value
+     * @param value - New value
+     * @pre beginRound has been called
+     * @post Exception guarantee: No-throw
+     */
+    void set(unsigned int player, Stat stat, qint32 value);
+
+    /**
+     * @brief Gets a recorded value
+     * @param stat - Recorded value
+     * @param round - Round index, not turn number
+     * @param player - Turn order index of the player
+     * @post Exception guarantee: Strong
+     * @exceptions std::out_of_range - No such round or player
+     */
+    qint32 get(Stat stat, unsigned int round, unsigned int player) const;
+
+    /**
+     * @brief Gets all values of a stat
+     * @post Exception guarantee: No-throw
+     * @return Values, index is round * getPlayerCount() + player
+     */
+    const std::vector<qint32>& getColumn(Stat stat) const;
+
+    /**
+     * @brief Gets the turn number of a round
+     * @post Exception guarantee: Strong
+     * @exceptions std::out_of_range - No such round
+     */
+    int getTurn(unsigned int round) const;
+
+    unsigned int getPlayerCount() const;
+
+    unsigned int getRoundCount() const;
+
+    /**
+     * @brief Gets the name of a player
+     * @post Exception guarantee: Strong
+     */
+    const std::string& getPlayerName(unsigned int player) const;
+
+    /**
+     * @brief Gets the colour of a player
+     * @post Exception guarantee: Strong
+     */
+    QColor getPlayerColor(unsigned int player) const;
+
+    /**
+     * @brief Writes the statistics as CSV, one line per round and player
+     * @param path - File to write
+     * @return True if the whole file was written
+     */
+    bool exportCsv(const QString& path) const;
+
+    /**
+     * @brief Writes the statistics in the binary format of StatsHeader
+     * @param path - File to write
+     * @return True if the whole file was written
+     */
+    bool exportBinary(const QString& path) const;
+
+    /**
+     * @brief Gets the name of a stat, also used as the CSV column header
+     * @post Exception guarantee: No-throw
+     */
+    static const char* statName(Stat stat);
+
+private:
+    std::vector<std::string> names_;
+    std::vector<QColor> colors_;
+    std::vector<qint32> turns_;
+    std::array<std::vector<qint32>, STAT_COUNT> columns_;
+};
+
+}
+
+#endif // STATSRECORDER_HH
@@ -0,0 +1,202 @@
+#include "steadyturns.hh"
+#include "core/profiler.hh"
+
+#include <algorithm>
+#include <array>
+#include <climits>
+
+namespace Game {
+
+namespace {
+
+const int UNLIMITED = INT_MAX;
+
+// Amount of every basic resource, missing ones are 0
+using Amounts = std::array<qint64, Course::ORE + 1>;
+
+Amounts amountsOf(const Course::ResourceMap& resources)
+{
+    Amounts amounts = {};
+    for(const auto& resource : resources){
+        amounts.at(resource.first) += resource.second;
+    }
+    return amounts;
+}
+
+/**
+ * @brief Counts the turns in a row, starting from the next one, that an
+ * amount stays at or above a limit at the start of
+ * @param amount - Amount now
+ * @param change - Change of the amount per turn
+ * @param limit - Lowest allowed amount
+ */
+int turnsAtLeast(qint64 amount, qint64 change, qint64 limit)
+{
+    if(amount < limit){
+        return 0;
+    }
+    if(change >= 0){
+        return UNLIMITED;
+    }
+    return std::min<qint64>(UNLIMITED, (amount - limit) / -change + 1);
+}
+
+/**
+ * @brief Counts the turns in a row that an amount stays negative at the
+ * start of
+ */
+int turnsNegative(qint64 amount, qint64 change)
+{
+    if(amount >= 0){
+        return 0;
+    }
+    if(change <= 0){
+        return UNLIMITED;
+    }
+    return std::min<qint64>(UNLIMITED, (change - amount - 1) / change);
+}
+
+/**
+ * @brief Counts the turns a player keeps feeding, paying and producing
+ * like in the next one
+ * @param resources - Resources of the player now
+ * @param cost - Upkeep the player pays in the next turn
+ * @param workers - Workers the player has
+ * @param change - Change of the resources per turn
+ * @param lowest - Lowest the resources get after the upkeep and each tile
+ * relative to the start of the turn, nullptr if the player has no tiles
+ */
+int steadyTurnsOf(const Course::ResourceMap& resources,
+                  const Course::ResourceMap& cost,
+                  int workers,
+                  const Amounts& change,
+                  const Amounts* lowest)
+{
+    Amounts amounts = amountsOf(resources);
+    int turns = UNLIMITED;
+
+    bool valid = std::all_of(amounts.begin(), amounts.end(),
+                             [](qint64 amount){ return amount >= 0; });
+    if(valid){
+        // Resources must stay valid or planUpkeep stops feeding
+        for(unsigned int r=0; r<amounts.size(); r++){
+            turns = std::min(turns, turnsAtLeast(amounts.at(r),
+                                                 change.at(r), 0));
+        }
+
+        // Everyone fed stays fed while food lasts, otherwise the food
+        // amount itself decides how many are fed
+        Amounts paid = amountsOf(cost);
+        qint64 fed = -paid.at(Course::FOOD);
+        if(fed == workers){
+            turns = std::min(turns, turnsAtLeast(amounts.at(Course::FOOD),
+                                                 change.at(Course::FOOD),
+                                                 fed));
+        } else if(change.at(Course::FOOD) != 0){
+            turns = std::min(turns, 1);
+        }
+        if(-paid.at(Course::MONEY) == fed){
+            turns = std::min(turns, turnsAtLeast(amounts.at(Course::MONEY),
+                                                 change.at(Course::MONEY),
+                                                 fed));
+        } else if(change.at(Course::MONEY) != 0){
+            turns = std::min(turns, 1);
+        }
+    } else{
+        // Nobody is fed while any resource stays negative
+        int negative = 0;
+        for(unsigned int r=0; r<amounts.size(); r++){
+            negative = std::max(negative, turnsNegative(amounts.at(r),
+                                                        change.at(r)));
+        }
+        turns = std::min(turns, negative);
+    }
+
+    // Every tile must afford its production, see
+    // GameEventHandler::modifyResources
+    if(lowest != nullptr){
+        for(unsigned int r=0; r<amounts.size(); r++){
+            turns = std::min(turns, turnsAtLeast(amounts.at(r), change.at(r),
+                                                 -lowest->at(r)));
+        }
+    }
+    return turns;
+}
+
+}
+
+SteadyTurns planSteadyTurns(
+        const std::vector<std::shared_ptr<Player>>& players,
+        const std::shared_ptr<ObjectManager>& objectmanager,
+        ProductionForecast& forecast)
+{
+    PV_PROFILE_SCOPE("planSteadyTurns");
+
+    const std::vector<std::shared_ptr<Course::WorkerBase>>& workers =
+            objectmanager->getWorkers();
+    UpkeepPlan plan = planUpkeep(players, workers);
+
+    SteadyTurns steady;
+    steady.satisfaction = plan.satisfaction;
+    steady.change.resize(players.size());
+
+    // Upkeep is taken only if someone gets fed, see payUpkeep
+    std::vector<Amounts> running(players.size(), Amounts());
+    for(unsigned int i=0; i<players.size(); i++){
+        if(amountsOf(plan.cost.at(i)).at(Course::FOOD) != 0){
+            steady.change.at(i) = plan.cost.at(i);
+            running.at(i) = amountsOf(plan.cost.at(i));
+        }
+    }
+
+    // Tiles produce in this order, the lowest point between them decides
+    // if all of them can afford it
+    std::vector<std::shared_ptr<Course::TileBase>> tiles =
+            objectmanager->getActiveTiles();
+    std::vector<Course::ResourceMap> productions =
+            forecast.getActiveProductions();
+    std::vector<Amounts> lowest(players.size(), Amounts());
+    std::vector<bool> producing(players.size(), false);
+    for(unsigned int t=0; t<tiles.size(); t++){
+        std::shared_ptr<Course::PlayerBase> owner = tiles.at(t)->getOwner();
+        if(owner == nullptr){
+            continue;
+        }
+        auto found = std::find(players.begin(), players.end(), owner);
+        if(found == players.end()){
+            return steady;
+        }
+        unsigned int i = found - players.begin();
+
+        steady.change.at(i) = Course::mergeResourceMaps(
+                    steady.change.at(i), productions.at(t));
+        Amounts production = amountsOf(productions.at(t));
+        for(unsigned int r=0; r<production.size(); r++){
+            running.at(i).at(r) += production.at(r);
+            lowest.at(i).at(r) = producing.at(i)
+                    ? std::min(lowest.at(i).at(r), running.at(i).at(r))
+                    : running.at(i).at(r);
+        }
+        producing.at(i) = true;
+    }
+
+    std::vector<int> counts(players.size(), 0);
+    for(const std::shared_ptr<Course::WorkerBase>& worker : workers){
+        auto found = std::find(players.begin(), players.end(),
+                               worker->getOwner());
+        if(found != players.end()){
+            counts.at(found - players.begin())++;
+        }
+    }
+
+    steady.repeats = UNLIMITED;
+    for(unsigned int i=0; i<players.size(); i++){
+        steady.repeats = std::min(steady.repeats, steadyTurnsOf(
+                    *players.at(i)->getResourceMap(), plan.cost.at(i),
+                    counts.at(i), amountsOf(steady.change.at(i)),
+                    producing.at(i) ? &lowest.at(i) : nullptr));
+    }
+    return steady;
+}
+
+}
@@ -0,0 +1,52 @@
+#ifndef STEADYTURNS_HH
+#define STEADYTURNS_HH
+
+#include "core/player.hh"
+#include "core/productionforecast.hh"
+#include "core/resourcemaps.h"
+#include "core/upkeep.hh"
+#include "interfaces/objectmanager.hh"
+
+#include <memory>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Turns that nobody acts in and that all change the resources the
+ * same way
+ */
+struct SteadyTurns
+{
+    // How many turns in a row repeat the change, 0 if the next one doesn't
+    int repeats = 0;
+    // Change of each player's resources per turn, same order as the players
+    std::vector<Course::ResourceMap> change;
+    // Satisfaction of each worker during the turns in recruitment order
+    std::vector<Satisfaction> satisfaction;
+};
+
+/**
+ * @brief Finds out how many of the next turns only repeat the upkeep and
+ * production of the next turn.
+ *
+ * The turns end at the first event that changes what a turn does: a player
+ * can't keep feeding or paying as many workers, a player's resources turn
+ * negative or back valid or a tile can't afford its production. Each limit
+ * is linear in the turn count so it is solved without running the turns.
+ * Scheduled effects, such as hold markers running out, are left to the
+ * caller, see TurnTimers.
+ * @param players - Players in turn order
+ * @param objectmanager - Object manager that has the tiles and workers
+ * @param forecast - Forecast of the same players and object manager
+ * @return Steady turns, repeats is INT_MAX if nothing ever changes
+ * @post Exception guarantee: Basic
+ */
+SteadyTurns planSteadyTurns(
+        const std::vector<std::shared_ptr<Player>>& players,
+        const std::shared_ptr<ObjectManager>& objectmanager,
+        ProductionForecast& forecast);
+
+}
+
+#endif // STEADYTURNS_HH
@@ -0,0 +1,124 @@
+#ifndef TILEBITSET_HH
+#define TILEBITSET_HH
+
+#include <QtGlobal>
+
+#include <cstddef>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief The TileBitset class holds one bit per map coordinate, row by
+ * row like the ObjectManager rasters. Sets are combined a word at a time.
+ * @code
+ * TileBitset mask = buildable;
+ * mask &= ownedByPlayer;
+ * mask.forEach([](std::size_t index){ ... });
+ * @endcode
+ */
+class TileBitset
+{
+public:
+    TileBitset() = default;
+
+    /**
+     * @brief Constructor for the class
+     * @param size - Amount of bits, all cleared
+     */
+    explicit TileBitset(std::size_t size) :
+        size_(size),
+        words_((size + WORD_BITS - 1) / WORD_BITS, 0)
+    {
+    }
+
+    std::size_t size() const
+    {
+        return size_;
+    }
+
+    /**
+     * @param index - Bit index, must be below size()
+     */
+    bool test(std::size_t index) const
+    {
+        return (words_[index / WORD_BITS] >> (index % WORD_BITS)) & 1u;
+    }
+
+    /**
+     * @param index - Bit index, must be below size()
+     * @param value - New value of the bit
+     */
+    void set(std::size_t index, bool value = true)
+    {
+        quint64 bit = quint64(1) << (index % WORD_BITS);
+        if(value){
+            words_[index / WORD_BITS] |= bit;
+        } else {
+            words_[index / WORD_BITS] &= ~bit;
+        }
+    }
+
+    /**
+     * @brief Keeps the bits that are set in both
+     * @pre Both have the same size
+     */
+    TileBitset& operator&=(const TileBitset& other)
+    {
+        for(std::size_t i=0; i<words_.size(); i++){
+            words_[i] &= other.words_[i];
+        }
+        return *this;
+    }
+
+    bool operator==(const TileBitset& other) const
+    {
+        return size_ == other.size_ && words_ == other.words_;
+    }
+
+    bool operator!=(const TileBitset& other) const
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Counts the set bits
+     */
+    std::size_t count() const
+    {
+        std::size_t total = 0;
+        for(quint64 word : words_){
+            for(; word != 0; word &= word - 1){
+                total++;
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Calls visit(index) for every set bit in increasing order.
+     * Empty words are skipped whole.
+     */
+    template<typename Visitor>
+    void forEach(Visitor visit) const
+    {
+        for(std::size_t i=0; i<words_.size(); i++){
+            quint64 word = words_[i];
+            for(std::size_t bit=0; word != 0; bit++, word >>= 1){
+                if(word & 1u){
+                    visit(i * WORD_BITS + bit);
+                }
+            }
+        }
+    }
+
+private:
+    static const std::size_t WORD_BITS = 64;
+
+    std::size_t size_ = 0;
+    std::vector<quint64> words_;
+};
+
+}
+
+#endif // TILEBITSET_HH
@@ -0,0 +1,108 @@
+#include "turntimers.hh"
+#include "core/profiler.hh"
+
+#include <algorithm>
+
+namespace Game {
+
+TurnTimers::TurnTimers(unsigned int length)
+{
+    unsigned int size = 1;
+    while(size < length){
+        size <<= 1;
+    }
+    slots_.resize(size);
+}
+
+quint64 TurnTimers::schedule(unsigned int turns, const Effect &effect)
+{
+    quint64 due = now_ + std::max(turns, 1u);
+    quint64 id = ++lastId_;
+    slotOf(due).push_back({id, due, effect});
+    due_[id] = due;
+    return id;
+}
+
+bool TurnTimers::cancel(quint64 id)
+{
+    auto found = due_.find(id);
+    if(found == due_.end()){
+        return false;
+    }
+
+    std::vector<Timer>& slot = slotOf(found->second);
+    slot.erase(std::remove_if(slot.begin(), slot.end(),
+                              [id](const Timer& timer){
+        return timer.id == id;
+    }), slot.end());
+    due_.erase(found);
+    return true;
+}
+
+unsigned int TurnTimers::remaining(quint64 id) const
+{
+    auto found = due_.find(id);
+    return found != due_.end() ? found->second - now_ : 0;
+}
+
+unsigned int TurnTimers::nextDue() const
+{
+    quint64 next = UINT_MAX;
+    for(const auto& timer : due_){
+        next = std::min(next, timer.second - now_);
+    }
+    return next;
+}
+
+unsigned int TurnTimers::pendingCount() const
+{
+    return due_.size();
+}
+
+void TurnTimers::advance(unsigned int turns)
+{
+    for(unsigned int i=0; i<turns; i++){
+        // Empty wheel has nothing to look at
+        if(due_.empty()){
+            now_ += turns - i;
+            return;
+        }
+
+        now_++;
+        std::vector<Timer>& slot = slotOf(now_);
+        auto later = std::stable_partition(slot.begin(), slot.end(),
+                                           [this](const Timer& timer){
+            return timer.due != now_;
+        });
+        if(later == slot.end()){
+            continue;
+        }
+
+        std::vector<Timer> ready(std::make_move_iterator(later),
+                                 std::make_move_iterator(slot.end()));
+        slot.erase(later, slot.end());
+        PV_PROFILE_COUNT("TurnTimers::ready", ready.size());
+
+        for(Timer& timer : ready){
+            // Earlier effects may have cancelled it
+            if(due_.erase(timer.id) != 0){
+                timer.effect();
+            }
+        }
+    }
+}
+
+void TurnTimers::clear()
+{
+    for(std::vector<Timer>& slot : slots_){
+        slot.clear();
+    }
+    due_.clear();
+}
+
+std::vector<TurnTimers::Timer> &TurnTimers::slotOf(quint64 turn)
+{
+    return slots_.at(turn & (slots_.size() - 1));
+}
+
+}
@@ -0,0 +1,103 @@
+#ifndef TURNTIMERS_HH
+#define TURNTIMERS_HH
+
+#include <QtGlobal>
+
+#include <climits>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief The TurnTimers class schedules effects for later turns.
+ *
+ * Timers are kept in a wheel of slots indexed by the turn they are due on,
+ * so ending a turn only looks at the one slot of that turn. Timers further
+ * away than the wheel is long wait in their slot for the later rounds.
+ * Nothing is done for objects without timers.
+ */
+class TurnTimers
+{
+public:
+    using Effect = std::function<void()>;
+
+    /**
+     * @brief Constructor for the class
+     * @param length - Amount of turns the wheel covers without waiting
+     * rounds, rounded up to a power of two
+     */
+    explicit TurnTimers(unsigned int length = 64);
+
+    /**
+     * @brief Schedules an effect
+     * @param turns - Amount of turns to end before the effect, at least 1
+     * @param effect - Runs when the last of those turns ends
+     * @return Id of the timer, never 0
+     * @post Exception guarantee: Basic
+     */
+    quint64 schedule(unsigned int turns, const Effect& effect);
+
+    /**
+     * @brief Cancels a timer that hasn't run yet
+     * @return True if the timer was pending
+     * @post Exception guarantee: No-throw
+     */
+    bool cancel(quint64 id);
+
+    /**
+     * @brief Gets the turns still to end before a timer runs
+     * @return Turns, 0 if the timer isn't pending
+     * @post Exception guarantee: No-throw
+     */
+    unsigned int remaining(quint64 id) const;
+
+    /**
+     * @brief Gets the turns to end before the next timer runs
+     * @return Turns, UINT_MAX if nothing is pending
+     * @post Exception guarantee: No-throw
+     */
+    unsigned int nextDue() const;
+
+    /**
+     * @brief Gets the amount of pending timers
+     * @post Exception guarantee: No-throw
+     */
+    unsigned int pendingCount() const;
+
+    /**
+     * @brief Ends turns and runs the effects that became due, in the order
+     * they were scheduled
+     * @param turns - Amount of turns to end
+     * @post Exception guarantee: Basic
+     * @note Effects may schedule new timers
+     */
+    void advance(unsigned int turns = 1);
+
+    /**
+     * @brief Cancels all timers
+     * @post Exception guarantee: No-throw
+     */
+    void clear();
+
+private:
+    struct Timer
+    {
+        quint64 id;
+        quint64 due;
+        Effect effect;
+    };
+
+    std::vector<Timer>& slotOf(quint64 turn);
+
+    std::vector<std::vector<Timer>> slots_;
+    // Due turn of every pending timer
+    std::unordered_map<quint64, quint64> due_;
+    quint64 now_ = 0;
+    quint64 lastId_ = 0;
+};
+
+}
+
+#endif // TURNTIMERS_HH
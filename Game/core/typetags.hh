@@ -0,0 +1,171 @@
+#ifndef TYPETAGS_HH
+#define TYPETAGS_HH
+
+#include <cstdint>
+#include <string>
+
+namespace Game {
+
+/**
+ * @brief Compile time tag of every concrete tile, building and worker
+ * class. Each class has a static TYPE_TAG and returns it from
+ * getTypeTag(), so type checks are integer compares instead of comparing
+ * getType() strings.
+ * @note Order is the index of TYPE_TRAITS, only append before COUNT.
+ */
+enum class TypeTag : std::uint8_t {
+    UNKNOWN,
+    // Tiles
+    TILE,
+    FOREST,
+    GRASSLAND,
+    LAKE,
+    MOUNTAIN,
+    OCEAN,
+    // Buildings
+    BUILDING,
+    FARM,
+    HEADQUARTERS,
+    OUTPOST,
+    MINE,
+    FISHING_BOAT,
+    LAKE_COTTAGE,
+    // Workers
+    WORKER,
+    BASIC_WORKER,
+    FARMER,
+    MINER,
+    COUNT
+};
+
+/**
+ * @brief Which kind of object a tag belongs to
+ */
+enum class TypeKind : std::uint8_t {
+    NONE,
+    TILE,
+    BUILDING,
+    WORKER
+};
+
+/**
+ * @brief Set of tags, one bit per tag
+ */
+using TagMask = std::uint32_t;
+
+static_assert(static_cast<int>(TypeTag::COUNT) <= 32,
+              "TagMask has a bit for every tag");
+
+/**
+ * @brief Gets the bit of the tag in a TagMask
+ */
+constexpr TagMask tagBit(TypeTag tag)
+{
+    return TagMask(1) << static_cast<int>(tag);
+}
+
+const TagMask ALL_TILES = tagBit(TypeTag::TILE) | tagBit(TypeTag::FOREST) |
+        tagBit(TypeTag::GRASSLAND) | tagBit(TypeTag::LAKE) |
+        tagBit(TypeTag::MOUNTAIN) | tagBit(TypeTag::OCEAN);
+const TagMask ALL_BUILDINGS = tagBit(TypeTag::BUILDING) |
+        tagBit(TypeTag::FARM) | tagBit(TypeTag::HEADQUARTERS) |
+        tagBit(TypeTag::OUTPOST) | tagBit(TypeTag::MINE) |
+        tagBit(TypeTag::FISHING_BOAT) | tagBit(TypeTag::LAKE_COTTAGE);
+const TagMask WATER_BUILDINGS = tagBit(TypeTag::FISHING_BOAT) |
+        tagBit(TypeTag::LAKE_COTTAGE);
+
+/**
+ * @brief Static facts about a type
+ */
+struct TypeTraits
+{
+    TypeTag tag;
+    TypeKind kind;
+    // Same as getType() of the class
+    const char* name;
+    // Buildings: tiles the building can be placed on
+    // Tiles: buildings the tile accepts
+    TagMask placement;
+    // Tiles only: no land buildings, claims or land workers
+    bool water;
+};
+
+/**
+ * @brief Traits of every tag, indexed by the tag
+ */
+constexpr TypeTraits TYPE_TRAITS[] = {
+    {TypeTag::UNKNOWN, TypeKind::NONE, "", 0, false},
+
+    {TypeTag::TILE, TypeKind::TILE, "TileBase", ALL_BUILDINGS, false},
+    {TypeTag::FOREST, TypeKind::TILE, "Forest", ALL_BUILDINGS, false},
+    {TypeTag::GRASSLAND, TypeKind::TILE, "Grassland", ALL_BUILDINGS, false},
+    {TypeTag::LAKE, TypeKind::TILE, "Lake", WATER_BUILDINGS, true},
+    {TypeTag::MOUNTAIN, TypeKind::TILE, "Mountain", ALL_BUILDINGS, false},
+    {TypeTag::OCEAN, TypeKind::TILE, "Ocean",
+     tagBit(TypeTag::FISHING_BOAT), true},
+
+    {TypeTag::BUILDING, TypeKind::BUILDING, "BuildingBase", ALL_TILES, false},
+    {TypeTag::FARM, TypeKind::BUILDING, "Farm", ALL_TILES, false},
+    {TypeTag::HEADQUARTERS, TypeKind::BUILDING, "HeadQuarters", ALL_TILES,
+     false},
+    {TypeTag::OUTPOST, TypeKind::BUILDING, "Outpost", ALL_TILES, false},
+    {TypeTag::MINE, TypeKind::BUILDING, "Mine", tagBit(TypeTag::MOUNTAIN),
+     false},
+    {TypeTag::FISHING_BOAT, TypeKind::BUILDING, "Fishing Boat",
+     tagBit(TypeTag::OCEAN) | tagBit(TypeTag::LAKE), false},
+    {TypeTag::LAKE_COTTAGE, TypeKind::BUILDING, "Lake Cottage",
+     tagBit(TypeTag::LAKE), false},
+
+    {TypeTag::WORKER, TypeKind::WORKER, "WorkerBase", 0, false},
+    {TypeTag::BASIC_WORKER, TypeKind::WORKER, "BasicWorker", 0, false},
+    {TypeTag::FARMER, TypeKind::WORKER, "Farmer", 0, false},
+    {TypeTag::MINER, TypeKind::WORKER, "Miner", 0, false}
+};
+
+static_assert(sizeof(TYPE_TRAITS) / sizeof(TypeTraits) ==
+              static_cast<unsigned int>(TypeTag::COUNT),
+              "Every tag needs traits");
+
+/**
+ * @brief Gets the traits of a tag
+ * @param tag - Type tag
+ * @return Traits, UNKNOWN traits for invalid tags
+ */
+constexpr const TypeTraits& typeTraits(TypeTag tag)
+{
+    return tag < TypeTag::COUNT ? TYPE_TRAITS[static_cast<int>(tag)]
+                                : TYPE_TRAITS[0];
+}
+
+/**
+ * @brief Checks if the terrain of the tile allows the building.
+ * Ownership and free space are not checked.
+ * @param building - Tag of the building
+ * @param tile - Tag of the tile
+ * @return True if both the building and the tile allow it
+ */
+constexpr bool canPlaceBuilding(TypeTag building, TypeTag tile)
+{
+    return (typeTraits(building).placement & tagBit(tile)) != 0 &&
+            (typeTraits(tile).placement & tagBit(building)) != 0;
+}
+
+/**
+ * @brief Finds the tag of a getType() name
+ * @param name - Type name
+ * @return Tag or UNKNOWN
+ * @note Linear search, meant for loading and the UI only
+ */
+inline TypeTag typeTagFromName(const std::string& name)
+{
+    for(const TypeTraits& traits : TYPE_TRAITS){
+        if(name == traits.name){
+            return traits.tag;
+        }
+    }
+    return TypeTag::UNKNOWN;
+}
+
+}
+
+#endif // TYPETAGS_HH
@@ -0,0 +1,129 @@
+#include "upkeep.hh"
+#include "core/profiler.hh"
+
+#include <algorithm>
+
+namespace Game {
+
+namespace {
+
+/**
+ * @brief Finds the turn order index of a player
+ * @return Index or -1 if not one of the players
+ */
+int indexOf(const std::vector<std::shared_ptr<Player>>& players,
+            const std::shared_ptr<Course::PlayerBase>& player)
+{
+    for(unsigned int i=0; i<players.size(); i++){
+        if(players.at(i) == player){
+            return i;
+        }
+    }
+    return -1;
+}
+
+int amountOf(const Course::ResourceMap& resources,
+             Course::BasicResource resource)
+{
+    auto found = resources.find(resource);
+    return found != resources.end() ? found->second : 0;
+}
+
+}
+
+double satisfactionValue(Satisfaction level)
+{
+    switch(level){
+    case Satisfaction::PAID:
+        return 1;
+    case Satisfaction::FED:
+        return 0.5;
+    default:
+        return 0;
+    }
+}
+
+std::pair<int, int> upkeepLimits(const Course::ResourceMap &resources,
+                                 int workers)
+{
+    bool valid = std::all_of(
+                resources.begin(), resources.end(),
+                [](const std::pair<const Course::BasicResource, int>& r){
+        return r.second >= 0;
+    });
+    if(!valid){
+        return std::make_pair(0, 0);
+    }
+
+    int fed = std::min(workers, amountOf(resources, Course::FOOD));
+    return std::make_pair(fed, std::min(fed, amountOf(resources,
+                                                      Course::MONEY)));
+}
+
+UpkeepPlan planUpkeep(
+        const std::vector<std::shared_ptr<Player>>& players,
+        const std::vector<std::shared_ptr<Course::WorkerBase>>& workers)
+{
+    std::vector<int> owners;
+    owners.reserve(workers.size());
+    std::vector<int> counts(players.size(), 0);
+    for(const std::shared_ptr<Course::WorkerBase>& worker : workers){
+        owners.push_back(indexOf(players, worker->getOwner()));
+        if(owners.back() >= 0){
+            counts.at(owners.back())++;
+        }
+    }
+
+    UpkeepPlan plan;
+    plan.cost.resize(players.size());
+    // Workers of each player still to be fed and paid
+    std::vector<int> fed(players.size(), 0);
+    std::vector<int> paid(players.size(), 0);
+    for(unsigned int i=0; i<players.size(); i++){
+        std::pair<int, int> limits = upkeepLimits(
+                    *players.at(i)->getResourceMap(), counts.at(i));
+        if(limits.first == 0){
+            // Nothing is taken from players that feed no one
+            continue;
+        }
+        fed.at(i) = limits.first;
+        paid.at(i) = limits.second;
+        plan.cost.at(i) = {{Course::FOOD, -fed.at(i)},
+                           {Course::MONEY, -paid.at(i)}};
+    }
+
+    plan.satisfaction.reserve(workers.size());
+    for(int owner : owners){
+        Satisfaction level = Satisfaction::HUNGRY;
+        if(owner >= 0 && paid.at(owner) > 0){
+            level = Satisfaction::PAID;
+            paid.at(owner)--;
+            fed.at(owner)--;
+        } else if(owner >= 0 && fed.at(owner) > 0){
+            level = Satisfaction::FED;
+            fed.at(owner)--;
+        }
+        plan.satisfaction.push_back(level);
+    }
+    return plan;
+}
+
+void payUpkeep(GameEventHandler& events,
+               const std::vector<std::shared_ptr<Player>>& players,
+               const std::vector<std::shared_ptr<Course::WorkerBase>>& workers)
+{
+    PV_PROFILE_SCOPE("payUpkeep");
+
+    UpkeepPlan plan = planUpkeep(players, workers);
+    for(unsigned int i=0; i<players.size(); i++){
+        if(amountOf(plan.cost.at(i), Course::FOOD) != 0){
+            events.modifyResources(players.at(i), plan.cost.at(i));
+        }
+    }
+    for(unsigned int i=0; i<workers.size(); i++){
+        workers.at(i)->setSatisfaction(
+                    satisfactionValue(plan.satisfaction.at(i)));
+    }
+}
+
+}
@@ -0,0 +1,89 @@
+#ifndef UPKEEP_HH
+#define UPKEEP_HH
+
+#include "core/player.hh"
+#include "interfaces/gameeventhandler.hh"
+#include "workers/workerbase.h"
+
+#include <QtGlobal>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief How well a worker is kept for the next production
+ */
+enum class Satisfaction : quint8 {
+    HUNGRY,
+    // Got one food
+    FED,
+    // Got one food and one money
+    PAID
+};
+
+/**
+ * @brief Gets the satisfaction value workers use, see
+ * WorkerBase::workEfficiency
+ * @return 0, 0.5 or 1
+ * @post Exception guarantee: No-throw
+ */
+double satisfactionValue(Satisfaction level);
+
+/**
+ * @brief What the upkeep phase takes and gives
+ */
+struct UpkeepPlan
+{
+    // Satisfaction of each worker, same order as the planned workers
+    std::vector<Satisfaction> satisfaction;
+    // Food and money taken from each player, same order as the players
+    std::vector<Course::ResourceMap> cost;
+};
+
+/**
+ * @brief Counts how many workers of a player get food and how many of them
+ * also get money. The upkeep plan of the player changes only when these do.
+ * @param resources - Resources of the player
+ * @param workers - Amount of workers the player has
+ * @return Fed and paid workers, both 0 if any resource is negative
+ * @post Exception guarantee: No-throw
+ */
+std::pair<int, int> upkeepLimits(const Course::ResourceMap& resources,
+                                 int workers);
+
+/**
+ * @brief Decides the upkeep of all workers in one pass.
+ *
+ * The workers of each player are served in the given order. Each gets one
+ * food while the player has food left, and the fed ones one money while
+ * the player has money left. A player with any negative resource keeps
+ * all of its workers hungry. Production of the turn doesn't feed workers,
+ * so the result doesn't depend on the order tiles are produced in.
+ * @param players - Players in turn order
+ * @param workers - Workers in recruitment order
+ * @return Plan, workers of other owners are HUNGRY
+ * @post Exception guarantee: Strong
+ */
+UpkeepPlan planUpkeep(
+        const std::vector<std::shared_ptr<Player>>& players,
+        const std::vector<std::shared_ptr<Course::WorkerBase>>& workers);
+
+/**
+ * @brief Runs the upkeep phase of a turn: takes the planned food and money
+ * with one resource change per player and sets the satisfaction of every
+ * worker for tileWorkAction.
+ * @param events - Event handler of the players
+ * @param players - Players in turn order
+ * @param workers - Workers in recruitment order
+ * @post Exception guarantee: Basic
+ */
+void payUpkeep(GameEventHandler& events,
+               const std::vector<std::shared_ptr<Player>>& players,
+               const std::vector<std::shared_ptr<Course::WorkerBase>>& workers);
+
+}
+
+#endif // UPKEEP_HH
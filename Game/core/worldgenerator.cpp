@@ -4,6 +4,7 @@
 #include "tiles/grassland.h"
 
 #include <vector>
+#include <random>
 
 
 namespace Course {
@@ -27,13 +28,14 @@ void WorldGenerator::generateMap(
         total_weight += ctor.first;
     }
 
-    srand(seed);
+    // Local generator, srand/rand state is shared by every thread
+    std::mt19937 random(seed);
     std::vector<std::shared_ptr<TileBase>> tiles;
     for (unsigned int x = 0; x < size_x; ++x)
     {
         for (unsigned int y = 0; y < size_y; ++y)
         {
-            auto ctor = findRandCtor(rand() % total_weight);
+            auto ctor = findRandCtor(random() % total_weight);
             tiles.push_back(ctor(Coordinate(x, y), eventhandler, objectmanager));
         }
     }
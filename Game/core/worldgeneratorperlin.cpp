@@ -1,12 +1,13 @@
 #include "worldgeneratorperlin.hh"
+#include <algorithm>
 #include <iostream>
 
 namespace Game {
 
-WorldGeneratorPerlin& WorldGeneratorPerlin::getInstance()
+WorldGeneratorPerlin::WorldGeneratorPerlin(
+        std::shared_ptr<const BiomeConfig> config) :
+    config_(config)
 {
-    static WorldGeneratorPerlin instance;
-    return instance;
 }
 
 void WorldGeneratorPerlin::generateMap(
@@ -14,64 +15,82 @@ void WorldGeneratorPerlin::generateMap(
         unsigned int size_y,
         unsigned int seed,
         const std::shared_ptr<ObjectManager>& objectmanager,
-        const std::shared_ptr<GameEventHandler>& eventhandler)
+        const std::shared_ptr<GameEventHandler>& eventhandler) const
 {
-    srand(seed);
-    std::vector<std::shared_ptr<Course::TileBase>> tiles;
+    // One chunk, the tiles are added at once
+    generateChunks(size_x, size_y, seed, objectmanager, eventhandler,
+                   std::max(size_x, 1u),
+                   [&objectmanager](
+                   std::vector<std::shared_ptr<Course::TileBase>>& tiles,
+                   unsigned int, unsigned int){
+        objectmanager->addTiles(tiles);
+    });
+}
+
+bool WorldGeneratorPerlin::generateChunks(
+        unsigned int size_x,
+        unsigned int size_y,
+        unsigned int seed,
+        const std::shared_ptr<ObjectManager>& objectmanager,
+        const std::shared_ptr<GameEventHandler>& eventhandler,
+        unsigned int chunkColumns,
+        const ChunkHandler& onChunk,
+        const std::atomic<bool>* cancel) const
+{
+    // mt19937 output is fixed by the standard unlike rand()
+    std::mt19937 random(seed);
+    chunkColumns = std::max(chunkColumns, 1u);
 
     // Get perlin noise
     PerlinNoise noise(size_x, size_y, seed);
 
-    // Loop over map for noise and make tiles
-    for (unsigned int x = 0; x < size_x; ++x)
+    // Loop over map for noise and make tiles. Columns are generated in
+    // the same order whatever the chunk size so the map stays the same
+    for (unsigned int first = 0; first < size_x; first += chunkColumns)
     {
-        for (unsigned int y = 0; y < size_y; ++y)
+        if (cancel != nullptr && cancel->load())
         {
-            double weight = noise.getNoiseValue(x, y);
-            auto ctor = findTileByValue(weight);
+            return false;
+        }
 
-            // Override default productions
-            std::shared_ptr<Course::TileBase> tile = ctor(
-                        Course::Coordinate(x, y), eventhandler, objectmanager);
+        unsigned int end = std::min(size_x, first + chunkColumns);
+        std::vector<std::shared_ptr<Course::TileBase>> tiles;
+        tiles.reserve((end - first) * size_y);
+        for (unsigned int x = first; x < end; ++x)
+        {
+            for (unsigned int y = 0; y < size_y; ++y)
+            {
+                double weight = noise.getNoiseValue(x, y);
+                auto ctor = findTileByValue(weight, random);
 
-            // Overriding resourcemaps
-            if(tile->getType() == "Forest"){
-                tile = std::make_shared<Course::Forest>(
-                            Course::Coordinate(x, y), eventhandler, objectmanager, 2, 3, FOREST_BP);
-            }
-            if(tile->getType() == "Grassland"){
-                tile = std::make_shared<Course::Grassland>(
-                            Course::Coordinate(x, y), eventhandler, objectmanager, 2, 3, GRASSLAND_BP);
+                // Exactly one tile per coordinate so IDs stay dense
+                tiles.push_back(ctor(Course::Coordinate(x, y), eventhandler,
+                                     objectmanager));
             }
-
-            tiles.push_back(tile);
         }
+        onChunk(tiles, end, size_x);
     }
-
-    objectmanager->addTiles(tiles);
+    return true;
 }
 
-TileConstructorPointer WorldGeneratorPerlin::findTileByValue(double value)
+const std::shared_ptr<const BiomeConfig> &WorldGeneratorPerlin::getConfig()
+const
 {
-    //std::cout << value << std::endl;
-    std::vector<std::tuple<float, float, TileConstructorPointer>> validTiles;
+    return config_;
+}
 
-    for(const auto& ctor : tileConstructors_)
-    {
-        // Check that value is between min and max
-        if(std::get<0>(ctor) <= value && std::get<1>(ctor) >= value)
-        {
-            validTiles.push_back(ctor);
-        }
-    }
+const TileConstructorPointer &WorldGeneratorPerlin::findTileByValue(
+        double value, std::mt19937& random) const
+{
+    const std::vector<const Biome*>& validTiles =
+            config_->getCandidates(value);
 
     if(validTiles.size() != 0){
-        int randIndex = ((double)rand() / RAND_MAX) * validTiles.size();
-        return std::get<2>(validTiles.at(randIndex));
+        int randIndex = random() % validTiles.size();
+        return validTiles.at(randIndex)->ctor;
     }
 
     // If no tiles matched fall back to first
-    return std::get<2>(tileConstructors_.at(0));
+    return config_->getFallback().ctor;
 }
 }
-
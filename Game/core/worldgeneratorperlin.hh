@@ -1,59 +1,45 @@
 #ifndef WORLDGENERATORPERLIN_HH
 #define WORLDGENERATORPERLIN_HH
 
-#include "tiles/tilebase.h"
-#include "tiles/forest.h"
-#include "tiles/grassland.h"
-#include "interfaces/gameeventhandler.hh"
-#include "interfaces/objectmanager.hh"
+#include "core/biomeconfig.hh"
 #include "core/perlinnoise.hh"
 
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <random>
 #include <vector>
-#include <tuple>
 
 namespace Game {
 
-using TileConstructorPointer = std::function<std::shared_ptr<Course::TileBase>(
-    Course::Coordinate,
-    std::shared_ptr<GameEventHandler>,
-    std::shared_ptr<ObjectManager>)>;
-
 /**
  * @brief The WorldGeneratorPerlin class generates the game world and tiles
  * by using the PerlinNoise class that provides so called perlin noise
- * algorithm
+ * algorithm. The tiles for each noise value come from a BiomeConfig.
+ *
+ * A generator has no state besides its configuration so the same instance
+ * can generate several maps at once on different threads.
  */
 class WorldGeneratorPerlin
 {
 public:
     /**
-     * @brief Used to get a reference to the Singleton instance.
-     * @return Reference to the Singleton instance.
-     * @post Exception guarantee: No-throw
+     * @brief Gets the tiles of one chunk of columns
+     * @param tiles - Tiles of the chunk column by column
+     * @param columns - Columns generated so far, this chunk included
+     * @param total - Columns in the map
      */
-    static WorldGeneratorPerlin& getInstance();
-
-    // Prevent copy and move construction and assignment.
-    WorldGeneratorPerlin(const WorldGeneratorPerlin&) = delete;
-    WorldGeneratorPerlin& operator=(const WorldGeneratorPerlin&) = delete;
-    WorldGeneratorPerlin(WorldGeneratorPerlin&&) = delete;
-    WorldGeneratorPerlin& operator=(WorldGeneratorPerlin&&) = delete;
+    using ChunkHandler = std::function<void(
+            std::vector<std::shared_ptr<Course::TileBase>>& tiles,
+            unsigned int columns, unsigned int total)>;
 
     /**
-     * @brief Register a Tile's constructor for use in map generation.
-     * @note Do this only once per Tile type or they won't be equally common.
-     * Use the Tile's type as the template parameter: addConstructor<Forest>();
-     * Use values 0...1
-     * @param weight represents the rarity of the Tile, high being common.
+     * @brief Constructor for the class
+     * @param config - Biomes to generate
+     * @pre config is not nullptr
      */
-    template<typename T>
-    void addConstructor(float min, float max)
-    {
-        TileConstructorPointer ctor = std::make_shared<T, Course::Coordinate,
-                std::shared_ptr<GameEventHandler>,
-                std::shared_ptr<ObjectManager>>;
-        tileConstructors_.push_back(std::make_tuple(min, max, ctor));
-    }
+    explicit WorldGeneratorPerlin(std::shared_ptr<const BiomeConfig> config =
+            BiomeConfig::defaultConfig());
 
     /**
      * @brief Generates Tile-objects and sends them to ObjectManager.
@@ -69,35 +55,50 @@ public:
                      unsigned int size_y,
                      unsigned int seed,
                      const std::shared_ptr<ObjectManager>& objectmanager,
-                     const std::shared_ptr<GameEventHandler>& eventhandler);
+                     const std::shared_ptr<GameEventHandler>& eventhandler) const;
 
-private:
     /**
-     * @brief Default constructor.
+     * @brief Generates the same tiles as generateMap in chunks of columns
+     * but doesn't add them to the ObjectManager, so it can run on another
+     * thread than the one using the ObjectManager.
+     * @param size_x is the horizontal size of the map area.
+     * @param size_y is the vertical size of the map area.
+     * @param seed is the seed-value used in the generation.
+     * @param objectmanager gives the IDs of the tiles.
+     * @param eventhandler points to the student's GameEventHandler.
+     * @param chunkColumns - Columns per chunk, at least 1
+     * @param onChunk - Gets each chunk on the generating thread
+     * @param cancel - Generation stops before the next chunk once set,
+     * nullptr if it can't be cancelled
+     * @return False if cancelled before the last chunk
+     * @post Exception guarantee: Basic
      */
-    WorldGeneratorPerlin() = default;
+    bool generateChunks(unsigned int size_x,
+                        unsigned int size_y,
+                        unsigned int seed,
+                        const std::shared_ptr<ObjectManager>& objectmanager,
+                        const std::shared_ptr<GameEventHandler>& eventhandler,
+                        unsigned int chunkColumns,
+                        const ChunkHandler& onChunk,
+                        const std::atomic<bool>* cancel = nullptr) const;
 
     /**
-     * @brief Default destructor.
+     * @brief Gets the biome configuration
+     * @post Exception guarantee: No-throw
      */
-    ~WorldGeneratorPerlin() = default;
+    const std::shared_ptr<const BiomeConfig>& getConfig() const;
 
+private:
     /**
      * @brief Find the Tile ctor matching the value.
      * @param value is the number being matched to a Tile.
+     * @param random picks one if several Tiles match the value.
      * @return The constructor matching the value.
      */
-    TileConstructorPointer findTileByValue(double value);
-
-    /**
-     * @brief Find random Tile ctor in the range min...max
-     * @param min - Minimum value of the matching Tile
-     * @param max - Maximum value of the matching Tile
-     * @return The constructor matching the range
-     */
-    TileConstructorPointer findTileInValueRange(int min, int max) const;
+    const TileConstructorPointer& findTileByValue(double value,
+                                                  std::mt19937& random) const;
 
-    std::vector<std::tuple<float, float, TileConstructorPointer>> tileConstructors_;
+    const std::shared_ptr<const BiomeConfig> config_;
 };
 
 }
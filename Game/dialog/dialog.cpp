@@ -4,7 +4,8 @@
 
 #include <QKeyEvent>
 #include <sstream>
-#include <QTime>
+#include <random>
+#include <QDateTime>
 
 Dialog::Dialog(QWidget *parent) :
     QDialog(parent),
@@ -61,14 +62,23 @@ std::unordered_map<QString, QColor> Dialog::getPlayers()
     return players_;
 }
 
+std::unordered_set<QString> Dialog::getComputerPlayers()
+{
+    return computerPlayers_;
+}
+
 int Dialog::getSeed()
 {
+    // No seed given, draw one. Summing the clock string gave only a few
+    // hundred distinct seeds.
     if (seed_ == 0) {
-        QTime currentTime = QTime().currentTime();
-        std::string seed = currentTime.toString().toStdString();
+        std::random_device device;
+        quint64 value = (static_cast<quint64>(device()) << 32) ^
+                QDateTime::currentMSecsSinceEpoch();
+        seed_ = static_cast<int>(value ^ (value >> 32));
 
-        for(unsigned int i=0; i<seed.length(); i++){
-            seed_ += (int)seed[i];
+        if (seed_ == 0) {
+            seed_ = 1;
         }
     }
 
@@ -111,7 +121,11 @@ QString Dialog::getPlayersString()
     int i = 0;
 
     for (auto player: players_) {
-        players += QString::number(i+1) + " " + player.first + "\n";
+        players += QString::number(i+1) + " " + player.first;
+        if (computerPlayers_.count(player.first) != 0) {
+            players += " (computer)";
+        }
+        players += "\n";
         i++;
     }
 
@@ -202,6 +216,7 @@ void Dialog::addPlayer()
 
         if (size == 0 && !playerName.isEmpty()) {
             players_.insert({playerName, pickedColor_});
+            addComputerPlayer(playerName);
             ui->preferredColor->setStyleSheet("background-color: qlineargradient(spread:pad, x1:1, y1:0,"
                                               " x2:1, y2:0, stop:0 rgba(21, 40, 38, 255),"
                                               " stop:1 rgba(255, 255, 255, 255));");
@@ -227,6 +242,7 @@ void Dialog::addPlayer()
             }
             if (valid && playerName != EMPTY) {
                 players_.insert({playerName, pickedColor_});
+                addComputerPlayer(playerName);
                 pickedColor_ = nullptr;
                 ui->preferredColor->setStyleSheet("background-color: qlineargradient(spread:pad, x1:1, y1:0,"
                                                   " x2:1, y2:0, stop:0 rgba(21, 40, 38, 255),"
@@ -275,6 +291,7 @@ void Dialog::playersAdded()
                                       " x2:1, y2:0, stop:0 rgba(21, 40, 38, 255),"
                                       " stop:1 rgba(255, 255, 255, 255));");
     ui->addPlayerBox->hide();
+    ui->computerPlayer->hide();
     ui->resetPlayers->show();
     ui->playerBrowser->setText(getPlayersString());
     playersAdded_ = true;
@@ -284,6 +301,8 @@ void Dialog::resetPlayersButton()
 {
     ui->resetPlayers->hide();
     players_.clear();
+    computerPlayers_.clear();
+    ui->computerPlayer->show();
     ui->addPlayerBox->setEnabled(true);
     ui->player->show();
     ui->addPlayerBox->show();
@@ -307,9 +326,22 @@ void Dialog::playerLineEdit()
 void Dialog::setSeed()
 {
     std::string seed = ui->seed->text().toStdString();
+    seed_ = 0;
+
+    if (seed.empty()) {
+        return;
+    }
 
+    // FNV-1a so that anagrams like "ab" and "ba" give different worlds
+    quint32 hash = 2166136261u;
     for(unsigned int i=0; i<seed.length(); i++){
-        seed_ += (int)seed[i];
+        hash ^= static_cast<unsigned char>(seed[i]);
+        hash *= 16777619u;
+    }
+    seed_ = static_cast<int>(hash);
+
+    if (seed_ == 0) {
+        seed_ = 1;
     }
 }
 
@@ -318,3 +350,10 @@ void Dialog::setRounds()
     rounds_ = ui->roundCount->value();
 }
 
+void Dialog::addComputerPlayer(const QString &playerName)
+{
+    if (ui->computerPlayer->isChecked()) {
+        computerPlayers_.insert(playerName);
+    }
+    ui->computerPlayer->setChecked(false);
+}
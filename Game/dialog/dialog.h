@@ -5,6 +5,7 @@
 #include <QDebug>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace Ui {
 class Dialog;
@@ -27,6 +28,12 @@ public:
      */
     std::unordered_map<QString, QColor> getPlayers();
 
+    /**
+     * @brief Fetches the players that the computer plays
+     * @return Names of the computer players
+     */
+    std::unordered_set<QString> getComputerPlayers();
+
     /**
      * @brief Fetches the game seed if set
      * @return returns the seed
@@ -114,8 +121,15 @@ signals:
     void dialogVerified();
 
 private:
+    /**
+     * @brief Marks the added player as a computer player if chosen
+     * @param playerName - Name of the added player
+     */
+    void addComputerPlayer(const QString& playerName);
+
     Ui::Dialog *ui;
     std::unordered_map<QString, QColor> players_;
+    std::unordered_set<QString> computerPlayers_;
     QColor pickedColor_;
     int playerCount_ = 0;
     bool playersAdded_ = false;
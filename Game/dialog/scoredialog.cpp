@@ -7,6 +7,15 @@ ScoreDialog::ScoreDialog(QWidget *parent) :
 {
     ui->setupUi(this);
     this->setWindowTitle(SCOREDIALOG_TITLE);
+
+    for (unsigned int i = 0; i < Game::STAT_COUNT; i++) {
+        ui->statBox->addItem(Game::StatsRecorder::statName(
+                                 static_cast<Game::Stat>(i)), i);
+    }
+    ui->statBox->setCurrentIndex(static_cast<int>(Game::Stat::SCORE));
+    ui->statsChart->setStat(Game::Stat::SCORE);
+    connect(ui->statBox, SIGNAL(currentIndexChanged(int)), this,
+            SLOT(selectStat(int)));
 }
 
 ScoreDialog::~ScoreDialog()
@@ -14,42 +23,41 @@ ScoreDialog::~ScoreDialog()
     delete ui;
 }
 
-void ScoreDialog::setAlignment()
-{
-    ui->player1->setAlignment(Qt::AlignCenter);
-    ui->player2->setAlignment(Qt::AlignCenter);
-    ui->player3->setAlignment(Qt::AlignCenter);
-    ui->player4->setAlignment(Qt::AlignCenter);
-
-    ui->score1->setAlignment(Qt::AlignCenter);
-    ui->score2->setAlignment(Qt::AlignCenter);
-    ui->score3->setAlignment(Qt::AlignCenter);
-    ui->score4->setAlignment(Qt::AlignCenter);
-}
-
-void ScoreDialog::insertGameScoreData(std::map<int, std::string>
-                                      playerScores)
+void ScoreDialog::insertGameScoreData(
+        const std::vector<Game::ScoreEntry>& playerScores)
 {
         ui->informationLabel->setText(GAME_END);
 
-        int i = 0;
-
-        for (auto it = playerScores.rbegin(); it != playerScores.rend(); it++) {
-            i++;
-            if (i==1) {
-                ui->player1->setText(QString::fromStdString(it->second));
-                ui->score1->setText(QString::number(it->first));
-            } else if (i == 2) {
-                ui->player2->setText(QString::fromStdString(it->second));
-                ui->score2->setText(QString::number(it->first));
-            } else if (i == 3) {
-                ui->player3->setText(QString::fromStdString(it->second));
-                ui->score3->setText(QString::number(it->first));
-            } else if (i==4) {
-                ui->player4->setText(QString::fromStdString(it->second));
-                ui->score4->setText(QString::number(it->first));
+        for (QLabel* label : rowLabels_) {
+            ui->scoreLayout->removeWidget(label);
+            delete label;
+        }
+        rowLabels_.clear();
+
+        // Row 0 has the headers
+        int row = 1;
+        for (const Game::ScoreEntry& entry : playerScores) {
+            QString texts[] = {QString::number(row),
+                               QString::fromStdString(entry.name),
+                               QString::number(entry.score)};
+            for (int column = 0; column < 3; column++) {
+                QLabel* label = new QLabel(texts[column], this);
+                label->setAlignment(Qt::AlignCenter);
+                ui->scoreLayout->addWidget(label, row, column);
+                rowLabels_.push_back(label);
             }
+            row++;
         }
-        setAlignment();
 }
 
+void ScoreDialog::setStats(
+        const std::shared_ptr<const Game::StatsRecorder>& recorder)
+{
+    ui->statsChart->setRecorder(recorder);
+}
+
+void ScoreDialog::selectStat(int index)
+{
+    ui->statsChart->setStat(static_cast<Game::Stat>(
+                                ui->statBox->itemData(index).toUInt()));
+}
@@ -3,8 +3,14 @@
 
 #include "algorithm"
 #include "constants/constants.hh"
+#include "core/scoreledger.hh"
+#include "core/statsrecorder.hh"
 
 #include <QDialog>
+#include <QLabel>
+
+#include <memory>
+#include <vector>
 
 namespace Ui {
 class ScoreDialog;
@@ -12,7 +18,8 @@ class ScoreDialog;
 
 /**
  * @brief The ScoreDialog class is a simple QDialog based class
- * for showing the player scores when the game ends
+ * for showing the player scores when the game ends, and a chart of the
+ * recorded statistics
  */
 class ScoreDialog : public QDialog
 {
@@ -24,18 +31,28 @@ public:
 
 public slots:
     /**
-     * @brief Sets Alignment for some ui elements
+     * @brief Shows the game scoreboard
+     * @param playerScores to show, best first
      */
-    void setAlignment();
+    void insertGameScoreData(const std::vector<Game::ScoreEntry>& playerScores);
 
     /**
-     * @brief Shows the game scoreboard
-     * @param playerScores to show
+     * @brief Shows the statistics of the game in the chart
+     * @param recorder - Statistics or nullptr if the game wasn't recorded
      */
-    void insertGameScoreData(std::map<int, std::string> playerScores);
+    void setStats(const std::shared_ptr<const Game::StatsRecorder>& recorder);
+
+    /**
+     * @brief Draws the stat selected in the stat box
+     * @param index - Index of the stat box
+     */
+    void selectStat(int index);
 
 private:
     Ui::ScoreDialog *ui;
+
+    // Rank, name and score labels of the players, one row each
+    std::vector<QLabel*> rowLabels_;
 };
 
 #endif // SCOREDIALOG_H
@@ -1,4 +1,6 @@
 #include "gamescene.hh"
+#include "core/profiler.hh"
+#include <algorithm>
 #include <iostream>
 
 namespace Game {
@@ -9,6 +11,7 @@ GameScene::GameScene(int mapWidth, int mapHeight, int tileSize, ObjectManager* o
 	mapWidth_ = mapWidth;
 	mapHeight_ = mapHeight;
 	tileScale_ = tileSize;
+	mapItems_.assign(mapWidth_ * mapHeight_, nullptr);
 }
 
 void GameScene::resize()
@@ -31,30 +34,92 @@ void GameScene::resize()
 
 void GameScene::loadTiles()
 {
-	for(auto tile : objmanager_->getTiles()){
-		drawItem(tile);
+	PV_PROFILE_SCOPE("loadTiles");
+
+	loadColumns(0, mapWidth_);
+
+	// Graphics for restored buildings and workers
+	for(auto building : objmanager_->getBuildings()){
+		MapItem* item = getMapItem(building->getCoordinate());
+		if(item != nullptr){
+			item->setBuildingOnTile(QString::fromStdString(building->getType()));
+		}
+	}
+	for(auto worker : objmanager_->getWorkers()){
+		MapItem* item = getMapItem(worker->getCoordinate());
+		if(item != nullptr){
+			item->setWorkerOnTile(QString::fromStdString(worker->getType()));
+		}
+	}
+}
+
+void GameScene::loadColumns(int firstColumn, int count)
+{
+	int end = std::min(mapWidth_, firstColumn + count);
+	for(int y=0; y<mapHeight_; y++){
+		for(int x=std::max(firstColumn, 0); x<end; x++){
+			Course::Coordinate coordinate(x, y);
+			TypeTag type = objmanager_->getTileTag(coordinate);
+			if(type == TypeTag::UNKNOWN){
+				continue;
+			}
+
+			Game::MapItem* nItem = new Game::MapItem(
+						coordinate, type, objmanager_, tileScale_);
+			placeItem(nItem, coordinate);
+		}
 	}
 }
 
+MapItem *GameScene::getMapItem(const Course::Coordinate &coordinate)
+{
+	if(coordinate.x() < 0 || coordinate.x() >= mapWidth_ ||
+			coordinate.y() < 0 || coordinate.y() >= mapHeight_){
+		return nullptr;
+	}
+
+	return mapItems_.at(coordinate.y() * mapWidth_ + coordinate.x());
+}
+
 void GameScene::drawItem(const std::shared_ptr<Course::GameObject> &obj)
 {
     Game::MapItem* nItem = new Game::MapItem(
 				obj, tileScale_);
 
+	placeItem(nItem, obj->getCoordinate());
+}
+
+void GameScene::placeItem(MapItem *item, const Course::Coordinate &coordinate)
+{
     // Fixes something that prevents clicking all tiles
 	QPixmap pix(tileScale_, tileScale_);
 
-    nItem->setPixmap(pix);
+    item->setPixmap(pix);
+
+	QPoint position = QPoint(coordinate.x()*tileScale_, coordinate.y()*tileScale_);
+	item->setPos(position);
+
+	addItem(item);
 
-	QPoint position = QPoint(obj->getCoordinate().x()*tileScale_, obj->getCoordinate().y()*tileScale_);
-	//qDebug() << "created tile at " << obj->getCoordinate().asQpoint() << " turned into " << position;
-	nItem->setPos(position);
+	if(coordinate.x() >= 0 && coordinate.x() < mapWidth_ &&
+			coordinate.y() >= 0 && coordinate.y() < mapHeight_){
+		unsigned int index = coordinate.y() * mapWidth_ + coordinate.x();
+		mapItems_.at(index) = item;
 
-	addItem(nItem);
+		// New items show no overlays yet
+		if(index < placement_.size()){
+			placement_.set(index, false);
+		}
+		if(index < productionValues_.size()){
+			productionValues_.at(index) = 0;
+		}
+	}
 }
 
 void GameScene::drawClaimBorders()
 {
+	PV_PROFILE_SCOPE("drawClaimBorders");
+
 	///// Delete old lines /////
 	for(auto line : borderLines_){
 		this->removeItem(line);
@@ -74,89 +139,50 @@ void GameScene::drawClaimBorders()
 							mapHeight_+1, std::make_pair(nullptr, nullptr));
 	}
 
+	// Colour of every owner index of the raster, looked up once
+	const std::vector<quint8>& owners = objmanager_->getOwnerRaster();
+	std::vector<QColor> ownerColours;
+	for(std::shared_ptr<Course::PlayerBase> player : objmanager_->getPlayers()){
+		Player* owner = static_cast<Player*>(player.get());
+		ownerColours.push_back(owner->getColor());
+	}
+	auto colourAt = [&](int x, int y){
+		unsigned int index = y * mapWidth_ + x;
+		quint8 owner = index < owners.size() ? owners.at(index) : NO_OWNER;
+		return owner < ownerColours.size() ? ownerColours.at(owner)
+										   : QColor(nullptr);
+	};
+
 	// Walk through lines between tiles row by row
 	for(int y=0; y<mapHeight_; y++){
 		// Map left edge
-		Player* owner = static_cast<Player*>(
-					objmanager_->getTile(
-						Course::Coordinate(0, y))
-					.get()->getOwner().get());
-		if(owner != nullptr){
-			lines_ver.at(0).at(y).second = owner->getColor();
-			//qDebug() << "Claim found at" << y << "0";
-		}
+		lines_ver.at(0).at(y).second = colourAt(0, y);
 
 		// Middle tiles
 		for(int x=1; x<mapWidth_; x++){
-			// Lefter tile
-			QColor first_tile_colour = nullptr;
-			owner = static_cast<Player*>(
-						objmanager_->getTile(
-							Course::Coordinate(x-1, y))
-						.get()->getOwner().get());
-			if(owner != nullptr){
-				first_tile_colour = owner->getColor();
-			}
-			// Righter tile
-			QColor second_tile_colour = nullptr;
-			owner = static_cast<Player*>(
-						objmanager_->getTile(
-							Course::Coordinate(x, y))
-						.get()->getOwner().get());
-			if(owner != nullptr){
-				second_tile_colour = owner->getColor();
-			}
+			QColor first_tile_colour = colourAt(x-1, y);
+			QColor second_tile_colour = colourAt(x, y);
 
 			// No border necessary if the colours match
 			if(first_tile_colour != second_tile_colour){
 				lines_ver.at(x).at(y) = std::make_pair(first_tile_colour, second_tile_colour);
-				//qDebug() << "Claim found at" << y << x;
 			}
 		}
 
 		// Map right edge
-		owner = static_cast<Player*>(
-					objmanager_->getTile(
-						Course::Coordinate(0, y))
-					.get()->getOwner().get());
-		if(owner != nullptr){
-			lines_ver.at(mapWidth_).at(y).first = owner->getColor();
-			//qDebug() << "Claim found at" << y << "31";
-		}
+		lines_ver.at(mapWidth_).at(y).first = colourAt(mapWidth_-1, y);
 	}
 
 	///// Gather horizontal lines /////
 	// Walk through lines between tiles column by column
 	for(int x=0; x<mapWidth_; x++){
-		// Map left edge
-		Player* owner = static_cast<Player*>(
-					objmanager_->getTile(
-						Course::Coordinate(x, 0))
-					.get()->getOwner().get());
-		if(owner != nullptr){
-			lines_hor.at(x).at(0).second = owner->getColor();
-		}
+		// Map top edge
+		lines_hor.at(x).at(0).second = colourAt(x, 0);
 
 		// Middle tiles
 		for(int y=1; y<mapHeight_; y++){
-			// Upper tile
-			QColor first_tile_colour = nullptr;
-			owner = static_cast<Player*>(
-						objmanager_->getTile(
-							Course::Coordinate(x, y-1))
-						.get()->getOwner().get());
-			if(owner != nullptr){
-				first_tile_colour = owner->getColor();
-			}
-			// Lower tile
-			QColor second_tile_colour = nullptr;
-			owner = static_cast<Player*>(
-						objmanager_->getTile(
-							Course::Coordinate(x, y))
-						.get()->getOwner().get());
-			if(owner != nullptr){
-				second_tile_colour = owner->getColor();
-			}
+			QColor first_tile_colour = colourAt(x, y-1);
+			QColor second_tile_colour = colourAt(x, y);
 
 			// No border necessary if the colours match
 			if(first_tile_colour != second_tile_colour){
@@ -164,14 +190,8 @@ void GameScene::drawClaimBorders()
 			}
 		}
 
-		// Map right edge
-		owner = static_cast<Player*>(
-					objmanager_->getTile(
-						Course::Coordinate(x, 0))
-					.get()->getOwner().get());
-		if(owner != nullptr){
-			lines_hor.at(x).at(mapHeight_).first = owner->getColor();
-		}
+		// Map bottom edge
+		lines_hor.at(x).at(mapHeight_).first = colourAt(x, mapHeight_-1);
 	}
 
 	///// Draw the lines /////
@@ -229,6 +249,44 @@ void GameScene::highlightTile(MapItem *obj, bool highlightOn)
 	}
 }
 
+void GameScene::highlightPlacement(const TileBitset &placement)
+{
+	auto setItem = [this](std::size_t index, bool on){
+		if(index < mapItems_.size() && mapItems_[index] != nullptr){
+			mapItems_[index]->setPlacementHighlight(on);
+			update(mapItems_[index]->sceneBoundingRect());
+		}
+	};
+
+	placement_.forEach([&](std::size_t index){
+		if(index >= placement.size() || !placement.test(index)){
+			setItem(index, false);
+		}
+	});
+	placement.forEach([&](std::size_t index){
+		if(index >= placement_.size() || !placement_.test(index)){
+			setItem(index, true);
+		}
+	});
+	placement_ = placement;
+}
+
+void GameScene::showProductionValues(const std::vector<int> &values)
+{
+	productionValues_.resize(mapItems_.size(), 0);
+	for(unsigned int i=0; i<mapItems_.size(); i++){
+		int value = i < values.size() ? values.at(i) : 0;
+		if(value == productionValues_.at(i) || mapItems_.at(i) == nullptr){
+			continue;
+		}
+
+		productionValues_.at(i) = value;
+		mapItems_.at(i)->setProductionText(
+					value != 0 ? QString::number(value) : QString());
+		update(mapItems_.at(i)->sceneBoundingRect());
+	}
+}
+
 /*bool GameScene::event(QEvent *event)
 {
     if (event->type() == QEvent::GraphicsSceneMousePress){
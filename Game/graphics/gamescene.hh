@@ -8,6 +8,7 @@
 #include <math.h>
 #include "core/playerbase.h"
 #include "tiles/tilebase.h"
+#include "core/tilebitset.hh"
 
 #include <QGraphicsScene>
 #include <QEvent>
@@ -40,10 +41,28 @@ public:
     void resize();
 
 	/**
-	 * @brief Loads tiles to the scene from the objectmanager
+	 * @brief Loads tiles to the scene from the objectmanager.
+	 * Buildings and workers already in the objectmanager are drawn too.
+	 * @note Tile objects are not created, only their types are read
 	 */
 	void loadTiles();
 
+	/**
+	 * @brief Loads the tiles of some columns to the scene, buildings and
+	 * workers aren't drawn
+	 * @param firstColumn - X of the first column
+	 * @param count - Amount of columns
+	 * @note Used to show the map while it's still being generated
+	 */
+	void loadColumns(int firstColumn, int count);
+
+	/**
+	 * @brief Gets the item on the given coordinate
+	 * @param coordinate of the tile
+	 * @return MapItem or nullptr if outside the map
+	 */
+	MapItem* getMapItem(const Course::Coordinate &coordinate);
+
     /**
      * @brief Draws item
      * @param obj to draw
@@ -74,7 +93,29 @@ public:
 	 */
 	void highlightTile(MapItem *obj, bool highlightOn=true);
 
+	/**
+	 * @brief Like highlightTile for many tiles, marks where a building
+	 * can be placed. Only the tiles whose bit changed are repainted.
+	 * @param placement bit per tile, row by row. Empty clears the overlay
+	 */
+	void highlightPlacement(const TileBitset &placement);
+
+	/**
+	 * @brief Writes production values on the tiles. Only the tiles whose
+	 * value changed are repainted.
+	 * @param values row by row, tiles with 0 show nothing. Empty clears
+	 * the overlay
+	 */
+	void showProductionValues(const std::vector<int> &values);
+
 protected:
+	/**
+	 * @brief Positions the item and adds it to the scene
+	 * @param item to add
+	 * @param coordinate of the tile
+	 */
+	void placeItem(MapItem* item, const Course::Coordinate &coordinate);
+
 	void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
 	void mouseMoveEvent(QGraphicsSceneMouseEvent *event) override;
 	void mouseReleaseEvent(QGraphicsSceneMouseEvent *event) override;
@@ -104,6 +145,12 @@ private:
 	// Game state stuff
 	ObjectManager* objmanager_;
 	std::vector<QGraphicsLineItem*>	borderLines_;
+	// Row by row, index = y * mapWidth_ + x
+	std::vector<MapItem*> mapItems_;
+	// Tiles that currently show the placement overlay
+	TileBitset placement_;
+	// Values the production overlay currently shows
+	std::vector<int> productionValues_;
 };
 }
 #endif // GAMESCENE_HH
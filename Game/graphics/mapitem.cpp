@@ -1,13 +1,33 @@
 #include "mapitem.hh"
+#include "core/objectregistry.hh"
+#include "core/profiler.hh"
 #include <QDebug>
 
+#include <algorithm>
+
 namespace Game {
 
 MapItem::MapItem(const std::shared_ptr<Course::GameObject> &obj,
                  int size):
     itemObject_(obj),
+    coordinate_(obj->getCoordinate()),
+    tileType_(obj->getTypeTag()),
     size_(size),
-    sceneLocation_(itemObject_->getCoordinatePtr()->asQpoint())
+    sceneLocation_(coordinate_.asQpoint())
+{
+    highlightPen_.setWidth(1);
+    highlightPen_.setJoinStyle(Qt::MiterJoin);
+}
+
+MapItem::MapItem(const Course::Coordinate &coordinate,
+                 TypeTag type,
+                 ObjectManager *objmanager,
+                 int size):
+    objmanager_(objmanager),
+    coordinate_(coordinate),
+    tileType_(type),
+    size_(size),
+    sceneLocation_(coordinate_.asQpoint())
 {
     highlightPen_.setWidth(1);
     highlightPen_.setJoinStyle(Qt::MiterJoin);
@@ -18,9 +38,12 @@ void MapItem::paint(QPainter *painter,
                     QWidget *widget)
 {
     Q_UNUSED(option); Q_UNUSED(widget);
+    PV_PROFILE_SCOPE("MapItem::paint");
     drawTileImage(painter);
     drawBuildings(painter);
     drawWorkers(painter);
+    if(placementHighlight_) drawPlacement(painter);
+    if(!productionText_.isEmpty()) drawProduction(painter);
 
     if(borderColor_ != "") drawBorder(painter);
     // Draw this after other borders
@@ -29,37 +52,24 @@ void MapItem::paint(QPainter *painter,
 
 const std::shared_ptr<Course::GameObject> &MapItem::getTileObject()
 {
+    if(itemObject_ == nullptr && objmanager_ != nullptr){
+        itemObject_ = objmanager_->getTile(coordinate_);
+    }
     return itemObject_;
 }
 
+const Course::Coordinate &MapItem::getCoordinate() const
+{
+    return coordinate_;
+}
+
 void MapItem::setBuildingOnTile(const QString &building)
 {
     // add building on tile
-    QPixmap buildImage;
-    QString path;
-
-    if (building == FARM) {
-        // drawFarmImage
-        path = FARM_IMAGE;
-    } else if (building == HQ) {
-        // draw HQ image
-        path = HQ_IMAGE;
-    }  else if (building == OUTPOST) {
-        // draw OUTPOST image
-        path = OUTPOST_IMAGE;
-    } else if (building == MINE) {
-        // draw Mine
-        path = MINE_IMAGE;
-    } else if (building == LAKE_COTTAGE) {
-        // draw Fishing cabin
-        path = LAKE_COTTAGE_IMAGE;
-    } else if (building == FISHING_BOAT) {
-        // draw FISHING boat image
-        path = SHIP_IMAGE;
-    }
+    const BuildingEntry* entry = ObjectRegistry::findBuilding(building);
+    QString path = entry != nullptr ? entry->image : BUILDING_IMAGE;
 
-    buildImage = QPixmap(path);
-    buildingImages_.push_back(buildImage);
+    buildingImages_.push_back(QPixmap(path));
     buildings_.push_back(building);
 }
 
@@ -104,6 +114,31 @@ void MapItem::removeHighlight()
     highlightColor_ = "";
 }
 
+void MapItem::setPlacementHighlight(bool on)
+{
+    placementHighlight_ = on;
+}
+
+void MapItem::drawPlacement(QPainter *painter)
+{
+    painter->fillRect(boundingRect(), PLACEMENT_COLOR);
+}
+
+void MapItem::setProductionText(const QString &text)
+{
+    productionText_ = text;
+}
+
+void MapItem::drawProduction(QPainter *painter)
+{
+    QFont font = painter->font();
+    font.setPixelSize(std::max(size_ / 2, 1));
+    painter->setFont(font);
+    painter->setPen(PRODUCTION_TEXT_COLOR);
+    painter->drawText(boundingRect(), Qt::AlignRight | Qt::AlignBottom,
+                      productionText_);
+}
+
 void MapItem::drawHighlight(QPainter *painter)
 {
     if(highlightColor_ != ""){
@@ -128,26 +163,35 @@ void MapItem::drawBorder(QPainter *painter)
 
 void MapItem::drawTileImage(QPainter* painter)
 {
-    QPixmap sceneDrawing;
-
-	// This should be done only once when creating the MapItem and
-	// again only if the image needs to be refreshed
-    if (itemObject_->getType() == "Forest") {
-        sceneDrawing = QPixmap(FOREST_IMAGE);
-    } else if (itemObject_->getType() == "Grassland") {
-        sceneDrawing = QPixmap(GRASSLAND_IMAGE);
-    } else if (itemObject_->getType() == "Mountain") {
-        sceneDrawing = QPixmap(MOUNTAIN_IMAGE);
-    } else if (itemObject_->getType() == "Lake") {
-        sceneDrawing = QPixmap(LAKE_IMAGE);
-    } else if (itemObject_->getType() == "Ocean") {
-        sceneDrawing = QPixmap(OCEAN_IMAGE);
+	// Loaded only once, the tile type never changes
+    if (tileImage_.isNull()) {
+        switch (tileType_) {
+        case TypeTag::FOREST:
+            tileImage_ = QPixmap(FOREST_IMAGE);
+            break;
+        case TypeTag::GRASSLAND:
+            tileImage_ = QPixmap(GRASSLAND_IMAGE);
+            break;
+        case TypeTag::MOUNTAIN:
+            tileImage_ = QPixmap(MOUNTAIN_IMAGE);
+            break;
+        case TypeTag::LAKE:
+            tileImage_ = QPixmap(LAKE_IMAGE);
+            break;
+        case TypeTag::OCEAN:
+            tileImage_ = QPixmap(OCEAN_IMAGE);
+            break;
+        default:
+            break;
+        }
     }
 
+    QPixmap sceneDrawing = tileImage_;
+
     // Set Farmland if the tile has Farm
     if(std::find(buildings_.begin(),
-                 buildings_.end(), "Farm") != buildings_.end()
-            && this->getTileObject()->getType() == "Grassland"){
+                 buildings_.end(), FARM) != buildings_.end()
+            && tileType_ == TypeTag::GRASSLAND){
         sceneDrawing = QPixmap(FARMLAND_IMAGE);
     }
 
@@ -4,6 +4,7 @@
 #include "core/gameobject.h"
 #include <constants/constants.hh>
 #include "core/player.hh"
+#include "interfaces/objectmanager.hh"
 #include <memory>
 #include <QGraphicsItem>
 #include <QGraphicsPixmapItem>
@@ -27,6 +28,17 @@ public:
      */
     MapItem(const std::shared_ptr<Course::GameObject> &obj, int size);
 
+    /**
+     * @brief Constructor for MapItem whose tile object is fetched from the
+     * objectmanager only when it's needed
+     * @param coordinate of the tile
+     * @param type of the tile
+     * @param objmanager that owns the tile
+     * @param size for item
+     */
+    MapItem(const Course::Coordinate &coordinate, TypeTag type,
+            ObjectManager* objmanager, int size);
+
     /**
      * @brief Paints the tile, buildings and workers
      * @param painter pointer for painting
@@ -39,9 +51,16 @@ public:
     /**
      * @brief Fetches the object that this item is for
      * @return GameObject that item was construced for
+     * @note Creates the tile object if it doesn't exist yet
      */
     const std::shared_ptr<Course::GameObject> &getTileObject();
 
+    /**
+     * @brief Fetches the coordinate of the tile without creating it
+     * @return Coordinate of the tile
+     */
+    const Course::Coordinate &getCoordinate() const;
+
     /**
      * @brief Sets building image path and type
      * @param building to add
@@ -79,6 +98,18 @@ public:
      */
     void removeHighlight();
 
+    /**
+     * @brief Shows or hides the valid placement overlay on this tile
+     * @param on - true if the selected building can be placed here
+     */
+    void setPlacementHighlight(bool on);
+
+    /**
+     * @brief Sets the text of the production overlay on this tile
+     * @param text - Production value, empty hides the overlay
+     */
+    void setProductionText(const QString &text);
+
 private:
     /**
      * @brief Draws the tileImage
@@ -110,7 +141,23 @@ private:
      */
     void drawBorder(QPainter* painter);
 
-    const std::shared_ptr<Course::GameObject> itemObject_;
+    /**
+     * @brief draw the placement overlay
+     * @param painter pointer
+     */
+    void drawPlacement(QPainter* painter);
+
+    /**
+     * @brief draw the production overlay
+     * @param painter pointer
+     */
+    void drawProduction(QPainter* painter);
+
+    std::shared_ptr<Course::GameObject> itemObject_;
+    ObjectManager* objmanager_ = nullptr;
+    Course::Coordinate coordinate_;
+    TypeTag tileType_;
+    QPixmap tileImage_;
     int size_;
     QPoint sceneLocation_;
 
@@ -119,6 +166,8 @@ private:
     // Highlighting
     QPen highlightPen_;
     QColor highlightColor_;
+    bool placementHighlight_ = false;
+    QString productionText_;
     // Other border
     QPen borderPen_;
     QColor borderColor_;
@@ -0,0 +1,82 @@
+#include "statschart.hh"
+
+#include <QPainter>
+#include <QPolygonF>
+
+#include <algorithm>
+
+namespace Game {
+
+namespace {
+
+// Room for the axis labels
+const int CHART_MARGIN = 30;
+
+}
+
+StatsChart::StatsChart(QWidget *parent) :
+    QWidget(parent)
+{
+}
+
+void StatsChart::setRecorder(
+        const std::shared_ptr<const StatsRecorder> &recorder)
+{
+    recorder_ = recorder;
+    update();
+}
+
+void StatsChart::setStat(Stat stat)
+{
+    stat_ = stat;
+    update();
+}
+
+void StatsChart::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+
+    QRectF area(CHART_MARGIN, CHART_MARGIN / 2,
+                width() - CHART_MARGIN * 3 / 2, height() - CHART_MARGIN * 3 / 2);
+    painter.setPen(palette().color(QPalette::WindowText));
+    painter.drawLine(area.bottomLeft(), area.bottomRight());
+    painter.drawLine(area.bottomLeft(), area.topLeft());
+
+    if(recorder_ == nullptr || recorder_->getRoundCount() == 0 ||
+            recorder_->getPlayerCount() == 0){
+        return;
+    }
+
+    const std::vector<qint32>& values = recorder_->getColumn(stat_);
+    auto range = std::minmax_element(values.begin(), values.end());
+    qint32 low = std::min(*range.first, 0);
+    qint32 high = std::max(*range.second, low + 1);
+
+    unsigned int rounds = recorder_->getRoundCount();
+    unsigned int players = recorder_->getPlayerCount();
+    double xStep = rounds > 1 ? area.width() / (rounds - 1) : 0;
+    double yScale = area.height() / (high - low);
+
+    painter.drawText(QPointF(2, area.top() + 10), QString::number(high));
+    painter.drawText(QPointF(2, area.bottom()), QString::number(low));
+    painter.drawText(QPointF(area.left(), area.bottom() + 14),
+                     QString::number(recorder_->getTurn(0)));
+    painter.drawText(QPointF(area.right() - 20, area.bottom() + 14),
+                     QString::number(recorder_->getTurn(rounds - 1)));
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    for(unsigned int player=0; player<players; player++){
+        QPolygonF line;
+        line.reserve(rounds);
+        for(unsigned int round=0; round<rounds; round++){
+            qint32 value = values.at(round * players + player);
+            line.append(QPointF(area.left() + round * xStep,
+                                area.bottom() - (value - low) * yScale));
+        }
+        painter.setPen(QPen(recorder_->getPlayerColor(player), 2));
+        painter.drawPolyline(line);
+    }
+}
+
+}
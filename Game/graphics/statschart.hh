@@ -0,0 +1,45 @@
+#ifndef STATSCHART_HH
+#define STATSCHART_HH
+
+#include "core/statsrecorder.hh"
+
+#include <QWidget>
+
+#include <memory>
+
+namespace Game {
+
+/**
+ * @brief The StatsChart class is a QWidget that draws one recorded stat of
+ * every player as a line over the rounds of the game.
+ */
+class StatsChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit StatsChart(QWidget* parent = nullptr);
+
+    /**
+     * @brief Sets the statistics to draw
+     * @param recorder - Recorder or nullptr to draw nothing
+     */
+    void setRecorder(const std::shared_ptr<const StatsRecorder>& recorder);
+
+    /**
+     * @brief Selects the stat to draw
+     * @param stat - Any recorded stat
+     */
+    void setStat(Stat stat);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    std::shared_ptr<const StatsRecorder> recorder_ = nullptr;
+    Stat stat_ = Stat::SCORE;
+};
+
+}
+
+#endif // STATSCHART_HH
@@ -4,11 +4,14 @@
 #include <memory>
 #include <vector>
 
+#include "core/neighbourrange.hh"
+
 
 namespace Course {
 
 class TileBase;
 class Coordinate;
+class PlayerBase;
 
 #ifndef COURSE_OBJECTID
 #define COURSE_OBJECTID
@@ -70,6 +73,71 @@ public:
     virtual std::vector<std::shared_ptr<TileBase>> getTiles(
             const std::vector<Coordinate>& coordinates) = 0;
 
+    /**
+     * @brief Returns the Tiles in a neighbourhood.
+     * @param range Coordinates of the requested Tiles. Coordinates outside
+     * the map are skipped without looking them up.
+     * @return Vector of the Tiles in the iteration order of the range.
+     * @post Exception Guarantee: Basic
+     */
+    virtual std::vector<std::shared_ptr<TileBase>> getTiles(
+            const Game::NeighbourRange& range) = 0;
+
+    /**
+     * @brief Reserves the ID for a new GameObject of this world.
+     * @return ID that no other object of this ObjectManager has.
+     * IDs start from 0 and have no gaps so they can index flat arrays.
+     * @post Exception Guarantee: No-throw
+     * @note Must be safe to call from several threads at once.
+     */
+    virtual ObjectId allocateId() = 0;
+
+    /**
+     * @brief Gives every unowned Tile in a neighbourhood to a player.
+     * Tiles that already have an owner are left as they are.
+     * @param range Coordinates of the Tiles. Coordinates outside the map
+     * are skipped.
+     * @param owner New owner of the Tiles
+     * @return Amount of Tiles claimed
+     * @post Exception Guarantee: Basic
+     */
+    virtual unsigned int claimUnowned(
+            const Game::NeighbourRange& range,
+            const std::shared_ptr<PlayerBase>& owner) = 0;
+
+    /**
+     * @brief Tells that the owner of a Tile has changed.
+     * @param coordinate Coordinate of the Tile
+     * @param owner New owner, empty pointer if the Tile has no owner
+     * @post Exception Guarantee: No-throw
+     * @note Called by GameObject::setOwner so that owner data kept
+     * outside the Tile objects stays up to date.
+     */
+    virtual void tileOwnerChanged(
+            const Coordinate& coordinate,
+            const std::shared_ptr<PlayerBase>& owner) = 0;
+
+    /**
+     * @brief Tells that a Building was added to or removed from a Tile.
+     * @param coordinate Coordinate of the Tile
+     * @param hasSpace True if one more Building fits on the Tile
+     * @post Exception Guarantee: No-throw
+     * @note Called by TileBase so that placement data kept outside the
+     * Tile objects stays up to date.
+     */
+    virtual void tileBuildingsChanged(const Coordinate& coordinate,
+                                      bool hasSpace) = 0;
+
+    /**
+     * @brief Tells that something other than the Buildings or the owner
+     * changed what a Tile produces, such as its Workers or hold markers.
+     * @param coordinate Coordinate of the Tile
+     * @post Exception Guarantee: No-throw
+     * @note Called by TileBase so that production data kept outside the
+     * Tile objects stays up to date.
+     */
+    virtual void tileProductionChanged(const Coordinate& coordinate) = 0;
+
 
 }; // class iObjectManager
 
@@ -1,6 +1,13 @@
 #include "objectmanager.hh"
+#include "tiles/forest.h"
+#include "tiles/grassland.h"
+#include "tiles/lake.h"
+#include "tiles/mountain.h"
+#include "tiles/ocean.hh"
 #include "iostream"
 
+#include <algorithm>
+
 namespace Game {
 
 ObjectManager::ObjectManager()
@@ -16,11 +23,10 @@ std::vector<std::shared_ptr<Course::TileBase> > ObjectManager::getTiles(
 {
     std::vector<std::shared_ptr<Course::TileBase>> tiles;
 
-    for(std::shared_ptr<Course::TileBase> tile : tiles_){
-        for(auto coordinate : coordinates){
-            if(tile->getCoordinate() == coordinate){
-                tiles.push_back(tile);
-            }
+    for(auto coordinate : coordinates){
+        std::shared_ptr<Course::TileBase> tile = getTile(coordinate);
+        if(tile != nullptr){
+            tiles.push_back(tile);
         }
     }
 
@@ -29,27 +35,51 @@ std::vector<std::shared_ptr<Course::TileBase> > ObjectManager::getTiles(
 
 std::vector<std::shared_ptr<Course::TileBase> > ObjectManager::getTiles()
 {
+    // Everything has to be created when all tiles are asked for
+    if(snapshot_ != nullptr){
+        for(unsigned int i=0; i<tileIndex_.size(); i++){
+            if(tileIndex_.at(i) < 0 &&
+                    snapshot_->tile(i).type != SNAPSHOT_TILE_UNKNOWN){
+                materializeTile(i);
+            }
+        }
+    }
+
     return tiles_;
 }
 
+std::vector<std::shared_ptr<Course::TileBase> > ObjectManager::getTiles(
+        const NeighbourRange &range)
+{
+    std::vector<std::shared_ptr<Course::TileBase>> tiles;
+    forEachTile(range, [&tiles](const std::shared_ptr<Course::TileBase>& tile){
+        tiles.push_back(tile);
+    });
+    return tiles;
+}
+
 std::shared_ptr<Course::TileBase> ObjectManager::getTile(
         const Course::ObjectId &id)
 {
-    for(std::shared_ptr<Course::TileBase> tile : tiles_){
-        if(tile->ID == id){
-            return tile;
-        }
+    if(id >= tileById_.size() || tileById_.at(id) < 0){
+        return nullptr;
     }
-    return nullptr;
+    return tiles_.at(tileById_.at(id));
 }
 
 std::shared_ptr<Course::TileBase> ObjectManager::getTile(
         const Course::Coordinate &coordinate)
 {
-    for(std::shared_ptr<Course::TileBase> tile : tiles_){
-        if(tile->getCoordinate() == coordinate){
-            return tile;
-        }
+    int index = gridIndex(coordinate);
+    if(index < 0){
+        return nullptr;
+    }
+
+    if(tileIndex_.at(index) >= 0){
+        return tiles_.at(tileIndex_.at(index));
+    }
+    if(snapshot_ != nullptr){
+        return materializeTile(index);
     }
 
     return nullptr;
@@ -58,10 +88,51 @@ std::shared_ptr<Course::TileBase> ObjectManager::getTile(
 void ObjectManager::addTiles(const std::vector
                              <std::shared_ptr<Course::TileBase> > &tiles)
 {
+    // Parts of a reserved map are indexed alone
+    bool inside = std::all_of(tiles.begin(), tiles.end(),
+                              [this](const std::shared_ptr<Course::TileBase>&
+                                     tile){
+        return gridIndex(tile->getCoordinate()) >= 0;
+    });
+
     // Loop over tiles
     for(auto tile : tiles){
         tiles_.push_back(tile);
+        indexTileId(tiles_.size() - 1);
+
+        width_ = std::max(width_, tile->getCoordinate().x() + 1);
+        height_ = std::max(height_, tile->getCoordinate().y() + 1);
+    }
+
+    if(inside){
+        for(unsigned int i=tiles_.size() - tiles.size(); i<tiles_.size(); i++){
+            placeTile(i);
+        }
+        return;
+    }
+
+    // Rebuild the coordinate index since the map may have grown
+    rebuildGrid();
+}
+
+void ObjectManager::reserveMap(int width, int height)
+{
+    if(width <= width_ && height <= height_){
+        return;
     }
+    width_ = std::max(width_, width);
+    height_ = std::max(height_, height);
+    rebuildGrid();
+}
+
+Course::ObjectId ObjectManager::allocateId()
+{
+    return nextId_.fetch_add(1, std::memory_order_relaxed);
+}
+
+Course::ObjectId ObjectManager::getIdCount() const
+{
+    return nextId_.load(std::memory_order_relaxed);
 }
 
 void ObjectManager::addBuilding(const std::shared_ptr
@@ -108,4 +179,530 @@ void ObjectManager::removeWorker(const std::shared_ptr
     throw Course::KeyError("Worker not found");
 }
 
+void ObjectManager::setSnapshot(
+        const std::shared_ptr<MapSnapshot> &snapshot,
+        const std::shared_ptr<Course::iGameEventHandler> &eventhandler,
+        const std::vector<std::shared_ptr<Course::PlayerBase> > &players)
+{
+    tiles_.clear();
+    buildings_.clear();
+    workers_.clear();
+    tileById_.clear();
+
+    snapshot_ = snapshot;
+    eventhandler_ = eventhandler;
+    players_ = players;
+
+    width_ = snapshot->header().mapWidth;
+    height_ = snapshot->header().mapHeight;
+    tileIndex_.assign(width_ * height_, -1);
+    tileTags_.assign(width_ * height_, TypeTag::UNKNOWN);
+    for(unsigned int i=0; i<tileTags_.size(); i++){
+        tileTags_.at(i) = MapSnapshot::tileTypeTag(snapshot->tile(i).type);
+    }
+    rebuildOwners();
+    rebuildPlacement();
+    revisions_.assign(tileTags_.size(), ++lastRevision_);
+}
+
+std::string ObjectManager::getTileType(const Course::Coordinate &coordinate)
+{
+    return typeTraits(getTileTag(coordinate)).name;
+}
+
+TypeTag ObjectManager::getTileTag(const Course::Coordinate &coordinate) const
+{
+    int index = gridIndex(coordinate);
+    if(index < 0){
+        return TypeTag::UNKNOWN;
+    }
+    return tileTags_.at(index);
+}
+
+const std::vector<TypeTag> &ObjectManager::getTileTags() const
+{
+    return tileTags_;
+}
+
+std::shared_ptr<Course::PlayerBase> ObjectManager::getTileOwner(
+        const Course::Coordinate &coordinate)
+{
+    int index = gridIndex(coordinate);
+    if(index < 0){
+        return nullptr;
+    }
+
+    quint8 owner = owners_.at(index);
+    if(owner < players_.size()){
+        return players_.at(owner);
+    }
+
+    return nullptr;
+}
+
+void ObjectManager::setPlayers(
+        const std::vector<std::shared_ptr<Course::PlayerBase> > &players)
+{
+    std::vector<std::shared_ptr<Course::PlayerBase>> previous = players_;
+    players_ = players;
+    territory_.assign(players_.size(), 0);
+    ownedTiles_.assign(players_.size(), TileBitset(owners_.size()));
+
+    // The raster still has indices to the previous list
+    std::vector<quint8> remap(previous.size(), NO_OWNER);
+    for(unsigned int i=0; i<previous.size(); i++){
+        remap.at(i) = ownerIndex(previous.at(i));
+    }
+    for(unsigned int i=0; i<owners_.size(); i++){
+        quint8& owner = owners_.at(i);
+        owner = owner < remap.size() ? remap.at(owner) : NO_OWNER;
+        if(owner != NO_OWNER){
+            territory_.at(owner)++;
+            ownedTiles_.at(owner).set(i);
+        }
+    }
+}
+
+const std::vector<std::shared_ptr<Course::PlayerBase> > &
+ObjectManager::getPlayers() const
+{
+    return players_;
+}
+
+quint8 ObjectManager::getTileOwnerIndex(
+        const Course::Coordinate &coordinate) const
+{
+    int index = gridIndex(coordinate);
+    if(index < 0){
+        return NO_OWNER;
+    }
+    return owners_.at(index);
+}
+
+const std::vector<quint8> &ObjectManager::getOwnerRaster() const
+{
+    return owners_;
+}
+
+std::shared_ptr<Course::TileBase> ObjectManager::findTile(
+        const Course::Coordinate &coordinate) const
+{
+    int index = gridIndex(coordinate);
+    if(index < 0 || tileIndex_.at(index) < 0){
+        return nullptr;
+    }
+    return tiles_.at(tileIndex_.at(index));
+}
+
+bool ObjectManager::hasSpaceForBuildings(const Course::Coordinate &coordinate,
+                                         int amount) const
+{
+    std::shared_ptr<Course::TileBase> tile = findTile(coordinate);
+    if(tile != nullptr){
+        return tile->hasSpaceForBuildings(amount);
+    }
+
+    // Tiles not created yet have nothing on them
+    int index = gridIndex(coordinate);
+    return index >= 0 && snapshot_ != nullptr &&
+            tileTags_.at(index) != TypeTag::UNKNOWN &&
+            amount <= snapshot_->tile(index).maxBuildings;
+}
+
+bool ObjectManager::hasSpaceForWorkers(const Course::Coordinate &coordinate,
+                                       int amount) const
+{
+    std::shared_ptr<Course::TileBase> tile = findTile(coordinate);
+    if(tile != nullptr){
+        return tile->hasSpaceForWorkers(amount);
+    }
+
+    int index = gridIndex(coordinate);
+    return index >= 0 && snapshot_ != nullptr &&
+            tileTags_.at(index) != TypeTag::UNKNOWN &&
+            amount <= snapshot_->tile(index).maxWorkers;
+}
+
+unsigned int ObjectManager::getTerritorySize(
+        const std::shared_ptr<Course::PlayerBase> &player) const
+{
+    for(unsigned int i=0; i<players_.size(); i++){
+        if(players_.at(i) == player){
+            return territory_.at(i);
+        }
+    }
+    return 0;
+}
+
+unsigned int ObjectManager::claimUnowned(
+        const NeighbourRange &range,
+        const std::shared_ptr<Course::PlayerBase> &owner)
+{
+    quint8 claimer = ownerIndex(owner);
+    if(claimer == NO_OWNER){
+        return 0;
+    }
+
+    unsigned int claimed = 0;
+    for(Course::Coordinate coordinate : range.clippedTo(width_, height_)){
+        int index = gridIndex(coordinate);
+        if(tileTags_.at(index) == TypeTag::UNKNOWN ||
+                owners_.at(index) != NO_OWNER){
+            continue;
+        }
+
+        setOwnerIndex(index, claimer);
+        touchTile(index);
+        // Tiles not created yet get their owner from the raster later
+        if(tileIndex_.at(index) >= 0){
+            tiles_.at(tileIndex_.at(index))->setOwner(owner);
+        }
+        claimed++;
+    }
+
+    return claimed;
+}
+
+void ObjectManager::tileOwnerChanged(
+        const Course::Coordinate &coordinate,
+        const std::shared_ptr<Course::PlayerBase> &owner)
+{
+    int index = gridIndex(coordinate);
+    if(index < 0 || tileTags_.at(index) == TypeTag::UNKNOWN){
+        return;
+    }
+    setOwnerIndex(index, ownerIndex(owner));
+    touchTile(index);
+}
+
+void ObjectManager::tileBuildingsChanged(const Course::Coordinate &coordinate,
+                                         bool hasSpace)
+{
+    int index = gridIndex(coordinate);
+    if(index < 0){
+        return;
+    }
+
+    TypeTag tile = tileTags_.at(index);
+    for(unsigned int tag=0; tag<buildable_.size(); tag++){
+        if(buildable_.at(tag).size() != 0){
+            buildable_.at(tag).set(index, hasSpace && canPlaceBuilding(
+                                       static_cast<TypeTag>(tag), tile));
+        }
+    }
+    touchTile(index);
+}
+
+void ObjectManager::tileProductionChanged(const Course::Coordinate &coordinate)
+{
+    touchTile(gridIndex(coordinate));
+}
+
+quint64 ObjectManager::getTileRevision(
+        const Course::Coordinate &coordinate) const
+{
+    int index = gridIndex(coordinate);
+    if(index < 0 || static_cast<unsigned int>(index) >= revisions_.size()){
+        return 0;
+    }
+    return revisions_.at(index);
+}
+
+TileBitset ObjectManager::getPlacement(
+        TypeTag building,
+        const std::shared_ptr<Course::PlayerBase> &player) const
+{
+    unsigned int tag = static_cast<unsigned int>(building);
+    for(unsigned int i=0; i<players_.size(); i++){
+        if(players_.at(i) == player && tag < buildable_.size() &&
+                buildable_.at(tag).size() != 0){
+            TileBitset placement = buildable_.at(tag);
+            placement &= ownedTiles_.at(i);
+            return placement;
+        }
+    }
+    return TileBitset(owners_.size());
+}
+
+std::vector<std::shared_ptr<Course::TileBase> > ObjectManager::getActiveTiles()
+{
+    std::vector<Course::Coordinate> coordinates;
+
+    for(auto building : buildings_){
+        coordinates.push_back(building->getCoordinate());
+    }
+    for(auto worker : workers_){
+        coordinates.push_back(worker->getCoordinate());
+    }
+
+    // Map generator creates tiles column by column
+    std::sort(coordinates.begin(), coordinates.end(),
+              [](const Course::Coordinate& a, const Course::Coordinate& b){
+        return a.x() < b.x() || (a.x() == b.x() && a.y() < b.y());
+    });
+    coordinates.erase(std::unique(coordinates.begin(), coordinates.end()),
+                      coordinates.end());
+
+    return getTiles(coordinates);
+}
+
+const std::vector<std::shared_ptr<Course::BuildingBase> >
+&ObjectManager::getBuildings()
+{
+    return buildings_;
+}
+
+const std::vector<std::shared_ptr<Course::WorkerBase> >
+&ObjectManager::getWorkers()
+{
+    return workers_;
+}
+
+std::pair<int, int> ObjectManager::getMapSize()
+{
+    return std::make_pair(width_, height_);
+}
+
+std::vector<SnapshotTile> ObjectManager::exportTiles(
+        const std::vector<std::shared_ptr<Course::PlayerBase> > &players)
+{
+    SnapshotTile empty = {};
+    empty.owner = SNAPSHOT_NO_OWNER;
+    std::vector<SnapshotTile> records(tileIndex_.size(), empty);
+
+    // Owner indices of the raster as indices of the given list
+    std::vector<quint8> remap(players_.size(), SNAPSHOT_NO_OWNER);
+    for(unsigned int i=0; i<players_.size(); i++){
+        for(unsigned int p=0; p<players.size(); p++){
+            if(players.at(p) == players_.at(i)){
+                remap.at(i) = p;
+            }
+        }
+    }
+
+    for(unsigned int i=0; i<tileIndex_.size(); i++){
+        quint8 owner = owners_.at(i);
+        quint8 savedOwner = owner < remap.size() ? remap.at(owner)
+                                                 : SNAPSHOT_NO_OWNER;
+
+        if(tileIndex_.at(i) < 0){
+            // Never created, the old record is valid apart from the owner
+            if(snapshot_ != nullptr){
+                records.at(i) = snapshot_->tile(i);
+                records.at(i).owner = savedOwner;
+            }
+            continue;
+        }
+
+        std::shared_ptr<Course::TileBase> tile = tiles_.at(tileIndex_.at(i));
+        SnapshotTile& record = records.at(i);
+        record.type = MapSnapshot::tileTypeCode(tile->getTypeTag());
+        record.owner = savedOwner;
+        record.maxBuildings = tile->MAX_BUILDINGS;
+        record.maxWorkers = tile->MAX_WORKERS;
+
+        for(int r=Course::NONE; r<=Course::ORE; r++){
+            auto it = tile->BASE_PRODUCTION.find(
+                        static_cast<Course::BasicResource>(r));
+            record.production[r] =
+                    it == tile->BASE_PRODUCTION.end() ? 0 : it->second;
+        }
+    }
+
+    return records;
+}
+
+void ObjectManager::indexTileId(unsigned int index)
+{
+    Course::ObjectId id = tiles_.at(index)->ID;
+    if(id >= tileById_.size()){
+        tileById_.resize(id + 1, -1);
+    }
+    tileById_.at(id) = index;
+}
+
+quint8 ObjectManager::ownerIndex(
+        const std::shared_ptr<Course::PlayerBase> &player)
+{
+    if(player == nullptr){
+        return NO_OWNER;
+    }
+
+    for(unsigned int i=0; i<players_.size(); i++){
+        if(players_.at(i) == player){
+            return i;
+        }
+    }
+
+    // NO_OWNER itself can't be a player index
+    if(players_.size() >= NO_OWNER){
+        return NO_OWNER;
+    }
+    players_.push_back(player);
+    territory_.push_back(0);
+    ownedTiles_.push_back(TileBitset(owners_.size()));
+    return players_.size() - 1;
+}
+
+void ObjectManager::setOwnerIndex(int index, quint8 owner)
+{
+    quint8& cell = owners_.at(index);
+    if(cell == owner){
+        return;
+    }
+
+    if(cell != NO_OWNER){
+        territory_.at(cell)--;
+        ownedTiles_.at(cell).set(index, false);
+    }
+    if(owner != NO_OWNER){
+        territory_.at(owner)++;
+        ownedTiles_.at(owner).set(index);
+    }
+    cell = owner;
+}
+
+void ObjectManager::rebuildGrid()
+{
+    tileIndex_.assign(width_ * height_, -1);
+    tileTags_.assign(width_ * height_, TypeTag::UNKNOWN);
+    for(unsigned int i=0; i<tiles_.size(); i++){
+        int index = gridIndex(tiles_.at(i)->getCoordinate());
+        if(index >= 0){
+            tileIndex_.at(index) = i;
+            tileTags_.at(index) = tiles_.at(i)->getTypeTag();
+        }
+    }
+    rebuildOwners();
+    rebuildPlacement();
+    revisions_.assign(tileTags_.size(), ++lastRevision_);
+}
+
+void ObjectManager::placeTile(unsigned int index)
+{
+    const std::shared_ptr<Course::TileBase>& tile = tiles_.at(index);
+    int cell = gridIndex(tile->getCoordinate());
+    tileIndex_.at(cell) = index;
+    tileTags_.at(cell) = tile->getTypeTag();
+    setOwnerIndex(cell, ownerIndex(tile->getOwner()));
+    tileBuildingsChanged(tile->getCoordinate(),
+                         tile->hasSpaceForBuildings(1));
+    touchTile(cell);
+}
+
+void ObjectManager::rebuildOwners()
+{
+    owners_.assign(tileIndex_.size(), NO_OWNER);
+    territory_.assign(players_.size(), 0);
+    ownedTiles_.assign(players_.size(), TileBitset(owners_.size()));
+
+    for(unsigned int i=0; i<tileIndex_.size(); i++){
+        if(tileIndex_.at(i) >= 0){
+            setOwnerIndex(i, ownerIndex(
+                              tiles_.at(tileIndex_.at(i))->getOwner()));
+        }
+        else if(snapshot_ != nullptr &&
+                i < snapshot_->header().tileCount &&
+                snapshot_->tile(i).owner < players_.size()){
+            setOwnerIndex(i, snapshot_->tile(i).owner);
+        }
+    }
+}
+
+void ObjectManager::rebuildPlacement()
+{
+    const unsigned int tagCount = static_cast<unsigned int>(TypeTag::COUNT);
+    buildable_.assign(tagCount, TileBitset());
+
+    for(unsigned int tag=0; tag<tagCount; tag++){
+        if(typeTraits(static_cast<TypeTag>(tag)).kind != TypeKind::BUILDING){
+            continue;
+        }
+        TileBitset& bits = buildable_.at(tag);
+        bits = TileBitset(tileTags_.size());
+        for(unsigned int i=0; i<tileTags_.size(); i++){
+            // Tiles not created yet have no buildings
+            bool hasSpace = tileIndex_.at(i) < 0 ||
+                    tiles_.at(tileIndex_.at(i))->hasSpaceForBuildings(1);
+            bits.set(i, hasSpace && canPlaceBuilding(
+                         static_cast<TypeTag>(tag), tileTags_.at(i)));
+        }
+    }
+}
+
+void ObjectManager::touchTile(int index)
+{
+    if(index >= 0 && static_cast<unsigned int>(index) < revisions_.size()){
+        revisions_.at(index) = ++lastRevision_;
+    }
+}
+
+int ObjectManager::gridIndex(const Course::Coordinate &coordinate) const
+{
+    if(coordinate.x() < 0 || coordinate.x() >= width_ ||
+            coordinate.y() < 0 || coordinate.y() >= height_){
+        return -1;
+    }
+
+    return coordinate.y() * width_ + coordinate.x();
+}
+
+std::shared_ptr<Course::TileBase> ObjectManager::materializeTile(int index)
+{
+    const SnapshotTile& record = snapshot_->tile(index);
+    Course::Coordinate coordinate(index % width_, index / width_);
+    std::shared_ptr<ObjectManager> self = shared_from_this();
+
+    // Base productions always list every resource
+    Course::ResourceMap production;
+    for(int r=Course::MONEY; r<=Course::ORE; r++){
+        production[static_cast<Course::BasicResource>(r)] =
+                record.production[r];
+    }
+
+    std::shared_ptr<Course::TileBase> tile;
+    switch(record.type){
+    case SNAPSHOT_TILE_FOREST:
+        tile = std::make_shared<Course::Forest>(
+                    coordinate, eventhandler_, self,
+                    record.maxBuildings, record.maxWorkers, production);
+        break;
+    case SNAPSHOT_TILE_GRASSLAND:
+        tile = std::make_shared<Course::Grassland>(
+                    coordinate, eventhandler_, self,
+                    record.maxBuildings, record.maxWorkers, production);
+        break;
+    case SNAPSHOT_TILE_LAKE:
+        tile = std::make_shared<Game::Lake>(
+                    coordinate, eventhandler_, self,
+                    record.maxBuildings, record.maxWorkers, production);
+        break;
+    case SNAPSHOT_TILE_MOUNTAIN:
+        tile = std::make_shared<Game::Mountain>(
+                    coordinate, eventhandler_, self,
+                    record.maxBuildings, record.maxWorkers, production);
+        break;
+    case SNAPSHOT_TILE_OCEAN:
+        tile = std::make_shared<Game::Ocean>(
+                    coordinate, eventhandler_, self,
+                    record.maxBuildings, record.maxWorkers, production);
+        break;
+    default:
+        // No tile on this coordinate
+        return nullptr;
+    }
+
+    // The raster may have been claimed after the snapshot was saved
+    quint8 owner = owners_.at(index);
+    if(owner < players_.size()){
+        tile->setOwner(players_.at(owner));
+    }
+
+    tileIndex_.at(index) = tiles_.size();
+    tiles_.push_back(tile);
+    indexTileId(tiles_.size() - 1);
+
+    return tile;
+}
+
 }
@@ -3,21 +3,37 @@
 
 #include "interfaces/iobjectmanager.h"
 #include "core/gameobject.h"
-#include "graphics/mapitem.hh"
+#include "core/mapsnapshot.hh"
+#include "core/playerbase.h"
+#include "core/tilebitset.hh"
 #include "tiles/tilebase.h"
 
 #include "exceptions/keyerror.h"
 
 #include <vector>
 #include <memory>
+#include <atomic>
 
 namespace Game {
 
+// Owner index of tiles nobody owns, same as in snapshot tile records
+const quint8 NO_OWNER = SNAPSHOT_NO_OWNER;
+
 /**
  * @brief The ObjectManager class is Course side based implementation for
  * saving the gameobjects. It has the game tiles, buildings and workers.
+ * Tiles can also be backed by a MapSnapshot in which case tile objects are
+ * created only when they are first needed.
+ *
+ * Tile owners are also kept in a raster of player indices so that whole
+ * map owner queries don't need the tile objects. Where each building type
+ * may go is kept in bitsets that follow ownership and building changes.
+ * Every tile also has a revision that changes whenever its owner,
+ * buildings or workers change, so data derived from a tile can be cached
+ * until the tile changes.
  */
-class ObjectManager : public Course::iObjectManager
+class ObjectManager : public Course::iObjectManager,
+                      public std::enable_shared_from_this<ObjectManager>
 {
 public:
     /**
@@ -45,11 +61,39 @@ public:
      */
     std::vector<std::shared_ptr<Course::TileBase>> getTiles();
 
+    /**
+     * @brief Get the tiles in a neighbourhood, clipped to the map
+     * @param range - Neighbour coordinates
+     * @post Exception guarantee: No-throw
+     * @return Tiles in the iteration order of the range
+     */
+    std::vector<std::shared_ptr<Course::TileBase>>
+        getTiles(const NeighbourRange &range) override;
+
+    /**
+     * @brief Calls visit(tile) for every tile in a neighbourhood without
+     * collecting them to a vector
+     * @param range - Neighbour coordinates, clipped to the map
+     * @param visit - Callable taking const std::shared_ptr<TileBase>&
+     * @post Exception guarantee: Same as visit
+     */
+    template<typename Visitor>
+    void forEachTile(const NeighbourRange &range, Visitor visit)
+    {
+        for(Course::Coordinate coordinate : range.clippedTo(width_, height_)){
+            std::shared_ptr<Course::TileBase> tile = getTile(coordinate);
+            if(tile != nullptr){
+                visit(tile);
+            }
+        }
+    }
+
     /**
      * @brief Get tile with given ID
      * @param id - ID of the tile
      * @post Exception guarantee: No-throw
      * @return Matching tile if found
+     * @note Constant time, IDs index a flat table
      */
     std::shared_ptr<Course::TileBase> getTile(const Course::ObjectId &id);
     /**
@@ -66,9 +110,37 @@ public:
      * @param tiles - Vector of tiles
      * @pre Valid tiles
      * @post Exception guarantee: No-throw
+     * @note Tiles inside the map size are indexed one by one, others grow
+     * the map and reindex every tile
      */
     void addTiles(const std::vector<std::shared_ptr<Course::TileBase> > &tiles);
 
+    /**
+     * @brief Sizes the map before its tiles are added, so a map added in
+     * parts with addTiles isn't reindexed for every part
+     * @param width - Width of the map in tiles
+     * @param height - Height of the map in tiles
+     * @post Exception guarantee: Basic
+     * @note The map never shrinks
+     */
+    void reserveMap(int width, int height);
+
+    /**
+     * @brief Reserves the next ID of this world
+     * @post Exception guarantee: No-throw
+     * @return Next unused ID, starting from 0
+     * @note Thread safe
+     */
+    Course::ObjectId allocateId() override;
+
+    /**
+     * @brief Get the number of IDs allocated so far. Every ID of this
+     * world is smaller than this so it can be used to size flat arrays
+     * @post Exception guarantee: No-throw
+     * @return ID count
+     */
+    Course::ObjectId getIdCount() const;
+
     /**
      * @brief Add building
      * @param building - Building object
@@ -101,10 +173,291 @@ public:
      */
     void removeWorker(const std::shared_ptr<Course::WorkerBase> &worker);
 
+    /**
+     * @brief Uses the snapshot as the backing store of the tiles.
+     * Existing tiles, buildings and workers are dropped.
+     * @param snapshot - Opened snapshot
+     * @param eventhandler - Event handler given to the created tiles
+     * @param players - Players in the same order as in the snapshot
+     * @pre ObjectManager is owned by a shared_ptr
+     * @post Exception guarantee: No-throw
+     */
+    void setSnapshot(const std::shared_ptr<MapSnapshot> &snapshot,
+                     const std::shared_ptr<Course::iGameEventHandler>
+                     &eventhandler,
+                     const std::vector<std::shared_ptr<Course::PlayerBase>>
+                     &players);
+
+    /**
+     * @brief Get the type of the tile without creating the tile object
+     * @param coordinate - Coordinate of the tile
+     * @post Exception guarantee: No-throw
+     * @return Tile type or empty string if there is no tile
+     */
+    std::string getTileType(const Course::Coordinate &coordinate);
+
+    /**
+     * @brief Get the type tag of the tile without creating the tile object
+     * @param coordinate - Coordinate of the tile
+     * @post Exception guarantee: No-throw
+     * @return Tile tag or UNKNOWN if there is no tile
+     */
+    TypeTag getTileTag(const Course::Coordinate &coordinate) const;
+
+    /**
+     * @brief Get the type tags of the whole map row by row, for loops that
+     * check every tile
+     * @post Exception guarantee: No-throw
+     * @return Tags, index is y * width + x
+     */
+    const std::vector<TypeTag> &getTileTags() const;
+
+    /**
+     * @brief Get the owner of the tile without creating the tile object
+     * @param coordinate - Coordinate of the tile
+     * @post Exception guarantee: No-throw
+     * @return Owner or nullptr if not owned
+     */
+    std::shared_ptr<Course::PlayerBase> getTileOwner(
+            const Course::Coordinate &coordinate);
+
+    /**
+     * @brief Get the tiles that have buildings or workers
+     * @post Exception guarantee: No-throw
+     * @return Tiles in the same order as the map generator created them
+     */
+    std::vector<std::shared_ptr<Course::TileBase>> getActiveTiles();
+
+    /**
+     * @brief Sets the players the owner indices refer to
+     * @param players - Players in turn order
+     * @post Exception guarantee: No-throw
+     * @note Owners that are not in the list get indices after them
+     */
+    void setPlayers(const std::vector<std::shared_ptr<Course::PlayerBase>>
+                    &players);
+
+    /**
+     * @brief Get the players the owner indices refer to
+     * @post Exception guarantee: No-throw
+     */
+    const std::vector<std::shared_ptr<Course::PlayerBase>> &getPlayers() const;
+
+    /**
+     * @brief Get the owner index of the tile without creating the tile
+     * object
+     * @param coordinate - Coordinate of the tile
+     * @post Exception guarantee: No-throw
+     * @return Index to the players or NO_OWNER
+     */
+    quint8 getTileOwnerIndex(const Course::Coordinate &coordinate) const;
+
+    /**
+     * @brief Get the tile only if the tile object has been created
+     * @param coordinate - Coordinate of the tile
+     * @post Exception guarantee: No-throw
+     * @return Tile or nullptr if not created yet or outside the map
+     */
+    std::shared_ptr<Course::TileBase> findTile(
+            const Course::Coordinate &coordinate) const;
+
+    /**
+     * @brief Checks if the tile has room for more buildings without
+     * creating the tile object
+     * @param coordinate - Coordinate of the tile
+     * @param amount - Building spaces needed
+     * @post Exception guarantee: No-throw
+     * @return False also if there is no tile
+     */
+    bool hasSpaceForBuildings(const Course::Coordinate &coordinate,
+                              int amount) const;
+
+    /**
+     * @brief Checks if the tile has room for more workers without creating
+     * the tile object
+     * @param coordinate - Coordinate of the tile
+     * @param amount - Worker spaces needed
+     * @post Exception guarantee: No-throw
+     * @return False also if there is no tile
+     */
+    bool hasSpaceForWorkers(const Course::Coordinate &coordinate,
+                            int amount) const;
+
+    /**
+     * @brief Get the owner indices of the whole map row by row
+     * @post Exception guarantee: No-throw
+     * @return Owner indices, index is y * width + x
+     */
+    const std::vector<quint8> &getOwnerRaster() const;
+
+    /**
+     * @brief Get the amount of tiles a player owns
+     * @param player - Player
+     * @post Exception guarantee: No-throw
+     * @note Constant time for the players given to setPlayers
+     */
+    unsigned int getTerritorySize(
+            const std::shared_ptr<Course::PlayerBase> &player) const;
+
+    unsigned int claimUnowned(
+            const NeighbourRange &range,
+            const std::shared_ptr<Course::PlayerBase> &owner) override;
+
+    void tileOwnerChanged(
+            const Course::Coordinate &coordinate,
+            const std::shared_ptr<Course::PlayerBase> &owner) override;
+
+    void tileBuildingsChanged(const Course::Coordinate &coordinate,
+                              bool hasSpace) override;
+
+    void tileProductionChanged(const Course::Coordinate &coordinate) override;
+
+    /**
+     * @brief Get the revision of a tile. The revision changes when the
+     * owner, buildings or workers of the tile change and is never reused
+     * by the same ObjectManager, not even after the map is replaced.
+     * @param coordinate - Location of the tile
+     * @post Exception guarantee: No-throw
+     * @return Revision, 0 if outside the map
+     */
+    quint64 getTileRevision(const Course::Coordinate &coordinate) const;
+
+    /**
+     * @brief Get the tiles where a player could place a building: the
+     * player owns the tile, the terrain takes the building and there is
+     * room for one more. Resources are not checked.
+     * @param building - Building type
+     * @param player - Player
+     * @post Exception guarantee: No-throw
+     * @return Bit per map coordinate, row by row. All clear for unknown
+     * types or players.
+     */
+    TileBitset getPlacement(
+            TypeTag building,
+            const std::shared_ptr<Course::PlayerBase> &player) const;
+
+    /**
+     * @brief Get all buildings
+     * @post Exception guarantee: No-throw
+     */
+    const std::vector<std::shared_ptr<Course::BuildingBase>> &getBuildings();
+
+    /**
+     * @brief Get all workers
+     * @post Exception guarantee: No-throw
+     */
+    const std::vector<std::shared_ptr<Course::WorkerBase>> &getWorkers();
+
+    /**
+     * @brief Get the map size in tiles
+     * @post Exception guarantee: No-throw
+     * @return Width and height
+     */
+    std::pair<int, int> getMapSize();
+
+    /**
+     * @brief Creates the tile records of a snapshot
+     * @param players - Players in the order they are saved
+     * @post Exception guarantee: No-throw
+     * @return Tile records row by row
+     */
+    std::vector<SnapshotTile> exportTiles(
+            const std::vector<std::shared_ptr<Course::PlayerBase>> &players);
+
 private:
+    /**
+     * @brief Converts coordinate to index of tileIndex_
+     * @return Index or -1 if outside the map
+     */
+    int gridIndex(const Course::Coordinate &coordinate) const;
+
+    /**
+     * @brief Creates the tile object from the snapshot record
+     * @param index - Index in the snapshot tile array
+     * @return Created tile or nullptr if the record has no tile
+     */
+    std::shared_ptr<Course::TileBase> materializeTile(int index);
+
+    /**
+     * @brief Stores tiles_ index of the tile to tileById_
+     * @param index - Index of the tile in tiles_
+     */
+    void indexTileId(unsigned int index);
+
+    /**
+     * @brief Finds the owner index of a player, adding unknown players
+     * @return Index or NO_OWNER for nullptr or if there are too many players
+     */
+    quint8 ownerIndex(const std::shared_ptr<Course::PlayerBase> &player);
+
+    /**
+     * @brief Sets one cell of the owner raster and the territory sizes
+     * @param index - Index in owners_
+     * @param owner - Owner index or NO_OWNER
+     */
+    void setOwnerIndex(int index, quint8 owner);
+
+    /**
+     * @brief Refills the coordinate index, the rasters and the bitsets for
+     * the current map size
+     */
+    void rebuildGrid();
+
+    /**
+     * @brief Indexes one tile of tiles_ inside the map
+     * @param index - Index in tiles_
+     */
+    void placeTile(unsigned int index);
+
+    /**
+     * @brief Refills the owner raster from the created tile objects
+     */
+    void rebuildOwners();
+
+    /**
+     * @brief Refills the building placement bitsets from the tile types
+     * and the created tile objects
+     */
+    void rebuildPlacement();
+
+    /**
+     * @brief Gives a tile a new revision
+     * @param index - Index in revisions_, ignored if outside
+     */
+    void touchTile(int index);
+
     std::vector<std::shared_ptr<Course::TileBase>> tiles_;
     std::vector<std::shared_ptr<Course::BuildingBase>> buildings_;
     std::vector<std::shared_ptr<Course::WorkerBase>> workers_;
+
+    // Index to tiles_ for every map coordinate, row by row. -1 means that
+    // the tile has not been created yet
+    std::vector<int> tileIndex_;
+    // Tile type of every map coordinate, row by row. Tiles never change
+    // type so this is valid even for tiles not created yet
+    std::vector<TypeTag> tileTags_;
+    // Index to tiles_ for every ID of this world, -1 if not a tile
+    std::vector<int> tileById_;
+    std::atomic<Course::ObjectId> nextId_{0};
+    int width_ = 0;
+    int height_ = 0;
+
+    std::shared_ptr<MapSnapshot> snapshot_ = nullptr;
+    std::shared_ptr<Course::iGameEventHandler> eventhandler_ = nullptr;
+    std::vector<std::shared_ptr<Course::PlayerBase>> players_;
+
+    // Owner index of every map coordinate, row by row
+    std::vector<quint8> owners_;
+    // Amount of tiles owned by each player in players_
+    std::vector<unsigned int> territory_;
+    // Tiles owned by each player in players_
+    std::vector<TileBitset> ownedTiles_;
+    // Indexed by building TypeTag: terrain takes the building and the tile
+    // has room for one more. Empty for other tags.
+    std::vector<TileBitset> buildable_;
+    // Revision of every map coordinate, row by row
+    std::vector<quint64> revisions_;
+    quint64 lastRevision_ = 0;
 };
 }
 #endif // OBJECTMANAGER_HH
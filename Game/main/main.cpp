@@ -1,10 +1,68 @@
 #include "mapwindow.hh"
+#include "core/replayengine.hh"
+#include "core/profiler.hh"
 #include <QApplication>
 #include <QStyle>
 #include <QDesktopWidget>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+
+/**
+ * @brief Replays a logged game without graphics and prints the state hash
+ * of every turn
+ * @param path - Path of the action log
+ * @return 0 if the replay matched the log, 1 if it diverged, 2 if the log
+ * could not be read
+ */
+int replayLog(const std::string& path)
+{
+    Game::ActionLog log;
+    if(!log.load(path)){
+        std::cerr << "Could not read " << path << std::endl;
+        return 2;
+    }
+
+    Game::ReplayEngine engine(log);
+    Game::ReplayResult result = engine.run();
+
+    for(const Game::TurnChecksum& checksum : result.checksums){
+        std::cout << checksum.turn << " " << checksum.playerIndex << " "
+                  << std::hex << std::setw(16) << std::setfill('0')
+                  << checksum.hash << std::dec << std::endl;
+    }
+
+    if(!result.matches){
+        std::cerr << result.message << std::endl;
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Writes the profile of the run if the build has profiling on and
+ * PV_PROFILE_OUT names the file prefix
+ */
+void writeProfile()
+{
+#ifdef PV_PROFILING
+    const char* prefix = std::getenv("PV_PROFILE_OUT");
+    if(prefix != nullptr &&
+            !Game::Profiler::getInstance().writeFiles(prefix)){
+        std::cerr << "Could not write the profile " << prefix << std::endl;
+    }
+#endif
+}
 
 int main(int argc, char *argv[])
 {
+    // Headless replay: Game --replay <log>
+    if(argc == 3 && std::string(argv[1]) == "--replay"){
+        int result = replayLog(argv[2]);
+        writeProfile();
+        return result;
+    }
+
     QApplication a(argc, argv);
     MapWindow w;
 
@@ -20,5 +78,7 @@ int main(int argc, char *argv[])
         )
     );
 
-    return a.exec();
+    int result = a.exec();
+    writeProfile();
+    return result;
 }
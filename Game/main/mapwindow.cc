@@ -2,6 +2,9 @@
 #include "ui_mapwindow.h"
 
 #include "core/gamemanager.hh"
+#include "ai/montecarlopolicy.hh"
+#include "ai/turnplanner.hh"
+#include "core/objectregistry.hh"
 #include "interfaces/gameeventhandler.hh"
 #include "graphics/gamescene.hh"
 #include "interfaces/objectmanager.hh"
@@ -10,6 +13,92 @@
 
 #include "iostream"
 
+#include <QRunnable>
+#include <QThreadPool>
+
+namespace {
+
+/**
+ * @brief Plans the turn of a computer player on a pool thread and hands
+ * the actions to the window's thread
+ */
+class ComputerTurnTask : public QRunnable
+{
+public:
+    ComputerTurnTask(MapWindow* window,
+                     std::function<void(std::vector<Game::GameAction>)> done,
+                     const std::shared_ptr<Game::PlayerPolicy>& policy,
+                     const Game::ForkPoint& point) :
+        window_(window),
+        done_(done),
+        policy_(policy),
+        point_(point)
+    {
+    }
+
+    void run() override
+    {
+        std::vector<Game::GameAction> actions =
+                Game::planTurn(*policy_, point_);
+        std::function<void(std::vector<Game::GameAction>)> done = done_;
+        QMetaObject::invokeMethod(window_, [done, actions](){
+            done(actions);
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    MapWindow* window_;
+    std::function<void(std::vector<Game::GameAction>)> done_;
+    std::shared_ptr<Game::PlayerPolicy> policy_;
+    Game::ForkPoint point_;
+};
+
+/**
+ * @brief Generates the world of a new game on a pool thread and hands the
+ * chunks to the window's thread
+ */
+class WorldTask : public QRunnable
+{
+public:
+    using Chunk = std::function<void(
+            std::vector<std::shared_ptr<Course::TileBase>>,
+            unsigned int, unsigned int)>;
+
+    WorldTask(MapWindow* window,
+              Chunk done,
+              const Game::GameManager::WorldJob& job,
+              const std::shared_ptr<std::atomic<bool>>& cancel) :
+        window_(window),
+        done_(done),
+        job_(job),
+        cancel_(cancel)
+    {
+    }
+
+    void run() override
+    {
+        MapWindow* window = window_;
+        Chunk done = done_;
+        job_(WORLD_CHUNK_COLUMNS,
+             [window, done](std::vector<std::shared_ptr<Course::TileBase>>& tiles,
+                            unsigned int columns, unsigned int total){
+            std::vector<std::shared_ptr<Course::TileBase>> chunk =
+                    std::move(tiles);
+            QMetaObject::invokeMethod(window, [done, chunk, columns, total](){
+                done(chunk, columns, total);
+            }, Qt::QueuedConnection);
+        }, cancel_.get());
+    }
+
+private:
+    MapWindow* window_;
+    Chunk done_;
+    Game::GameManager::WorldJob job_;
+    std::shared_ptr<std::atomic<bool>> cancel_;
+};
+
+}
+
 
 MapWindow::MapWindow(QWidget *parent) :
     QMainWindow(parent),
@@ -23,19 +112,15 @@ MapWindow::MapWindow(QWidget *parent) :
     ui_->graphicsView->setRenderHint(QPainter::Antialiasing);
     adjustSettings();
 
-    // Add buildings to UI
-    ui_->buildingsBox->addItem(FARM);
-    ui_->buildingsBox->addItem(HQ);
-    ui_->buildingsBox->addItem(OUTPOST);
-    ui_->buildingsBox->addItem(MINE);
-    ui_->buildingsBox->addItem(FISHING_BOAT);
-    ui_->buildingsBox->addItem(LAKE_COTTAGE);
-
-    // Add workers to UI
-    ui_->workersBox->addItem(WORKER_BASIC);
-    ui_->workersBox->addItem(WORKER_FARMER);
-    ui_->workersBox->addItem(WORKER_MINER);
-    //ui_->workersBox->addItem(WORKER_SABOTEUR);
+    // Add buildings and workers to UI
+    for(const Game::BuildingEntry& entry : Game::ObjectRegistry::buildings()){
+        ui_->buildingsBox->addItem(entry.name,
+                                   static_cast<int>(entry.tag));
+    }
+    for(const Game::WorkerEntry& entry : Game::ObjectRegistry::workers()){
+        ui_->workersBox->addItem(entry.name,
+                                 static_cast<int>(entry.tag));
+    }
 
     // Add resources to shop
     ui_->shopBox->addItem("Wood");
@@ -50,18 +135,23 @@ MapWindow::MapWindow(QWidget *parent) :
 
 MapWindow::~MapWindow()
 {
+    // Planned turns and world chunks are delivered to the window
+    cancelWorld();
+    QThreadPool::globalInstance()->waitForDone();
     delete ui_;
 }
 
 void MapWindow::gameButtonClicked()
 {   
-    if(settingsDialog_->getPlayers().size() == 0){
+    if(!gameStarted_ && settingsDialog_->getPlayers().size() == 0){
         settingsDialog_->open();
         return;
     }
 
     if(gameStarted_ == false){
+        // The rest is done when the world is ready
         newGame();
+        return;
     }else{
         gManager_->endTurn();
         if(gManager_->gameOver_){
@@ -72,6 +162,7 @@ void MapWindow::gameButtonClicked()
     // All these happen for the next player
 	resetElements();
     updatePlayerInfo(gManager_->getCurrentPlayer());
+    playComputerTurn();
 }
 
 void MapWindow::openDialog()
@@ -85,14 +176,50 @@ void MapWindow::openScoreDialog()
         return;
     }
     scoreDialog_->insertGameScoreData(gManager_->getScores());
+    scoreDialog_->setStats(gManager_->getStatsRecorder());
     scoreDialog_->exec();
 }
 
 void MapWindow::newGame()
+{
+    createGame(30, 20);	// GATHER MAP SIZE FROM GMAN
+
+	gManager_->addPlayers(settingsDialog_->getPlayers());
+	gManager_->setTurnCount(settingsDialog_->getRounds());
+	gManager_->setSeed(settingsDialog_->getSeed());
+	gManager_->setActionLog(std::make_shared<Game::ActionLog>());
+	gManager_->setStatsRecorder(std::make_shared<Game::StatsRecorder>());
+
+	// Check if game can start
+	if(gManager_->beginGame() == false){
+		resetGame();
+		return;
+	}
+
+    // Players are in turn order after the start
+    std::unordered_set<QString> computers =
+            settingsDialog_->getComputerPlayers();
+    std::vector<std::pair<std::string, int>> seats =
+            gManager_->getPlayerScores();
+    for(unsigned int i=0; i<seats.size(); i++){
+        if(computers.count(QString::fromStdString(seats.at(i).first)) != 0){
+            Game::MonteCarloSettings settings;
+            settings.budget = COMPUTER_TURN_BUDGET;
+            settings.seed = settingsDialog_->getSeed() + i;
+            gManager_->setPlayerPolicy(
+                        i, std::make_shared<Game::MonteCarloPolicy>(settings));
+        }
+    }
+
+    generateWorld();
+}
+
+void MapWindow::createGame(int mapWidth, int mapHeight)
 {
     geHandler_ = std::make_shared<Game::GameEventHandler>();
 	objManager_ = std::make_shared<Game::ObjectManager>();
-	gScene_ = std::make_shared<Game::GameScene>(30,20,20, objManager_.get());	// GATHER MAP SIZE FROM GMAN
+	gScene_ = std::make_shared<Game::GameScene>(mapWidth, mapHeight, 20,
+												objManager_.get());
 
     Game::GameScene* gsRawptr = gScene_.get();
     ui_->graphicsView->setScene(dynamic_cast<QGraphicsScene*>(gsRawptr));
@@ -102,29 +229,25 @@ void MapWindow::newGame()
             &MapWindow::updateTileInfo);
 
     currentZoomLevel = 1;
+    currentItem_ = nullptr;
 
-    // Start the game => create map etc.
 	std::shared_ptr<Game::GameManager> gm(new Game::GameManager(
 											  geHandler_,
 											  objManager_,
 											  gScene_,
 											  this));
-	gm->addPlayers(settingsDialog_->getPlayers());
-	gm->setTurnCount(settingsDialog_->getRounds());
-	gm->setSeed(settingsDialog_->getSeed());
+	gm->setMapSize(mapWidth, mapHeight);
     gManager_ = gm;
+}
 
-	// Check if game can start
-	if(gManager_->startGame() == false){
-		resetGame();
-		return;
-	}
-
+void MapWindow::gameReady()
+{
     ui_->gameButton->setText(GAME_BUTTON_WHILE_GAME);
-    setButtonStateEnabled(true);
+    setButtonStateEnabled(!gManager_->gameOver_);
     // Resize the graphicsview and fit map to it
-    std::pair<int, int> mapSize = gm->getMapSize();
+    std::pair<int, int> mapSize = gManager_->getMapSize();
 	resizeGameView(mapSize.first, mapSize.second);
+	gScene_->drawClaimBorders();
 
     // Update GUI
     resetElements();
@@ -133,9 +256,222 @@ void MapWindow::newGame()
     gameStarted_ = true;
 }
 
+void MapWindow::generateWorld()
+{
+    ui_->gameButton->setText(GAME_BUTTON_GENERATING);
+    ui_->gameButton->setEnabled(false);
+    setButtonStateEnabled(false);
+    // Chunks are drawn in place as they come
+    std::pair<int, int> mapSize = gManager_->getMapSize();
+    resizeGameView(mapSize.first, mapSize.second);
+
+    worldDialog_ = new QProgressDialog(
+                WORLD_PROGRESS, "Cancel", 0, mapSize.first, this);
+    worldDialog_->setWindowModality(Qt::NonModal);
+    worldDialog_->setMinimumDuration(0);
+    connect(this, &MapWindow::worldProgress,
+            worldDialog_, &QProgressDialog::setValue);
+    connect(worldDialog_, &QProgressDialog::canceled,
+            this, &MapWindow::resetGame);
+
+    quint64 generation = ++worldGeneration_;
+    worldCancel_ = std::make_shared<std::atomic<bool>>(false);
+    QThreadPool::globalInstance()->start(new WorldTask(
+            this, [this, generation](
+            std::vector<std::shared_ptr<Course::TileBase>> tiles,
+            unsigned int columns, unsigned int total){
+        addWorldChunk(generation, tiles, columns, total);
+    }, gManager_->getWorldJob(), worldCancel_));
+}
+
+void MapWindow::addWorldChunk(
+        quint64 generation,
+        const std::vector<std::shared_ptr<Course::TileBase>> &tiles,
+        unsigned int columns, unsigned int total)
+{
+    if(generation != worldGeneration_ || gManager_ == nullptr){
+        return;
+    }
+
+    gManager_->addWorldChunk(tiles);
+    emit worldProgress(columns, total);
+    if(columns < total){
+        return;
+    }
+
+    worldCancel_ = nullptr;
+    worldDialog_->deleteLater();
+    worldDialog_ = nullptr;
+    gManager_->finishWorld();
+    gameReady();
+    playComputerTurn();
+}
+
+void MapWindow::cancelWorld()
+{
+    worldGeneration_++;
+    if(worldCancel_ != nullptr){
+        worldCancel_->store(true);
+        worldCancel_ = nullptr;
+    }
+    if(worldDialog_ != nullptr){
+        // May be cancelling from the dialog's own signal
+        worldDialog_->disconnect(this);
+        worldDialog_->close();
+        worldDialog_->deleteLater();
+        worldDialog_ = nullptr;
+    }
+}
+
+void MapWindow::playComputerTurn()
+{
+    std::shared_ptr<Game::PlayerPolicy> policy = nullptr;
+    if(gameStarted_ && !gManager_->gameOver_){
+        policy = gManager_->getPlayerPolicy(
+                    gManager_->getCurrentPlayerIndex());
+    }
+    if(policy == nullptr){
+        ui_->gameButton->setText(GAME_BUTTON_WHILE_GAME);
+        ui_->gameButton->setEnabled(true);
+        if(gameStarted_){
+            setButtonStateEnabled(!gManager_->gameOver_);
+        }
+        return;
+    }
+
+    ui_->gameButton->setText(GAME_BUTTON_COMPUTER_TURN);
+    ui_->gameButton->setEnabled(false);
+    setButtonStateEnabled(false);
+
+    quint64 turn = ++computerTurn_;
+    QThreadPool::globalInstance()->start(new ComputerTurnTask(
+            this, [this, turn](std::vector<Game::GameAction> actions){
+        finishComputerTurn(turn, actions);
+    }, policy, gManager_->captureState()));
+}
+
+void MapWindow::finishComputerTurn(
+        quint64 turn, const std::vector<Game::GameAction> &actions)
+{
+    if(turn != computerTurn_ || !gameStarted_){
+        return;
+    }
+
+    for(const Game::GameAction& action : actions){
+        try{
+            gManager_->applyAction(action);
+        }
+        catch(const Course::BaseException&){
+            // Planned on the same state, rejected ones are skipped
+        }
+    }
+    gameButtonClicked();
+}
+
+void MapWindow::saveGame()
+{
+    if(!gameStarted_){
+        return;
+    }
+
+    QString path = QFileDialog::getSaveFileName(this, SAVE_GAME_TITLE, "",
+                                                SNAPSHOT_FILE_FILTER);
+    if(path.isEmpty()){
+        return;
+    }
+
+    if(!gManager_->saveGame(path)){
+        QMessageBox::warning(this, SAVE_GAME_TITLE, SAVE_FAILED);
+    }
+}
+
+void MapWindow::saveReplay()
+{
+    // Loaded games have no log since the start is missing
+    if(!gameStarted_ || gManager_->getActionLog() == nullptr){
+        return;
+    }
+
+    QString path = QFileDialog::getSaveFileName(this, SAVE_REPLAY_TITLE, "",
+                                                REPLAY_FILE_FILTER);
+    if(path.isEmpty()){
+        return;
+    }
+
+    if(!gManager_->getActionLog()->save(path.toStdString())){
+        QMessageBox::warning(this, SAVE_REPLAY_TITLE, SAVE_FAILED);
+    }
+}
+
+void MapWindow::exportStats()
+{
+    if(!gameStarted_ || gManager_->getStatsRecorder() == nullptr){
+        return;
+    }
+
+    QString path = QFileDialog::getSaveFileName(this, EXPORT_STATS_TITLE, "",
+                                                STATS_FILE_FILTER);
+    if(path.isEmpty()){
+        return;
+    }
+
+    std::shared_ptr<Game::StatsRecorder> recorder =
+            gManager_->getStatsRecorder();
+    bool written = path.endsWith(".csv", Qt::CaseInsensitive)
+            ? recorder->exportCsv(path) : recorder->exportBinary(path);
+    if(!written){
+        QMessageBox::warning(this, EXPORT_STATS_TITLE, SAVE_FAILED);
+    }
+}
+
+void MapWindow::updateProductionOverlay()
+{
+    if(!gameStarted_ || gScene_ == nullptr){
+        return;
+    }
+
+    // Forecasts are cached so refreshing every action is cheap
+    if(ui_->productionOverlay->isChecked()){
+        gScene_->showProductionValues(gManager_->getProductionValues());
+    } else {
+        gScene_->showProductionValues(std::vector<int>());
+    }
+}
+
+void MapWindow::loadGame()
+{
+    QString path = QFileDialog::getOpenFileName(this, LOAD_GAME_TITLE, "",
+                                                SNAPSHOT_FILE_FILTER);
+    if(path.isEmpty()){
+        return;
+    }
+
+    std::shared_ptr<Game::MapSnapshot> snapshot =
+            Game::MapSnapshot::open(path);
+    if(snapshot == nullptr){
+        QMessageBox::warning(this, LOAD_GAME_TITLE, LOAD_FAILED);
+        return;
+    }
+
+    createGame(snapshot->header().mapWidth, snapshot->header().mapHeight);
+    gManager_->setStatsRecorder(std::make_shared<Game::StatsRecorder>());
+    if(!gManager_->loadGame(snapshot)){
+        QMessageBox::warning(this, LOAD_GAME_TITLE, LOAD_FAILED);
+        resetGame();
+        return;
+    }
+
+    settingsDialog_->close();
+    gameReady();
+}
+
 void MapWindow::resetGame()
 {
     gameStarted_ = false;
+    // Drops the turn a computer player may still be planning
+    computerTurn_++;
+    cancelWorld();
+    ui_->gameButton->setEnabled(true);
 
     gManager_ = nullptr;
     geHandler_ = nullptr;
@@ -223,6 +559,12 @@ void MapWindow::adjustSettings()
     connect(ui_->openDialog,SIGNAL(triggered(bool)),this,SLOT(openDialog()));
     connect(ui_->newGame,SIGNAL(triggered(bool)),this,SLOT(resetGame()));
     connect(ui_->scoreBoard,SIGNAL(triggered(bool)),this,SLOT(openScoreDialog()));
+    connect(ui_->saveGame,SIGNAL(triggered(bool)),this,SLOT(saveGame()));
+    connect(ui_->loadGame,SIGNAL(triggered(bool)),this,SLOT(loadGame()));
+    connect(ui_->saveReplay,SIGNAL(triggered(bool)),this,SLOT(saveReplay()));
+    connect(ui_->exportStats,SIGNAL(triggered(bool)),this,SLOT(exportStats()));
+    connect(ui_->productionOverlay,SIGNAL(toggled(bool)),this,
+            SLOT(updateProductionOverlay()));
 
     // Buildings
     connect(ui_->buildButton,SIGNAL(clicked(bool)),this,
@@ -305,6 +647,23 @@ void MapWindow::updatePlayerInfo(const std::shared_ptr<Game::Player> &player)
                        ownerName
                        );
     }
+
+    updateLeaderboard();
+    updatePlacementHighlight();
+    updateProductionOverlay();
+}
+
+void MapWindow::updateLeaderboard()
+{
+    ui_->leaderboardList->clear();
+
+    int place = 0;
+    for(const Game::ScoreEntry& entry : gManager_->getScores()){
+        place++;
+        ui_->leaderboardList->addItem(QString::number(place) + ". " +
+                                      QString::fromStdString(entry.name) +
+                                      "  " + QString::number(entry.score));
+    }
 }
 
 void MapWindow::updateBuildingCost()
@@ -312,26 +671,14 @@ void MapWindow::updateBuildingCost()
     /* Get building cost and update it
      * Building button can change color based on this
      */
+    const Game::BuildingEntry* entry = Game::ObjectRegistry::building(
+                static_cast<Game::TypeTag>(
+                    ui_->buildingsBox->currentData().toInt()));
     QString path;
 
-    if(ui_->buildingsBox->currentText() == FARM){
-        setBuildingCost(Course::ConstResourceMaps::FARM_BUILD_COST);
-        path = FARM_IMAGE;
-    }else if(ui_->buildingsBox->currentText() == HQ){
-        setBuildingCost(Course::ConstResourceMaps::HQ_BUILD_COST);
-        path = HQ_IMAGE;
-    }else if(ui_->buildingsBox->currentText() == OUTPOST){
-        setBuildingCost(Course::ConstResourceMaps::OUTPOST_BUILD_COST);
-        path = OUTPOST_IMAGE;
-    }else if(ui_->buildingsBox->currentText() == MINE){
-        setBuildingCost(Game::MINE_BUILD_COST);
-        path = MINE_IMAGE;
-    }else if(ui_->buildingsBox->currentText() == FISHING_BOAT){
-        setBuildingCost(Game::FISHING_BOAT_BUILD_COST);
-        path = SHIP_IMAGE;
-    }else if(ui_->buildingsBox->currentText() == LAKE_COTTAGE){
-        setBuildingCost(Game::LAKE_COTTAGE_BUILD_COST);
-        path = LAKE_COTTAGE_IMAGE;
+    if(entry != nullptr){
+        setBuildingCost(entry->cost);
+        path = entry->image;
     }else{
         setBuildingCost(Game::RESOURCEMAP_ZERO);
         path = BUILDING_IMAGE;
@@ -340,6 +687,25 @@ void MapWindow::updateBuildingCost()
     ui_->buildCostLabel->setText("");
     ui_->selectedBuildingImage->setPixmap(QPixmap(path).
                                           scaled(50,50,Qt::KeepAspectRatio));
+    updatePlacementHighlight();
+}
+
+void MapWindow::updatePlacementHighlight()
+{
+    if(!gameStarted_ || gManager_ == nullptr || gScene_ == nullptr){
+        return;
+    }
+
+    const Game::BuildingEntry* entry = Game::ObjectRegistry::building(
+                static_cast<Game::TypeTag>(
+                    ui_->buildingsBox->currentData().toInt()));
+    if(entry == nullptr){
+        gScene_->highlightPlacement(Game::TileBitset());
+        return;
+    }
+    gScene_->highlightPlacement(gManager_->getObjectManager()->getPlacement(
+                                    entry->tag,
+                                    gManager_->getCurrentPlayer()));
 }
 void MapWindow::setBuildingCost(ResourceMap resources)
 {
@@ -381,7 +747,6 @@ void MapWindow::setBuildingCost(ResourceMap resources)
 void MapWindow::updateWorkersCost()
 {
     double count = ui_->workerSpinBox->value();
-    QString selectedWorker = ui_->workersBox->currentText();
     ResourceMap workerCost;
     ResourceMapDouble multiplyMap = {{BasicResource::MONEY, count},
                                      {BasicResource::FOOD, count},
@@ -389,17 +754,12 @@ void MapWindow::updateWorkersCost()
                                      {BasicResource::STONE, count},
                                      {BasicResource::WOOD,count}};
 
-    if (selectedWorker == WORKER_BASIC) {
-        workerCost = Course::ConstResourceMaps::BW_RECRUITMENT_COST;
-    } else if (selectedWorker == WORKER_FARMER) {
-        workerCost = Game::FARMER_RECRUITMENT_COST;
-    } else if (selectedWorker == WORKER_MINER) {
-        workerCost = Game::MINER_RECRUITMENT_COST;
+    const Game::WorkerEntry* entry = Game::ObjectRegistry::worker(
+                static_cast<Game::TypeTag>(
+                    ui_->workersBox->currentData().toInt()));
+    if(entry != nullptr){
+        workerCost = entry->cost;
     }
-    /* Waiting for later implementation
-     * else if (selectedWorker == WORKER_SABOTEUR) {
-
-    }*/
     setWorkersCost(multiplyResourceMap(workerCost,multiplyMap));
 }
 
@@ -569,6 +929,11 @@ void MapWindow::updateTileInfo(const QString &type, Game::MapItem* &item,
     updateTileProductionValues(item);
     updateWorkersInfo(item);
     updateBuildingsList(item);
+
+    // Tiles can be looked at while the world is still generated
+    if(!gameStarted_){
+        setButtonStateEnabled(false);
+    }
 }
 
 void MapWindow::updateTileProductionValues(Game::MapItem* item)
@@ -702,24 +1067,24 @@ void MapWindow::sellClicked()
 
     QString resource = ui_->shopBox->currentText();
     BasicResource resourceType = NONE;
-    int value = 0;
 
     if(resource == "Wood"){
-        value = ui_->shopAmountBox->value();
         resourceType = WOOD;
     } else if(resource == "Food"){
-        value = ui_->shopAmountBox->value();
         resourceType = FOOD;
     } else if(resource == "Stone"){
-        value = ui_->shopAmountBox->value();
         resourceType = STONE;
     } else if(resource == "Ore"){
-        value = ui_->shopAmountBox->value() * 2;
         resourceType = ORE;
     }
 
-    geHandler_->modifyResource(gManager_->getCurrentPlayer(), MONEY, value);
-    geHandler_->modifyResource(gManager_->getCurrentPlayer(), resourceType, -value);
+    try{
+        gManager_->sellResource(resourceType, ui_->shopAmountBox->value());
+    }
+    catch (const Course::BaseException &e){
+        ui_->shopCostLabel->setText(QString::fromStdString(e.msg()));
+        return;
+    }
 
     ui_->shopAmountBox->setValue(0);
     ui_->shopBox->setCurrentIndex(0);
@@ -764,12 +1129,10 @@ void MapWindow::workerAssigned()
         return;
     }
     try{
-        int loopValue = ui_->workerSpinBox->value();
-        for(int i=0; i<loopValue; i++){
-           gManager_->addWorkerOnTile(
-                        currentItem_, ui_->workersBox->currentText());
-            ui_->hireCostLabel->setText(WORKER_ADDED);
-        }
+        gManager_->addWorkersOnTile(currentItem_,
+                                    ui_->workersBox->currentText(),
+                                    ui_->workerSpinBox->value());
+        ui_->hireCostLabel->setText(WORKER_ADDED);
     }
     catch (const Course::BaseException &e){
         ui_->hireCostLabel->setText(QString::fromStdString(e.msg()));
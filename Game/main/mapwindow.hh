@@ -19,6 +19,11 @@
 #include <QDebug>
 #include <map>
 #include <QPropertyAnimation>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QProgressDialog>
+
+#include <atomic>
 
 namespace Ui {
 class MapWindow;
@@ -36,6 +41,15 @@ public:
     explicit MapWindow(QWidget *parent = 0);
     ~MapWindow();
 
+signals:
+
+    /**
+     * @brief Tells how much of the world of a new game has been generated
+     * @param columns - Columns on the map so far
+     * @param total - Columns of the whole map
+     */
+    void worldProgress(int columns, int total);
+
 public slots:
 
     /**
@@ -63,6 +77,34 @@ public slots:
      */
     void resetGame();
 
+    /**
+     * @brief Asks for a file and saves the running game to it
+     */
+    void saveGame();
+
+    /**
+     * @brief Asks for a snapshot file and continues the game saved in it
+     */
+    void loadGame();
+
+    /**
+     * @brief Asks for a file and saves the action log of the running game.
+     * The log can be checked with Game --replay <file>
+     */
+    void saveReplay();
+
+    /**
+     * @brief Asks for a file and exports the statistics of the running
+     * game. Files ending in .csv are written as CSV, others as binary.
+     */
+    void exportStats();
+
+    /**
+     * @brief Shows or hides the next turn production values on the map
+     * depending on the Production Overlay menu item
+     */
+    void updateProductionOverlay();
+
     /**
      * @brief Set game buttons for state
      * @param state true or false
@@ -93,11 +135,22 @@ public slots:
      */
     void updatePlayerInfo(const std::shared_ptr<Game::Player> &player);
 
+    /**
+     * @brief Updates the leaderboard tab with the current scores
+     */
+    void updateLeaderboard();
+
     /**
      * @brief Updates the building cost when player selects building
      */
     void updateBuildingCost();
 
+    /**
+     * @brief Highlights the tiles where the current player could place
+     * the selected building
+     */
+    void updatePlacementHighlight();
+
     /**
      * @brief Updates building cost values to GUI
      * @param resources - values to update
@@ -216,6 +269,59 @@ public slots:
     void freeWorkerClicked();
 
 private:
+    /**
+     * @brief Creates the game objects and the scene for a new map
+     * @param mapWidth in tiles
+     * @param mapHeight in tiles
+     */
+    void createGame(int mapWidth, int mapHeight);
+
+    /**
+     * @brief Updates the GUI after the game has started or was loaded
+     */
+    void gameReady();
+
+    /**
+     * @brief Generates the world of a started game in a pool thread.
+     * Chunks of columns are drawn as they come so the map can be looked
+     * at, the game is ready after the last one.
+     */
+    void generateWorld();
+
+    /**
+     * @brief Adds a generated chunk to the game
+     * @param generation - World generation the chunk belongs to
+     * @param tiles - Tiles of the chunk
+     * @param columns - Columns generated so far
+     * @param total - Columns of the map
+     * @note Chunks of cancelled generations are dropped
+     */
+    void addWorldChunk(quint64 generation,
+                       const std::vector<std::shared_ptr<Course::TileBase>>& tiles,
+                       unsigned int columns, unsigned int total);
+
+    /**
+     * @brief Stops the world generation that may be running
+     */
+    void cancelWorld();
+
+    /**
+     * @brief Starts the turn of the current player if the computer plays
+     * it, otherwise lets the player act.
+     * The policy thinks on a fork of the game in a pool thread so the
+     * window keeps responding, the actions are done in finishComputerTurn.
+     */
+    void playComputerTurn();
+
+    /**
+     * @brief Does the actions of a computer player and ends its turn
+     * @param turn - Computer turn the actions were planned for
+     * @param actions - Planned actions
+     * @note Actions planned before the game was reset are dropped
+     */
+    void finishComputerTurn(quint64 turn,
+                            const std::vector<Game::GameAction>& actions);
+
     /**
      * @brief Adjusts the current turn count
      * @param Turn number to put on
@@ -241,6 +347,14 @@ private:
 
     // Used to track gamestate for gameButton
     bool gameStarted_ = false;
+    // Counts the started computer turns and resets
+    quint64 computerTurn_ = 0;
+    // Counts the started world generations and resets
+    quint64 worldGeneration_ = 0;
+    // Set to stop the running world generation, shared with its thread
+    std::shared_ptr<std::atomic<bool>> worldCancel_ = nullptr;
+    // Progress of the world generation, owned by the window
+    QProgressDialog* worldDialog_ = nullptr;
     float zoomFactor_ = 1.5;
     float currentZoomLevel = 1;
 };
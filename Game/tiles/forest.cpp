@@ -23,10 +23,16 @@ std::string Forest::getType() const
     return "Forest";
 }
 
+Game::TypeTag Forest::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 void Forest::addBuilding(const std::shared_ptr<BuildingBase>& building)
 {
     TileBase::addBuilding(building);
     building->addHoldMarkers(1);
+    lockObjectManager()->tileProductionChanged(getCoordinate());
 }
 
 } // namespace Course
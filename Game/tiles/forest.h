@@ -23,6 +23,8 @@ namespace Course {
 class Forest : public TileBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::FOREST;
+
     /**
      * @brief Disabled parameterless constructor.
      */
@@ -51,6 +53,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
     /**
      * @brief Adds a new building-object to the tile. Building in forest adds
      * one hold-marker to the building.
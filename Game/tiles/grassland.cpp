@@ -23,4 +23,9 @@ std::string Grassland::getType() const
     return "Grassland";
 }
 
+Game::TypeTag Grassland::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 } // namespace Course
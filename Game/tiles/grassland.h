@@ -23,6 +23,8 @@ namespace Course {
 class Grassland : public TileBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::GRASSLAND;
+
     static const unsigned int MAX_BUILDINGS;
     static const unsigned int MAX_WORKERS;
     static const ResourceMap BASE_PRODUCTION;
@@ -54,6 +56,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
 }; // class Grassland
 
 } // namespace Course
@@ -20,4 +20,9 @@ std::string Game::Lake::getType() const
     return "Lake";
 }
 
+Game::TypeTag Game::Lake::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 }
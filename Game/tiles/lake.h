@@ -13,6 +13,8 @@ namespace Game {
 class Lake : public Course::TileBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::LAKE;
+
     Lake() = delete;
 
     Lake(const Course::Coordinate& location,
@@ -25,6 +27,8 @@ public:
     virtual ~Lake() = default;
 
     virtual std::string getType() const override;
+
+    virtual Game::TypeTag getTypeTag() const override;
 };
 
 }
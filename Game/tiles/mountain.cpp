@@ -20,4 +20,9 @@ std::string Mountain::getType() const
 {
     return "Mountain";
 }
+
+Game::TypeTag Mountain::getTypeTag() const
+{
+    return TYPE_TAG;
+}
 }
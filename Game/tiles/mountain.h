@@ -14,6 +14,8 @@ namespace Game {
 class Mountain : public Course::TileBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::MOUNTAIN;
+
     Mountain() = delete;
 
     Mountain(const Course::Coordinate& location,
@@ -26,6 +28,8 @@ public:
     virtual ~Mountain() = default;
 
     virtual std::string getType() const override;
+
+    virtual Game::TypeTag getTypeTag() const override;
  };
 
 }
@@ -20,4 +20,9 @@ std::string Game::Ocean::getType() const
     return "Ocean";
 }
 
+Game::TypeTag Game::Ocean::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 }
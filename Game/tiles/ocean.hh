@@ -13,6 +13,8 @@ namespace Game {
 class Ocean : public Course::TileBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::OCEAN;
+
     Ocean() = delete;
 
     Ocean(const Course::Coordinate& location,
@@ -25,6 +27,8 @@ public:
     virtual ~Ocean() = default;
 
     virtual std::string getType() const override;
+
+    virtual Game::TypeTag getTypeTag() const override;
 };
 
 }
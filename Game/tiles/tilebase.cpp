@@ -29,6 +29,11 @@ std::string TileBase::getType() const
     return "TileBase";
 }
 
+Game::TypeTag TileBase::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 void TileBase::addBuilding(const std::shared_ptr<BuildingBase>& building)
 {
     std::shared_ptr<TileBase> tile;
@@ -51,6 +56,8 @@ void TileBase::addBuilding(const std::shared_ptr<BuildingBase>& building)
     }
     building->setLocationTile(tile);
     m_buildings.push_back(building);
+    lockObjectManager()->tileBuildingsChanged(getCoordinate(),
+                                              hasSpaceForBuildings(1));
 }
 
 void TileBase::removeBuilding(const std::shared_ptr<BuildingBase>& building)
@@ -61,6 +68,8 @@ void TileBase::removeBuilding(const std::shared_ptr<BuildingBase>& building)
         {
             m_buildings.erase(it);
             building->setLocationTile(nullptr);
+            lockObjectManager()->tileBuildingsChanged(
+                        getCoordinate(), hasSpaceForBuildings(1));
             return;
         }
     }
@@ -90,6 +99,7 @@ void TileBase::addWorker(const std::shared_ptr<WorkerBase>& worker)
     }
     worker->setLocationTile(tile);
     m_workers.push_back(worker);
+    lockObjectManager()->tileProductionChanged(getCoordinate());
 }
 
 void TileBase::removeWorker(const std::shared_ptr<WorkerBase>& worker)
@@ -101,6 +111,7 @@ void TileBase::removeWorker(const std::shared_ptr<WorkerBase>& worker)
         {
             m_workers.erase(it);
             worker->setLocationTile(nullptr);
+            lockObjectManager()->tileProductionChanged(getCoordinate());
             return;
         }
     }
@@ -135,7 +146,8 @@ bool TileBase::generateResources()
          build_it != m_buildings.end();
          ++build_it)
     {
-        ResourceMap current_production = build_it->lock()->getProduction();
+        std::shared_ptr<BuildingBase> building = build_it->lock();
+        ResourceMap current_production = building->getProduction();
 
         total_production = mergeResourceMaps(total_production,
                                              current_production);
@@ -32,6 +32,8 @@ namespace Course {
 class TileBase : public GameObject
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::TILE;
+
     const unsigned int MAX_BUILDINGS;
     const unsigned int MAX_WORKERS;
     const ResourceMap BASE_PRODUCTION;
@@ -63,6 +65,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
     /**
      * @brief Adds a new Building-object to the tile.
      *
@@ -28,6 +28,11 @@ std::string BasicWorker::getType() const
     return "BasicWorker";
 }
 
+Game::TypeTag BasicWorker::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 bool BasicWorker::canBePlacedOnTile(const std::shared_ptr<TileBase> &target) const
 {
     return target->getOwner() == getOwner() and
@@ -41,39 +46,7 @@ void BasicWorker::doSpecialAction()
 
 const ResourceMapDouble BasicWorker::tileWorkAction()
 {
-    auto player = getOwner();
-    auto events = lockEventHandler();
-    double satisfaction = 0;
-    BasicResource focus = getResourceFocus();
-
-    ResourceMapDouble final_modifier;
-
-    if ( events->modifyResource(player, BasicResource::FOOD, -1) )
-    {
-        satisfaction = 0.5;
-        if ( events->modifyResource(player, BasicResource::MONEY, -1) )
-        {
-            satisfaction = 1;
-        }
-    }
-
-
-    if( focus != BasicResource::NONE )
-    {
-        final_modifier[focus] =
-                WORKER_EFFICIENCY.at(focus) * (satisfaction + 0.25);
-    }
-    else
-    {
-        for( auto it = WORKER_EFFICIENCY.begin();
-             it != WORKER_EFFICIENCY.end();
-             ++it )
-        {
-            final_modifier[it->first] = it->second * satisfaction;
-        }
-    }
-
-    return final_modifier;
+    return workEfficiency(getSatisfaction());
 }
 
 
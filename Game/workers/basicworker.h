@@ -26,6 +26,8 @@ namespace Course {
 class BasicWorker : public WorkerBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::BASIC_WORKER;
+
     /**
      * @brief Disabled parameterless constructor.
      */
@@ -48,6 +50,24 @@ public:
                     ConstResourceMaps::BW_WORKER_EFFICIENCY
                 );
 
+    /**
+     * @brief Cost and efficiency maps are kept by reference, temporaries
+     * are not accepted.
+     */
+    BasicWorker(const std::shared_ptr<iGameEventHandler>& eventhandler,
+                const std::shared_ptr<iObjectManager>& objectmanager,
+                const std::shared_ptr<PlayerBase>& owner,
+                const int& tilespaces,
+                ResourceMap&& cost,
+                const ResourceMapDouble& efficiency =
+                    ConstResourceMaps::BW_WORKER_EFFICIENCY) = delete;
+    BasicWorker(const std::shared_ptr<iGameEventHandler>& eventhandler,
+                const std::shared_ptr<iObjectManager>& objectmanager,
+                const std::shared_ptr<PlayerBase>& owner,
+                const int& tilespaces,
+                const ResourceMap& cost,
+                ResourceMapDouble&& efficiency) = delete;
+
     /**
      * @brief Default destructor.
      */
@@ -58,6 +78,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
     /**
      * @brief Check if the worker can be placed on the Tile according to
      * it's placement rule. Only rule is that the Tile must have same owner
@@ -80,8 +105,8 @@ public:
 
     /**
      * @brief Returns Worker's efficiency at resource production.
-     * Worker consumes FOOD and MONEY. Resource consumption and resource
-     * focus determine final multiplier that is based on WORKER_EFFICIENCY.
+     * The satisfaction set in the upkeep phase and resource focus
+     * determine final multiplier that is based on WORKER_EFFICIENCY.
      * 
      * @return 
      */
@@ -17,6 +17,8 @@ namespace Game {
 class Miner : public Course::WorkerBase
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::MINER;
+
     /**
      * @brief Disabled parameterless constructor.
      */
@@ -39,6 +41,23 @@ public:
                    MINER_EFFICIENCY
                 );
 
+    /**
+     * @brief Cost and efficiency maps are kept by reference, temporaries
+     * are not accepted.
+     */
+    Miner(const std::shared_ptr<GameEventHandler>& eventhandler,
+          const std::shared_ptr<ObjectManager>& objectmanager,
+          const std::shared_ptr<PlayerBase>& owner,
+          const int& tilespaces,
+          ResourceMap&& cost,
+          const ResourceMapDouble& efficiency = MINER_EFFICIENCY) = delete;
+    Miner(const std::shared_ptr<GameEventHandler>& eventhandler,
+          const std::shared_ptr<ObjectManager>& objectmanager,
+          const std::shared_ptr<PlayerBase>& owner,
+          const int& tilespaces,
+          const ResourceMap& cost,
+          ResourceMapDouble&& efficiency) = delete;
+
     /**
      * @brief Default destructor.
      */
@@ -49,6 +68,11 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
     /**
      * @brief Check if the worker can be placed on the Tile according to
      * it's placement rule. Only rule is that the Tile must have same owner
@@ -71,8 +95,8 @@ public:
 
     /**
      * @brief Returns Worker's efficiency at resource production.
-     * Worker consumes FOOD and MONEY. Resource consumption and resource
-     * focus determine final multiplier that is based on WORKER_EFFICIENCY.
+     * The satisfaction set in the upkeep phase and resource focus
+     * determine final multiplier that is based on WORKER_EFFICIENCY.
      *
      * @return
      */
@@ -20,7 +20,8 @@ WorkerBase::WorkerBase(const std::shared_ptr<iGameEventHandler>& eventhandler,
                         tilespaces),
     WORKER_EFFICIENCY(efficiency),
     RECRUITMENT_COST(cost),
-    m_resource_focus(BasicResource::NONE)
+    m_resource_focus(BasicResource::NONE),
+    m_satisfaction(0)
 {
 }
 
@@ -29,12 +30,50 @@ std::string WorkerBase::getType() const
     return "WorkerBase";
 }
 
+Game::TypeTag WorkerBase::getTypeTag() const
+{
+    return TYPE_TAG;
+}
+
 
 const ResourceMapDouble WorkerBase::tileWorkAction()
 {
     return WORKER_EFFICIENCY;
 }
 
+ResourceMapDouble WorkerBase::workEfficiency(double satisfaction) const
+{
+    BasicResource focus = getResourceFocus();
+    ResourceMapDouble final_modifier;
+
+    if( focus != BasicResource::NONE )
+    {
+        final_modifier[focus] =
+                WORKER_EFFICIENCY.at(focus) * (satisfaction + 0.25);
+    }
+    else
+    {
+        for( auto it = WORKER_EFFICIENCY.begin();
+             it != WORKER_EFFICIENCY.end();
+             ++it )
+        {
+            final_modifier[it->first] = it->second * satisfaction;
+        }
+    }
+
+    return final_modifier;
+}
+
+void WorkerBase::setSatisfaction(double satisfaction)
+{
+    m_satisfaction = satisfaction;
+}
+
+double WorkerBase::getSatisfaction() const
+{
+    return m_satisfaction;
+}
+
 void WorkerBase::setResourceFocus(BasicResource new_focus)
 {
     m_resource_focus = new_focus;
@@ -3,6 +3,7 @@
 
 #include "core/placeablegameobject.h"
 #include "core/basicresources.h"
+#include "core/resourcemaps.h"
 
 
 namespace Course {
@@ -16,21 +17,48 @@ namespace Course {
 class WorkerBase : public PlaceableGameObject
 {
 public:
+    static constexpr Game::TypeTag TYPE_TAG = Game::TypeTag::WORKER;
 
-    const ResourceMapDouble WORKER_EFFICIENCY;
-    const ResourceMap RECRUITMENT_COST;
+
+    // Refer to the shared definitions of the type, see resourcemaps.h
+    const ResourceMapDouble& WORKER_EFFICIENCY;
+    const ResourceMap& RECRUITMENT_COST;
 
     /**
      * @brief Disabled parameterless constructor.
      */
     WorkerBase() = delete;
 
+    /**
+     * @brief Constructor for the class.
+     * @note cost and efficiency are not copied. Pass maps with static
+     * storage, such as the ones in resourcemaps.h.
+     */
     WorkerBase(const std::shared_ptr<iGameEventHandler>& eventhandler,
                const std::shared_ptr<iObjectManager>& objectmanager,
                const std::shared_ptr<PlayerBase>& owner,
                const int& tilespaces = 1,
-               const ResourceMap& cost = {},
-               const ResourceMapDouble& efficiency = {});
+               const ResourceMap& cost = ConstResourceMaps::EMPTY,
+               const ResourceMapDouble& efficiency =
+                    ConstResourceMaps::EMPTY_DOUBLE);
+
+    /**
+     * @brief Cost and efficiency maps are kept by reference, temporaries
+     * are not accepted.
+     */
+    WorkerBase(const std::shared_ptr<iGameEventHandler>& eventhandler,
+               const std::shared_ptr<iObjectManager>& objectmanager,
+               const std::shared_ptr<PlayerBase>& owner,
+               const int& tilespaces,
+               ResourceMap&& cost,
+               const ResourceMapDouble& efficiency =
+                   ConstResourceMaps::EMPTY_DOUBLE) = delete;
+    WorkerBase(const std::shared_ptr<iGameEventHandler>& eventhandler,
+               const std::shared_ptr<iObjectManager>& objectmanager,
+               const std::shared_ptr<PlayerBase>& owner,
+               const int& tilespaces,
+               const ResourceMap& cost,
+               ResourceMapDouble&& efficiency) = delete;
 
     /**
      * @brief Default destructor.
@@ -44,6 +72,31 @@ public:
      */
     virtual const ResourceMapDouble tileWorkAction();
 
+    /**
+     * @brief Calculates the working efficiency for a satisfaction level.
+     * A focused worker only works its focus resource.
+     * @param satisfaction 0 when hungry, 0.5 when fed and 1 when also paid.
+     * @return Returns the working efficiency.
+     * @post Exception guarantee: Strong
+     * @note Used by tileWorkAction and production forecasts.
+     */
+    ResourceMapDouble workEfficiency(double satisfaction) const;
+
+    /**
+     * @brief Sets how well the worker is fed and paid for the next
+     * tileWorkAction.
+     * @param satisfaction 0 when hungry, 0.5 when fed and 1 when also paid.
+     * @post Exception guarantee: No-throw
+     * @note Set by the upkeep phase of the turn, see core/upkeep.hh.
+     */
+    void setSatisfaction(double satisfaction);
+
+    /**
+     * @brief Returns the satisfaction set by setSatisfaction, 0 by default.
+     * @post Exception guarantee: No-throw
+     */
+    double getSatisfaction() const;
+
     /**
      * @brief Performs the Worker's special action. (If any)
      *
@@ -83,8 +136,14 @@ public:
      */
     virtual std::string getType() const override;
 
+    /**
+     * @copydoc GameObject::getTypeTag()
+     */
+    virtual Game::TypeTag getTypeTag() const override;
+
 private:
     BasicResource m_resource_focus;
+    double m_satisfaction;
 
 
 }; // class WorkerBase
@@ -0,0 +1,134 @@
+TARGET = Tournament
+TEMPLATE = app
+
+QT       += core gui widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# Scoped timers of the hot paths, see core/profiler.hh. Build with
+# qmake CONFIG+=profiling and run with --profile <prefix>
+CONFIG(profiling): DEFINES += PV_PROFILING
+
+INCLUDEPATH += ../Game
+DEPENDPATH += ../Game
+
+SOURCES += \
+    main.cpp \
+    tournament.cpp \
+    ../Game/ai/randompolicy.cpp \
+    ../Game/ai/scriptedpolicy.cpp \
+    ../Game/interfaces/gameeventhandler.cpp \
+    ../Game/graphics/gamescene.cpp \
+    ../Game/interfaces/objectmanager.cpp \
+    ../Game/graphics/mapitem.cpp \
+    ../Game/core/gamemanager.cpp \
+    ../Game/core/mapsnapshot.cpp \
+    ../Game/core/actionlog.cpp \
+    ../Game/core/replayengine.cpp \
+    ../Game/tiles/mountain.cpp \
+    ../Game/core/worldgeneratorperlin.cpp \
+    ../Game/core/biomeconfig.cpp \
+    ../Game/core/objectregistry.cpp \
+    ../Game/core/objectpool.cpp \
+    ../Game/core/scoreledger.cpp \
+    ../Game/core/actionerror.cpp \
+    ../Game/core/productionforecast.cpp \
+    ../Game/core/upkeep.cpp \
+    ../Game/core/steadyturns.cpp \
+    ../Game/core/turntimers.cpp \
+    ../Game/ai/montecarlopolicy.cpp \
+    ../Game/core/profiler.cpp \
+    ../Game/core/statsrecorder.cpp \
+    ../Game/core/perlinnoise.cpp \
+    ../Game/tiles/lake.cpp \
+    ../Game/tiles/ocean.cpp \
+    ../Game/buildings/mine.cpp \
+    ../Game/core/player.cpp \
+    ../Game/workers/farmer.cpp \
+    ../Game/buildings/cottage.cpp \
+    ../Game/buildings/fishingboat.cpp \
+    ../Game/workers/miner.cpp \
+    ../Game/buildings/buildingbase.cpp \
+    ../Game/buildings/headquarters.cpp \
+    ../Game/buildings/outpost.cpp \
+    ../Game/buildings/farm.cpp \
+    ../Game/tiles/grassland.cpp \
+    ../Game/tiles/forest.cpp \
+    ../Game/tiles/tilebase.cpp \
+    ../Game/workers/basicworker.cpp \
+    ../Game/workers/workerbase.cpp \
+    ../Game/core/placeablegameobject.cpp \
+    ../Game/core/worldgenerator.cpp \
+    ../Game/core/coordinate.cpp \
+    ../Game/core/playerbase.cpp \
+    ../Game/core/gameobject.cpp \
+    ../Game/core/basicresources.cpp
+
+HEADERS += \
+    tournament.hh \
+    ../Game/ai/playerpolicy.hh \
+    ../Game/ai/randompolicy.hh \
+    ../Game/ai/scriptedpolicy.hh \
+    ../Game/constants/constants.hh \
+    ../Game/interfaces/gameeventhandler.hh \
+    ../Game/graphics/gamescene.hh \
+    ../Game/interfaces/objectmanager.hh \
+    ../Game/graphics/mapitem.hh \
+    ../Game/core/gamemanager.hh \
+    ../Game/core/mapsnapshot.hh \
+    ../Game/core/actionlog.hh \
+    ../Game/core/replayengine.hh \
+    ../Game/tiles/mountain.h \
+    ../Game/core/worldgeneratorperlin.hh \
+    ../Game/core/biomeconfig.hh \
+    ../Game/core/typetags.hh \
+    ../Game/core/objectregistry.hh \
+    ../Game/core/objectpool.hh \
+    ../Game/core/scoreledger.hh \
+    ../Game/core/actionerror.hh \
+    ../Game/core/productionforecast.hh \
+    ../Game/core/upkeep.hh \
+    ../Game/core/steadyturns.hh \
+    ../Game/core/turntimers.hh \
+    ../Game/ai/montecarlopolicy.hh \
+    ../Game/core/profiler.hh \
+    ../Game/core/tilebitset.hh \
+    ../Game/core/statsrecorder.hh \
+    ../Game/core/neighbourrange.hh \
+    ../Game/core/perlinnoise.hh \
+    ../Game/tiles/lake.h \
+    ../Game/tiles/ocean.hh \
+    ../Game/buildings/mine.h \
+    ../Game/core/player.hh \
+    ../Game/constants/resourcemaps2.h \
+    ../Game/workers/farmer.hh \
+    ../Game/buildings/cottage.h \
+    ../Game/buildings/fishingboat.hh \
+    ../Game/workers/miner.hh \
+    ../Game/buildings/buildingbase.h \
+    ../Game/buildings/farm.h \
+    ../Game/buildings/headquarters.h \
+    ../Game/buildings/outpost.h \
+    ../Game/exceptions/baseexception.h \
+    ../Game/exceptions/keyerror.h \
+    ../Game/exceptions/ownerconflict.h \
+    ../Game/exceptions/invalidpointer.h \
+    ../Game/exceptions/illegalaction.h \
+    ../Game/exceptions/notenoughspace.h \
+    ../Game/interfaces/iobjectmanager.h \
+    ../Game/interfaces/igameeventhandler.h \
+    ../Game/tiles/grassland.h \
+    ../Game/tiles/forest.h \
+    ../Game/tiles/tilebase.h \
+    ../Game/workers/basicworker.h \
+    ../Game/workers/workerbase.h \
+    ../Game/core/basicresources.h \
+    ../Game/core/placeablegameobject.h \
+    ../Game/core/worldgenerator.h \
+    ../Game/core/coordinate.h \
+    ../Game/core/playerbase.h \
+    ../Game/core/gameobject.h \
+    ../Game/core/resourcemaps.h
@@ -0,0 +1,108 @@
+#include "tournament.hh"
+#include "core/profiler.hh"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+
+#include <fstream>
+#include <iostream>
+
+/**
+ * Plays many games between computer players without graphics, for example
+ * Tournament --games 1000 --policies random,scripted --format jsonl
+ * Tournament --games 100 --policies mcts,scripted --ai-budget 50
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("Tournament");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+                "Plays headless games between computer players in parallel "
+                "and writes the scores.");
+    parser.addHelpOption();
+
+    QCommandLineOption games("games", "Number of games.", "n", "100");
+    QCommandLineOption threads("threads", "Worker threads, 0 for all cores.",
+                               "n", "0");
+    QCommandLineOption turns("turns", "Turns per game.", "n", "30");
+    QCommandLineOption width("width", "Map width.", "n", "30");
+    QCommandLineOption height("height", "Map height.", "n", "20");
+    QCommandLineOption seed("seed", "World seed of the first game.", "n", "1");
+    QCommandLineOption policies("policies",
+                                "Comma separated policy per player: "
+                                "random, scripted or mcts.",
+                                "list", "random,scripted");
+    QCommandLineOption budget("ai-budget",
+                              "Thinking time of mcts players per turn in "
+                              "milliseconds.",
+                              "ms", "100");
+    QCommandLineOption format("format", "csv or jsonl.", "format", "csv");
+    QCommandLineOption output("output", "Result file, stdout by default.",
+                              "file");
+    QCommandLineOption profile("profile",
+                               "Writes prefix.trace.json and "
+                               "prefix.turns.csv, needs a build with "
+                               "CONFIG+=profiling.",
+                               "prefix");
+    parser.addOptions({games, threads, turns, width, height, seed, policies,
+                       budget, format, output, profile});
+    parser.process(app);
+
+    Game::TournamentSettings settings;
+    settings.games = parser.value(games).toInt();
+    settings.threads = parser.value(threads).toInt();
+    settings.turns = parser.value(turns).toInt();
+    settings.mapWidth = parser.value(width).toInt();
+    settings.mapHeight = parser.value(height).toInt();
+    settings.firstSeed = parser.value(seed).toInt();
+    settings.aiBudget = parser.value(budget).toInt();
+
+    settings.policies.clear();
+    for(const QString& policy : parser.value(policies).split(",")){
+        std::string name = policy.trimmed().toStdString();
+        if(Game::Tournament::createPolicy(name, 0) == nullptr){
+            std::cerr << "Unknown policy " << name << std::endl;
+            return 1;
+        }
+        settings.policies.push_back(name);
+    }
+
+    if(parser.value(format) == "jsonl"){
+        settings.format = Game::ResultFormat::JSON_LINES;
+    } else if(parser.value(format) != "csv"){
+        std::cerr << "Unknown format " << parser.value(format).toStdString()
+                  << std::endl;
+        return 1;
+    }
+
+    Game::Tournament tournament(settings);
+    if(parser.isSet(output)){
+        std::ofstream file(parser.value(output).toStdString());
+        if(!file){
+            std::cerr << "Could not write "
+                      << parser.value(output).toStdString() << std::endl;
+            return 1;
+        }
+        tournament.run(file);
+    } else {
+        tournament.run(std::cout);
+    }
+
+    if(parser.isSet(profile)){
+#ifdef PV_PROFILING
+        QString prefix = parser.value(profile);
+        if(!Game::Profiler::getInstance().writeFiles(prefix)){
+            std::cerr << "Could not write the profile "
+                      << prefix.toStdString() << std::endl;
+            return 1;
+        }
+#else
+        std::cerr << "Built without profiling, rebuild with "
+                     "CONFIG+=profiling" << std::endl;
+#endif
+    }
+
+    return 0;
+}
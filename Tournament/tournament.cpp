@@ -0,0 +1,207 @@
+#include "tournament.hh"
+#include "ai/montecarlopolicy.hh"
+#include "ai/randompolicy.hh"
+#include "ai/scriptedpolicy.hh"
+
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <iomanip>
+
+namespace Game {
+
+namespace {
+
+/**
+ * @brief Plays one game on a pool thread and hands the result over
+ */
+class GameTask : public QRunnable
+{
+public:
+    GameTask(Tournament& tournament, const TournamentSettings& settings,
+             int game) :
+        tournament_(tournament),
+        settings_(settings),
+        game_(game)
+    {
+    }
+
+    void run() override
+    {
+        tournament_.writeResult(Tournament::playGame(settings_, game_));
+    }
+
+private:
+    Tournament& tournament_;
+    const TournamentSettings& settings_;
+    int game_;
+};
+
+/**
+ * @brief Escapes a string for JSON
+ */
+std::string jsonString(const std::string& value)
+{
+    std::ostringstream escaped;
+    escaped << '"';
+    for(char c : value){
+        if(c == '"' || c == '\\'){
+            escaped << '\\' << c;
+        } else if(static_cast<unsigned char>(c) < 0x20){
+            escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                    << static_cast<int>(c) << std::dec;
+        } else {
+            escaped << c;
+        }
+    }
+    escaped << '"';
+    return escaped.str();
+}
+
+}
+
+Tournament::Tournament(const TournamentSettings &settings) :
+    settings_(settings)
+{
+}
+
+int Tournament::run(std::ostream &output)
+{
+    output_ = &output;
+    gamesPlayed_ = 0;
+
+    if(settings_.format == ResultFormat::CSV){
+        output << "game,seed,player,policy,score,rank\n";
+    }
+
+    QThreadPool pool;
+    if(settings_.threads > 0){
+        pool.setMaxThreadCount(settings_.threads);
+    }
+
+    for(int game=0; game<settings_.games; game++){
+        pool.start(new GameTask(*this, settings_, game));
+    }
+    pool.waitForDone();
+
+    output.flush();
+    return gamesPlayed_;
+}
+
+GameResult Tournament::playGame(const TournamentSettings &settings, int game)
+{
+    GameResult result;
+    result.game = game;
+    result.seed = settings.firstSeed + game;
+
+    std::shared_ptr<GameEventHandler> geh =
+            std::make_shared<GameEventHandler>();
+    std::shared_ptr<ObjectManager> om = std::make_shared<ObjectManager>();
+    GameManager manager(geh, om, nullptr, nullptr);
+
+    // Policy seeds depend only on the game and seat, not on the thread
+    std::seed_seq seeds{result.seed, game,
+                        static_cast<int>(settings.policies.size())};
+    std::vector<unsigned int> policySeeds(settings.policies.size());
+    seeds.generate(policySeeds.begin(), policySeeds.end());
+
+    // Zero padded names keep the alphabetical turn order the seat order
+    std::vector<std::unique_ptr<PlayerPolicy>> policies;
+    for(unsigned int i=0; i<settings.policies.size(); i++){
+        std::ostringstream name;
+        name << "P" << std::setw(2) << std::setfill('0') << i + 1;
+        manager.addPlayer(std::make_pair(
+                              QString::fromStdString(name.str()),
+                              QColor::fromHsv(i * 360 / settings.policies.size(),
+                                              255, 255)));
+        policies.push_back(createPolicy(settings.policies.at(i),
+                                        policySeeds.at(i),
+                                        settings.aiBudget));
+    }
+
+    manager.setTurnCount(settings.turns);
+    manager.setMapSize(settings.mapWidth, settings.mapHeight);
+    manager.setSeed(result.seed);
+    if(!manager.startGame()){
+        return result;
+    }
+
+    while(!manager.gameOver_){
+        policies.at(manager.getCurrentPlayerIndex())->playTurn(manager);
+        manager.endTurn();
+    }
+
+    std::vector<std::pair<std::string, int>> scores =
+            manager.getPlayerScores();
+    for(unsigned int i=0; i<scores.size(); i++){
+        result.players.push_back({scores.at(i).first,
+                                  settings.policies.at(i),
+                                  scores.at(i).second});
+    }
+
+    return result;
+}
+
+std::unique_ptr<PlayerPolicy> Tournament::createPolicy(const std::string &name,
+                                                       unsigned int seed,
+                                                       int budget)
+{
+    if(name == "random"){
+        return std::make_unique<RandomPolicy>(seed);
+    } else if(name == "scripted"){
+        return std::make_unique<ScriptedPolicy>();
+    } else if(name == "mcts"){
+        MonteCarloSettings settings;
+        settings.budget = budget;
+        settings.threads = 1;
+        settings.seed = seed;
+        return std::make_unique<MonteCarloPolicy>(settings);
+    }
+    return nullptr;
+}
+
+void Tournament::writeResult(const GameResult &result)
+{
+    // Players with equal scores share the rank
+    std::vector<int> ranks;
+    for(const PlayerResult& player : result.players){
+        ranks.push_back(1 + std::count_if(result.players.begin(),
+                                          result.players.end(),
+                                          [&player](const PlayerResult& other){
+            return other.score > player.score;
+        }));
+    }
+
+    std::ostringstream text;
+    if(settings_.format == ResultFormat::CSV){
+        for(unsigned int i=0; i<result.players.size(); i++){
+            const PlayerResult& player = result.players.at(i);
+            text << result.game << "," << result.seed << "," << player.name
+                 << "," << player.policy << "," << player.score << ","
+                 << ranks.at(i) << "\n";
+        }
+    } else {
+        text << "{\"game\":" << result.game << ",\"seed\":" << result.seed
+             << ",\"players\":[";
+        for(unsigned int i=0; i<result.players.size(); i++){
+            const PlayerResult& player = result.players.at(i);
+            text << (i == 0 ? "" : ",")
+                 << "{\"name\":" << jsonString(player.name)
+                 << ",\"policy\":" << jsonString(player.policy)
+                 << ",\"score\":" << player.score
+                 << ",\"rank\":" << ranks.at(i) << "}";
+        }
+        text << "]}\n";
+    }
+
+    QMutexLocker lock(&outputMutex_);
+    *output_ << text.str();
+    output_->flush();
+    gamesPlayed_++;
+}
+
+}
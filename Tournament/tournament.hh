@@ -0,0 +1,127 @@
+#ifndef TOURNAMENT_HH
+#define TOURNAMENT_HH
+
+#include "ai/playerpolicy.hh"
+
+#include <QMutex>
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Game {
+
+/**
+ * @brief Format the results are written in
+ */
+enum class ResultFormat {
+    CSV,
+    JSON_LINES
+};
+
+/**
+ * @brief Settings shared by every game of a tournament
+ */
+struct TournamentSettings
+{
+    int games = 100;
+    // 0 uses every core
+    int threads = 0;
+    int turns = 30;
+    int mapWidth = 30;
+    int mapHeight = 20;
+    // Game n uses the world seed firstSeed + n
+    int firstSeed = 1;
+    // One policy name per player, see Tournament::createPolicy
+    std::vector<std::string> policies = {"random", "scripted"};
+    // Thinking time of searching policies per turn in milliseconds
+    int aiBudget = 100;
+    ResultFormat format = ResultFormat::CSV;
+};
+
+/**
+ * @brief Final score of one player
+ */
+struct PlayerResult
+{
+    std::string name;
+    std::string policy;
+    int score;
+};
+
+/**
+ * @brief Result of one game
+ */
+struct GameResult
+{
+    int game;
+    int seed;
+    std::vector<PlayerResult> players;
+};
+
+/**
+ * @brief The Tournament class plays many headless games in parallel.
+ * Every game has its own ObjectManager, GameEventHandler and policies
+ * with their own random generators, so games don't share any state and
+ * a game gives the same result on any thread.
+ * Results are written as soon as each game ends.
+ */
+class Tournament
+{
+public:
+    /**
+     * @brief Constructor for the class
+     * @param settings - Tournament settings
+     */
+    explicit Tournament(const TournamentSettings& settings);
+
+    /**
+     * @brief Plays all games and writes the results
+     * @param output - Stream the results are written to
+     * @post Exception guarantee: Basic
+     * @return Number of games played
+     */
+    int run(std::ostream& output);
+
+    /**
+     * @brief Plays one game to the end
+     * @param settings - Tournament settings
+     * @param game - Index of the game
+     * @post Exception guarantee: Basic
+     * @return Scores of the game
+     */
+    static GameResult playGame(const TournamentSettings& settings, int game);
+
+    /**
+     * @brief Creates a policy by name
+     * @param name - "random", "scripted" or "mcts"
+     * @param seed - Seed for policies that make random choices
+     * @param budget - Thinking time of searching policies per turn in
+     * milliseconds
+     * @return Policy or nullptr if the name is unknown
+     * @note Searching policies use one thread, the games already run on
+     * every core
+     */
+    static std::unique_ptr<PlayerPolicy> createPolicy(const std::string& name,
+                                                      unsigned int seed,
+                                                      int budget = 100);
+
+    /**
+     * @brief Writes the result of a game
+     * @param result - Game result
+     * @post Exception guarantee: Basic
+     * @note Thread safe
+     */
+    void writeResult(const GameResult& result);
+
+private:
+    TournamentSettings settings_;
+    std::ostream* output_ = nullptr;
+    QMutex outputMutex_;
+    int gamesPlayed_ = 0;
+};
+
+}
+
+#endif // TOURNAMENT_HH
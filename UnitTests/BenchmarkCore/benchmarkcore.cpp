@@ -0,0 +1,404 @@
+#include <QString>
+#include <QtTest>
+#include <ai/montecarlopolicy.hh>
+#include <ai/scriptedpolicy.hh>
+#include <core/basicresources.h>
+#include <core/gamemanager.hh>
+#include <core/perlinnoise.hh>
+#include <core/worldgeneratorperlin.hh>
+#include <graphics/gamescene.hh>
+#include <interfaces/gameeventhandler.hh>
+#include <interfaces/objectmanager.hh>
+
+#include <memory>
+
+using namespace Game;
+
+namespace {
+
+const int PLAYER_COUNT = 4;
+const int BENCH_SEED = 1;
+const int BENCH_TILE_SIZE = 50;
+
+/**
+ * @brief A game set up for a benchmark. The scene is optional.
+ */
+struct BenchGame
+{
+    std::shared_ptr<GameEventHandler> geh;
+    // Qualified, gamescene.hh declares a global ObjectManager too
+    std::shared_ptr<Game::ObjectManager> om;
+    std::shared_ptr<GameScene> scene;
+    std::unique_ptr<GameManager> manager;
+};
+
+/**
+ * @brief Starts a game and lets scripted players build for some rounds
+ * @param rounds - Rounds played before measuring, more rounds give more
+ * owned tiles, buildings and workers
+ * @param withScene - Creates a GameScene for the drawing benchmarks
+ */
+BenchGame startGame(int width, int height, int rounds, bool withScene)
+{
+    BenchGame game;
+    game.geh = std::make_shared<GameEventHandler>();
+    game.om = std::make_shared<Game::ObjectManager>();
+    if(withScene){
+        game.scene = std::make_shared<GameScene>(width, height,
+                                                 BENCH_TILE_SIZE,
+                                                 game.om.get());
+    }
+    game.manager = std::make_unique<GameManager>(game.geh, game.om,
+                                                 game.scene, nullptr);
+
+    for(int i=0; i<PLAYER_COUNT; i++){
+        game.manager->addPlayer(std::make_pair(
+                                    "P" + QString::number(i + 1),
+                                    QColor::fromHsv(i * 360 / PLAYER_COUNT,
+                                                    255, 255)));
+    }
+    // Long enough that measuring endTurn never ends the game
+    game.manager->setTurnCount(1000000);
+    game.manager->setMapSize(width, height);
+    game.manager->setSeed(BENCH_SEED);
+    game.manager->startGame();
+
+    ScriptedPolicy policy;
+    for(int i=0; i<rounds * PLAYER_COUNT; i++){
+        policy.playTurn(*game.manager);
+        game.manager->endTurn();
+    }
+    return game;
+}
+
+/**
+ * @brief Adds the map size rows shared by most benchmarks
+ */
+void addSizeRows()
+{
+    QTest::newRow("30x20") << 30 << 20;
+    QTest::newRow("60x40") << 60 << 40;
+    QTest::newRow("120x80") << 120 << 80;
+}
+
+/**
+ * @brief Adds map size and object density rows. Density is the amount of
+ * rounds scripted players have built before measuring.
+ */
+void addDensityRows()
+{
+    for(int size : {30, 60}){
+        for(int rounds : {0, 10, 30}){
+            QString name = QString::number(size) + "x" +
+                    QString::number(size * 2 / 3) + " rounds " +
+                    QString::number(rounds);
+            QTest::newRow(name.toStdString().c_str())
+                    << size << size * 2 / 3 << rounds;
+        }
+    }
+}
+
+}
+
+/**
+ * @brief The BenchmarkCore class measures the core subsystems over map
+ * sizes and object densities with QBENCHMARK.
+ *
+ * Results are machine readable with the QTest loggers, for example
+ * benchmarkcore -o results.csv,csv or benchmarkcore -o results.xml,xml
+ * Build in release mode, debug builds measure the wrong thing.
+ */
+class BenchmarkCore : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    /**
+     * @brief Measures the noise used by the world generator
+     */
+    void benchPerlinNoise_data();
+    void benchPerlinNoise();
+
+    /**
+     * @brief Measures generating and adding all tiles of a map
+     */
+    void benchGenerateMap_data();
+    void benchGenerateMap();
+
+    /**
+     * @brief Measures getTile for every coordinate of the map
+     */
+    void benchGetTile_data();
+    void benchGetTile();
+
+    /**
+     * @brief Measures getTiles for all coordinates of the map at once
+     */
+    void benchGetTiles_data();
+    void benchGetTiles();
+
+    /**
+     * @brief Measures ending a turn, which runs the production of all
+     * active tiles
+     */
+    void benchEndTurn_data();
+    void benchEndTurn();
+
+    /**
+     * @brief Measures forking a captured game and ending a turn in the
+     * fork, like a planner looking ahead
+     */
+    void benchFork_data();
+    void benchFork();
+
+    /**
+     * @brief Measures a Monte-Carlo search of a fixed amount of rollouts
+     * on one thread and on every core
+     */
+    void benchMonteCarloSearch_data();
+    void benchMonteCarloSearch();
+
+    /**
+     * @brief Measures reading the leaderboard
+     */
+    void benchGetScores_data();
+    void benchGetScores();
+
+    /**
+     * @brief Measures redrawing the territory borders
+     */
+    void benchDrawClaimBorders_data();
+    void benchDrawClaimBorders();
+
+    /**
+     * @brief Measures the resource map arithmetic of basicresources
+     */
+    void benchResourceMaps();
+};
+
+void BenchmarkCore::benchPerlinNoise_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    addSizeRows();
+}
+
+void BenchmarkCore::benchPerlinNoise()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    QBENCHMARK {
+        PerlinNoise noise(width, height, BENCH_SEED);
+        Q_UNUSED(noise);
+    }
+}
+
+void BenchmarkCore::benchGenerateMap_data()
+{
+    benchPerlinNoise_data();
+}
+
+void BenchmarkCore::benchGenerateMap()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    std::shared_ptr<GameEventHandler> geh =
+            std::make_shared<GameEventHandler>();
+    WorldGeneratorPerlin generator;
+
+    QBENCHMARK {
+        std::shared_ptr<Game::ObjectManager> om =
+                std::make_shared<Game::ObjectManager>();
+        generator.generateMap(width, height, BENCH_SEED, om, geh);
+    }
+}
+
+void BenchmarkCore::benchGetTile_data()
+{
+    benchPerlinNoise_data();
+}
+
+void BenchmarkCore::benchGetTile()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    BenchGame game = startGame(width, height, 0, false);
+    std::size_t found = 0;
+
+    QBENCHMARK {
+        for(int y=0; y<height; y++){
+            for(int x=0; x<width; x++){
+                if(game.om->getTile(Course::Coordinate(x, y)) != nullptr){
+                    found++;
+                }
+            }
+        }
+    }
+    QVERIFY(found > 0);
+}
+
+void BenchmarkCore::benchGetTiles_data()
+{
+    benchPerlinNoise_data();
+}
+
+void BenchmarkCore::benchGetTiles()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+
+    BenchGame game = startGame(width, height, 0, false);
+    std::vector<Course::Coordinate> coordinates;
+    for(int y=0; y<height; y++){
+        for(int x=0; x<width; x++){
+            coordinates.push_back(Course::Coordinate(x, y));
+        }
+    }
+
+    QBENCHMARK {
+        QCOMPARE(game.om->getTiles(coordinates).size(), coordinates.size());
+    }
+}
+
+void BenchmarkCore::benchEndTurn_data()
+{
+    QTest::addColumn<int>("width");
+    QTest::addColumn<int>("height");
+    QTest::addColumn<int>("rounds");
+    addDensityRows();
+}
+
+void BenchmarkCore::benchEndTurn()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, rounds);
+
+    BenchGame game = startGame(width, height, rounds, false);
+
+    QBENCHMARK {
+        game.manager->endTurn();
+    }
+}
+
+void BenchmarkCore::benchFork_data()
+{
+    benchEndTurn_data();
+}
+
+void BenchmarkCore::benchFork()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, rounds);
+
+    BenchGame game = startGame(width, height, rounds, false);
+    ForkPoint point = game.manager->captureState();
+
+    QBENCHMARK {
+        std::unique_ptr<GameManager> fork = GameManager::fork(point);
+        fork->endTurn();
+    }
+}
+
+void BenchmarkCore::benchMonteCarloSearch_data()
+{
+    QTest::addColumn<int>("threads");
+
+    QTest::newRow("1 thread") << 1;
+    QTest::newRow("all cores") << 0;
+}
+
+void BenchmarkCore::benchMonteCarloSearch()
+{
+    QFETCH(int, threads);
+
+    BenchGame game = startGame(30, 20, 5, false);
+    ForkPoint point = game.manager->captureState();
+
+    MonteCarloSettings settings;
+    settings.budget = 60000;
+    settings.maxRollouts = 200;
+    settings.threads = threads;
+    MonteCarloPolicy policy(settings);
+
+    QBENCHMARK {
+        policy.search(point);
+        QCOMPARE(policy.getLastStats().rollouts, settings.maxRollouts);
+    }
+}
+
+void BenchmarkCore::benchGetScores_data()
+{
+    benchEndTurn_data();
+}
+
+void BenchmarkCore::benchGetScores()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, rounds);
+
+    BenchGame game = startGame(width, height, rounds, false);
+
+    QBENCHMARK {
+        QCOMPARE(game.manager->getScores().size(),
+                 std::size_t(PLAYER_COUNT));
+    }
+}
+
+void BenchmarkCore::benchDrawClaimBorders_data()
+{
+    benchEndTurn_data();
+}
+
+void BenchmarkCore::benchDrawClaimBorders()
+{
+    QFETCH(int, width);
+    QFETCH(int, height);
+    QFETCH(int, rounds);
+
+    BenchGame game = startGame(width, height, rounds, true);
+
+    QBENCHMARK {
+        game.scene->drawClaimBorders();
+    }
+}
+
+void BenchmarkCore::benchResourceMaps()
+{
+    const Course::ResourceMap production = {
+        {Course::BasicResource::MONEY, 3},
+        {Course::BasicResource::FOOD, 5},
+        {Course::BasicResource::WOOD, 2},
+        {Course::BasicResource::STONE, 1},
+        {Course::BasicResource::ORE, 1}
+    };
+    const Course::ResourceMapDouble efficiency = {
+        {Course::BasicResource::MONEY, 0.5},
+        {Course::BasicResource::FOOD, 1.25},
+        {Course::BasicResource::WOOD, 1.0},
+        {Course::BasicResource::STONE, 0.75},
+        {Course::BasicResource::ORE, 0.25}
+    };
+
+    Course::ResourceMap total;
+    QBENCHMARK {
+        // One tile with a building and a worker
+        Course::ResourceMap worked =
+                Course::multiplyResourceMap(production, efficiency);
+        total = Course::mergeResourceMaps(total, worked);
+        Course::ResourceMapDouble merged =
+                Course::mergeResourceMapDoubles(efficiency, efficiency);
+        Q_UNUSED(merged);
+    }
+    QVERIFY(!total.empty());
+}
+
+QTEST_MAIN(BenchmarkCore)
+
+#include "benchmarkcore.moc"
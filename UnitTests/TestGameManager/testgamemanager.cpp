@@ -0,0 +1,752 @@
+#include <QString>
+#include <QtTest>
+#include <ai/montecarlopolicy.hh>
+#include <ai/scriptedpolicy.hh>
+#include <core/actionlog.hh>
+#include <core/biomeconfig.hh>
+#include <core/gamemanager.hh>
+#include <core/objectregistry.hh>
+#include <core/replayengine.hh>
+#include <core/worldgeneratorperlin.hh>
+#include <interfaces/gameeventhandler.hh>
+#include <interfaces/objectmanager.hh>
+#include <constants/constants.hh>
+#include <exceptions/illegalaction.h>
+#include <tiles/forest.h>
+#include <tiles/grassland.h>
+#include <tiles/lake.h>
+#include <tiles/mountain.h>
+#include <tiles/ocean.hh>
+#include <tournament.hh>
+#include <QDir>
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+using namespace Game;
+
+/**
+ * @brief The TestGameManager class is for unit testing GameManager and
+ * the systems that play whole games with it. Games run without a scene.
+ */
+class TestGameManager : public QObject
+{
+    Q_OBJECT
+
+private:
+    /**
+     * @brief Starts a game of two players on a small map
+     * @param seed - World seed
+     * @param turns - Total turn count
+     * @param log - Action log to record to, may be nullptr
+     */
+    std::unique_ptr<GameManager> startGame(
+            int seed, int turns,
+            const std::shared_ptr<ActionLog>& log = nullptr);
+
+    /**
+     * @brief Plays turns with a ScriptedPolicy for every player
+     * @param game - Started game
+     * @param turns - Amount of turns to play
+     */
+    void playTurns(GameManager& game, int turns);
+
+    /**
+     * @brief Gives both players workers and the second one a farm that a
+     * forest still holds, and schedules an effect for the sixth ended turn
+     * @param game - Started game, first player in turn
+     * @post The second player is in turn
+     */
+    void prepareSkip(GameManager& game);
+
+private Q_SLOTS:
+
+    /**
+     * @brief Tests that a recorded log is read back with the same
+     * settings, players, actions and checksums
+     */
+    void testActionLogRoundTrip();
+
+    /**
+     * @brief Tests that a recorded game replays with matching checksums
+     * and that a changed checksum is reported at its turn
+     */
+    void testReplayDivergence();
+
+    /**
+     * @brief Tests that a league played twice with the same seeds on
+     * several threads gives the same results
+     */
+    void testTournamentSeeding();
+
+    /**
+     * @brief Tests that tied players share their rank in both output
+     * formats
+     */
+    void testTournamentRanks();
+
+    /**
+     * @brief Tests that the precomputed biome lookup matches scanning
+     * every biome and that separate configurations with the same biomes
+     * generate the same map
+     */
+    void testBiomeConfig();
+
+    /**
+     * @brief Tests that every tile and registered type reports its tag and
+     * the tag is found by its type name, and the terrain rules of the
+     * traits table
+     */
+    void testTypeTags();
+
+    /**
+     * @brief Tests that recruiting more workers than the tile has space
+     * for or the player can pay for changes nothing
+     */
+    void testRecruitAllOrNothing();
+
+    /**
+     * @brief Tests that skipping turns ends in the same state and scores
+     * as ending them one by one, also over a timer and the end of the game
+     */
+    void testSkipTurns();
+
+    /**
+     * @brief Tests that a fork starts from the state of its game, plays
+     * the same turns and doesn't change the game it came from
+     */
+    void testFork();
+
+    /**
+     * @brief Tests that a search on one thread with a rollout limit gives
+     * the same plan every time and that the plan can be played
+     */
+    void testMonteCarloSearch();
+
+    /**
+     * @brief Tests that every visit of a tree path ending the turn leaves
+     * the rollout the same turn and player
+     */
+    void testMonteCarloEndTurnPath();
+};
+
+std::unique_ptr<GameManager> TestGameManager::startGame(
+        int seed, int turns, const std::shared_ptr<ActionLog>& log)
+{
+    std::unique_ptr<GameManager> game = std::make_unique<GameManager>(
+                std::make_shared<GameEventHandler>(),
+                std::make_shared<Game::ObjectManager>(), nullptr, nullptr);
+    game->addPlayer(std::make_pair(QString("First"), QColor(Qt::red)));
+    game->addPlayer(std::make_pair(QString("Second"), QColor(Qt::blue)));
+    game->setMapSize(16, 12);
+    game->setSeed(seed);
+    game->setTurnCount(turns);
+    game->setActionLog(log);
+    game->startGame();
+    return game;
+}
+
+void TestGameManager::playTurns(GameManager &game, int turns)
+{
+    ScriptedPolicy policy;
+    for(int i=0; i<turns; i++){
+        policy.playTurn(game);
+        game.endTurn();
+    }
+}
+
+void TestGameManager::prepareSkip(GameManager &game)
+{
+    std::shared_ptr<Game::ObjectManager> world = game.getObjectManager();
+    auto freeTile = [&world](TypeTag tag){
+        for(const auto& tile : world->getTiles()){
+            if(tile->getOwner() == nullptr && tile->getTypeTag() == tag){
+                return tile->getCoordinate();
+            }
+        }
+        return Course::Coordinate(-1, -1);
+    };
+
+    for(int i=0; i<2; i++){
+        game.getCurrentPlayer()->setResourceMap(
+                    {{Course::MONEY, 500}, {Course::FOOD, 500},
+                     {Course::WOOD, 500}, {Course::STONE, 500},
+                     {Course::ORE, 500}});
+        Course::Coordinate grass = freeTile(TypeTag::GRASSLAND);
+        game.claimArea(grass);
+        game.addWorkersOnTile(grass, WORKER_BASIC, 2 - i);
+        if(i == 0){
+            game.endTurn();
+        }
+    }
+    Course::Coordinate forest = freeTile(TypeTag::FOREST);
+    game.claimArea(forest);
+    game.addBuildingOnTile(forest, FARM);
+    game.addWorkersOnTile(forest, WORKER_BASIC, 1);
+
+    std::shared_ptr<Player> first = game.getCurrentPlayer();
+    game.scheduleEffect(6, [first](){
+        Course::ResourceMap resources = *first->getResourceMap();
+        resources[Course::MONEY] += 7;
+        first->setResourceMap(resources);
+    });
+}
+
+void TestGameManager::testActionLogRoundTrip()
+{
+    std::shared_ptr<ActionLog> log = std::make_shared<ActionLog>();
+    std::unique_ptr<GameManager> game = startGame(7, 10, log);
+    playTurns(*game, 8);
+    QVERIFY(log->getActions().size() > 8u);
+
+    std::string path = (QDir::tempPath() + "/testgamemanager.pvlog")
+            .toStdString();
+    QVERIFY(log->save(path));
+    ActionLog loaded;
+    QVERIFY(loaded.load(path));
+    QFile::remove(QString::fromStdString(path));
+
+    QCOMPARE(loaded.getSeed(), 7);
+    QCOMPARE(loaded.getMapWidth(), 16);
+    QCOMPARE(loaded.getMapHeight(), 12);
+    QCOMPARE(loaded.getTurnCount(), 10);
+    QVERIFY(loaded.getPlayers() == log->getPlayers());
+
+    QCOMPARE(loaded.getActions().size(), log->getActions().size());
+    for(unsigned int i=0; i<log->getActions().size(); i++){
+        const GameAction& expected = log->getActions().at(i);
+        const GameAction& action = loaded.getActions().at(i);
+        QVERIFY(action.type == expected.type);
+        QCOMPARE(action.x, expected.x);
+        QCOMPARE(action.y, expected.y);
+        QCOMPARE(action.value, expected.value);
+        QCOMPARE(action.name, expected.name);
+        QCOMPARE(action.resource, expected.resource);
+    }
+
+    QCOMPARE(loaded.getChecksums().size(), std::size_t(8));
+    for(unsigned int i=0; i<log->getChecksums().size(); i++){
+        QCOMPARE(loaded.getChecksums().at(i).turn,
+                 log->getChecksums().at(i).turn);
+        QCOMPARE(loaded.getChecksums().at(i).playerIndex,
+                 log->getChecksums().at(i).playerIndex);
+        QCOMPARE(loaded.getChecksums().at(i).hash,
+                 log->getChecksums().at(i).hash);
+    }
+}
+
+void TestGameManager::testReplayDivergence()
+{
+    std::shared_ptr<ActionLog> log = std::make_shared<ActionLog>();
+    std::unique_ptr<GameManager> game = startGame(3, 10, log);
+    playTurns(*game, 8);
+
+    ReplayEngine engine(*log);
+    ReplayResult result = engine.run();
+    QVERIFY(result.matches);
+    QCOMPARE(result.divergenceIndex, -1);
+    QCOMPARE(result.checksums.size(), std::size_t(8));
+    QCOMPARE(engine.getGameManager()->getStateHash(), game->getStateHash());
+
+    // Same log with the checksum of the fifth ended turn changed
+    const int tampered = 4;
+    ActionLog changed;
+    changed.setSettings(log->getSeed(), log->getMapWidth(),
+                        log->getMapHeight(), log->getTurnCount());
+    for(const auto& player : log->getPlayers()){
+        changed.addPlayer(player.first, player.second);
+    }
+    int endIndex = -1;
+    int ended = 0;
+    for(unsigned int i=0; i<log->getActions().size(); i++){
+        const GameAction& action = log->getActions().at(i);
+        changed.record(action);
+        if(action.type == ActionType::END_TURN && ended++ == tampered){
+            endIndex = i;
+        }
+    }
+    for(unsigned int i=0; i<log->getChecksums().size(); i++){
+        TurnChecksum checksum = log->getChecksums().at(i);
+        if(i == tampered){
+            checksum.hash ^= 1;
+        }
+        changed.recordChecksum(checksum);
+    }
+
+    ReplayEngine changedEngine(changed);
+    result = changedEngine.run();
+    QVERIFY(!result.matches);
+    QCOMPARE(result.divergenceIndex, endIndex);
+    QCOMPARE(result.checksums.size(), std::size_t(tampered + 1));
+
+    // Without stopping every turn is still played
+    result = changedEngine.run(false);
+    QVERIFY(!result.matches);
+    QCOMPARE(result.divergenceIndex, endIndex);
+    QCOMPARE(result.checksums.size(), std::size_t(8));
+}
+
+void TestGameManager::testTournamentSeeding()
+{
+    TournamentSettings settings;
+    settings.games = 4;
+    settings.threads = 2;
+    settings.turns = 10;
+    settings.mapWidth = 16;
+    settings.mapHeight = 12;
+    settings.firstSeed = 5;
+    settings.policies = {"random", "scripted", "random"};
+
+    // Games end in any order, the lines are compared sorted
+    auto league = [&settings](){
+        std::ostringstream output;
+        Tournament tournament(settings);
+        int played = tournament.run(output);
+        std::vector<std::string> lines;
+        std::istringstream text(output.str());
+        for(std::string line; std::getline(text, line);){
+            lines.push_back(line);
+        }
+        std::sort(lines.begin(), lines.end());
+        return std::make_pair(played, lines);
+    };
+
+    auto first = league();
+    auto second = league();
+    QCOMPARE(first.first, 4);
+    // Header and one line per player of every game
+    QCOMPARE(first.second.size(), std::size_t(1 + 4 * 3));
+    QVERIFY(first.second == second.second);
+
+    // A game doesn't depend on the others or the thread
+    GameResult game = Tournament::playGame(settings, 2);
+    GameResult again = Tournament::playGame(settings, 2);
+    QCOMPARE(game.seed, 7);
+    QCOMPARE(game.players.size(), std::size_t(3));
+    for(unsigned int i=0; i<game.players.size(); i++){
+        QCOMPARE(game.players.at(i).name, again.players.at(i).name);
+        QCOMPARE(game.players.at(i).score, again.players.at(i).score);
+    }
+}
+
+void TestGameManager::testTournamentRanks()
+{
+    GameResult result;
+    result.game = 0;
+    result.seed = 1;
+    result.players = {{"P01", "random", 10}, {"P02", "scripted", 30},
+                      {"P03", "random", 10}, {"P04", "scripted", 5}};
+
+    // No games, only sets the stream the result is written to
+    TournamentSettings settings;
+    settings.games = 0;
+    std::ostringstream csv;
+    Tournament csvTournament(settings);
+    csvTournament.run(csv);
+    csvTournament.writeResult(result);
+    QCOMPARE(csv.str(), std::string(
+                 "game,seed,player,policy,score,rank\n"
+                 "0,1,P01,random,10,2\n"
+                 "0,1,P02,scripted,30,1\n"
+                 "0,1,P03,random,10,2\n"
+                 "0,1,P04,scripted,5,4\n"));
+
+    settings.format = ResultFormat::JSON_LINES;
+    std::ostringstream json;
+    Tournament jsonTournament(settings);
+    jsonTournament.run(json);
+    jsonTournament.writeResult(result);
+    QCOMPARE(json.str(), std::string(
+                 "{\"game\":0,\"seed\":1,\"players\":["
+                 "{\"name\":\"P01\",\"policy\":\"random\",\"score\":10,"
+                 "\"rank\":2},"
+                 "{\"name\":\"P02\",\"policy\":\"scripted\",\"score\":30,"
+                 "\"rank\":1},"
+                 "{\"name\":\"P03\",\"policy\":\"random\",\"score\":10,"
+                 "\"rank\":2},"
+                 "{\"name\":\"P04\",\"policy\":\"scripted\",\"score\":5,"
+                 "\"rank\":4}]}\n"));
+}
+
+void TestGameManager::testBiomeConfig()
+{
+    // Overlapping, touching and nested ranges and a gap above 0.9
+    auto biomes = [](){
+        return std::vector<Biome>{
+            BiomeConfig::biome<Course::Forest>(0, 0.4),
+            BiomeConfig::biome<Course::Grassland>(0.3, 0.6),
+            BiomeConfig::biome<Game::Mountain>(0.35, 0.36),
+            BiomeConfig::biome<Course::Forest>(0.6, 0.9)
+        };
+    };
+    BiomeConfig config(biomes());
+
+    std::vector<double> values;
+    for(int i=0; i<=1000; i++){
+        values.push_back(i / 1000.0);
+    }
+    for(const Biome& biome : config.getBiomes()){
+        values.push_back(biome.min);
+        values.push_back(biome.max);
+    }
+
+    // Lookup of the old generator: every biome in order
+    for(double value : values){
+        std::vector<const Biome*> scanned;
+        for(const Biome& biome : config.getBiomes()){
+            if(biome.min <= value && value <= biome.max){
+                scanned.push_back(&biome);
+            }
+        }
+        QVERIFY(config.getCandidates(value) == scanned);
+    }
+    QVERIFY(config.getCandidates(0.95).empty());
+
+    // Configurations don't share state, the seed decides the map
+    auto generate = [&biomes](){
+        std::shared_ptr<Game::ObjectManager> world =
+                std::make_shared<Game::ObjectManager>();
+        WorldGeneratorPerlin generator(
+                    std::make_shared<const BiomeConfig>(biomes()));
+        generator.generateMap(32, 16, 11, world,
+                              std::make_shared<GameEventHandler>());
+        return world->getTileTags();
+    };
+    std::vector<TypeTag> first = generate();
+    QCOMPARE(first.size(), std::size_t(32 * 16));
+    QVERIFY(first == generate());
+    QVERIFY(std::count(first.begin(), first.end(), TypeTag::UNKNOWN) == 0);
+}
+
+void TestGameManager::testTypeTags()
+{
+    std::shared_ptr<GameEventHandler> geh =
+            std::make_shared<GameEventHandler>();
+    std::shared_ptr<Game::ObjectManager> om =
+            std::make_shared<Game::ObjectManager>();
+    std::shared_ptr<Player> owner = std::make_shared<Player>("Owner");
+    Course::Coordinate location(0, 0);
+
+    std::vector<std::shared_ptr<Course::TileBase>> tiles = {
+        std::make_shared<Course::Forest>(location, geh, om),
+        std::make_shared<Course::Grassland>(location, geh, om),
+        std::make_shared<Lake>(location, geh, om),
+        std::make_shared<Mountain>(location, geh, om),
+        std::make_shared<Ocean>(location, geh, om)
+    };
+    for(const auto& tile : tiles){
+        TypeTag tag = tile->getTypeTag();
+        QVERIFY(typeTraits(tag).kind == TypeKind::TILE);
+        QVERIFY(typeTagFromName(tile->getType()) == tag);
+    }
+
+    for(const BuildingEntry& entry : ObjectRegistry::buildings()){
+        std::shared_ptr<Course::BuildingBase> building =
+                entry.create(geh, om, owner);
+        QVERIFY(building->getTypeTag() == entry.tag);
+        QVERIFY(typeTraits(entry.tag).kind == TypeKind::BUILDING);
+        QVERIFY(typeTagFromName(building->getType()) == entry.tag);
+        QVERIFY(ObjectRegistry::building(entry.tag) == &entry);
+        QVERIFY(ObjectRegistry::findBuilding(entry.name) == &entry);
+
+        // Both sides have to allow the pair
+        for(const auto& tile : tiles){
+            TypeTag tileTag = tile->getTypeTag();
+            QCOMPARE(canPlaceBuilding(entry.tag, tileTag),
+                     (entry.placement() & tagBit(tileTag)) != 0 &&
+                     (typeTraits(tileTag).placement & tagBit(entry.tag))
+                     != 0);
+        }
+    }
+    for(const WorkerEntry& entry : ObjectRegistry::workers()){
+        std::shared_ptr<Course::WorkerBase> worker =
+                entry.create(geh, om, owner);
+        QVERIFY(worker->getTypeTag() == entry.tag);
+        QVERIFY(typeTraits(entry.tag).kind == TypeKind::WORKER);
+        QVERIFY(typeTagFromName(worker->getType()) == entry.tag);
+        QVERIFY(ObjectRegistry::worker(entry.tag) == &entry);
+        QVERIFY(ObjectRegistry::findWorker(entry.name) == &entry);
+    }
+
+    QVERIFY(typeTagFromName("NoSuchType") == TypeTag::UNKNOWN);
+    QVERIFY(typeTraits(TypeTag::COUNT).tag == TypeTag::UNKNOWN);
+    QVERIFY(ObjectRegistry::building(TypeTag::FOREST) == nullptr);
+    QVERIFY(ObjectRegistry::worker(TypeTag::FARM) == nullptr);
+
+    QVERIFY(canPlaceBuilding(TypeTag::FARM, TypeTag::GRASSLAND));
+    QVERIFY(!canPlaceBuilding(TypeTag::FARM, TypeTag::LAKE));
+    QVERIFY(!canPlaceBuilding(TypeTag::OUTPOST, TypeTag::OCEAN));
+    QVERIFY(canPlaceBuilding(TypeTag::MINE, TypeTag::MOUNTAIN));
+    QVERIFY(!canPlaceBuilding(TypeTag::MINE, TypeTag::FOREST));
+    QVERIFY(canPlaceBuilding(TypeTag::FISHING_BOAT, TypeTag::OCEAN));
+    QVERIFY(canPlaceBuilding(TypeTag::FISHING_BOAT, TypeTag::LAKE));
+    QVERIFY(!canPlaceBuilding(TypeTag::FISHING_BOAT, TypeTag::GRASSLAND));
+    QVERIFY(canPlaceBuilding(TypeTag::LAKE_COTTAGE, TypeTag::LAKE));
+    QVERIFY(!canPlaceBuilding(TypeTag::LAKE_COTTAGE, TypeTag::OCEAN));
+    // Workers have no placement
+    QVERIFY(!canPlaceBuilding(TypeTag::FARMER, TypeTag::GRASSLAND));
+}
+
+void TestGameManager::testRecruitAllOrNothing()
+{
+    std::unique_ptr<GameManager> game = startGame(5, 10);
+    std::shared_ptr<Player> player = game->getCurrentPlayer();
+    std::shared_ptr<Game::ObjectManager> world = game->getObjectManager();
+
+    player->setResourceMap({{Course::MONEY, 1000}, {Course::FOOD, 1000},
+                            {Course::WOOD, 1000}, {Course::STONE, 1000},
+                            {Course::ORE, 1000}});
+
+    // Any free land tile, claimed for the player
+    std::shared_ptr<Course::TileBase> tile = nullptr;
+    for(const auto& candidate : world->getTiles()){
+        if(candidate->getOwner() == nullptr &&
+                !typeTraits(candidate->getTypeTag()).water){
+            tile = candidate;
+            break;
+        }
+    }
+    QVERIFY(tile != nullptr);
+    const Course::Coordinate coordinate = tile->getCoordinate();
+    game->claimArea(coordinate);
+    QVERIFY(tile->getOwner() == player);
+
+    auto unchanged = [&](const Course::ResourceMap& resources,
+                         std::size_t workers, quint64 hash){
+        return *player->getResourceMap() == resources &&
+                tile->getWorkerCount() == 0 &&
+                world->getWorkers().size() == workers &&
+                game->getStateHash() == hash;
+    };
+
+    // Three fit on a tile, four are refused as a whole
+    Course::ResourceMap resources = *player->getResourceMap();
+    std::size_t workers = world->getWorkers().size();
+    quint64 hash = game->getStateHash();
+    QVERIFY(game->canAddWorkers(coordinate, WORKER_BASIC, 4) ==
+            ActionError::NO_WORKER_SPACE);
+    bool thrown = false;
+    try{
+        game->addWorkersOnTile(coordinate, WORKER_BASIC, 4);
+    }catch(Course::IllegalAction&){
+        thrown = true;
+    }
+    QVERIFY(thrown);
+    QVERIFY(unchanged(resources, workers, hash));
+
+    // Money for one only
+    player->setResourceMap({{Course::MONEY, 15}, {Course::FOOD, 1000},
+                            {Course::WOOD, 0}, {Course::STONE, 0},
+                            {Course::ORE, 0}});
+    resources = *player->getResourceMap();
+    hash = game->getStateHash();
+    QVERIFY(game->canAddWorkers(coordinate, WORKER_BASIC, 2) ==
+            ActionError::NOT_ENOUGH_RESOURCES);
+    thrown = false;
+    try{
+        game->addWorkersOnTile(coordinate, WORKER_BASIC, 2);
+    }catch(Course::IllegalAction&){
+        thrown = true;
+    }
+    QVERIFY(thrown);
+    QVERIFY(unchanged(resources, workers, hash));
+
+    game->addWorkersOnTile(coordinate, WORKER_BASIC, 1);
+    QCOMPARE(tile->getWorkerCount(), 1u);
+    QCOMPARE(world->getWorkers().size(), workers + 1);
+    QCOMPARE(player->getResourceMap()->at(Course::MONEY), 5);
+}
+
+void TestGameManager::testSkipTurns()
+{
+    // Ten turns of two players, one of them ended in prepareSkip
+    std::unique_ptr<GameManager> stepped = startGame(9, 10);
+    std::unique_ptr<GameManager> skipped = startGame(9, 10);
+    prepareSkip(*stepped);
+    prepareSkip(*skipped);
+    QCOMPARE(skipped->getStateHash(), stepped->getStateHash());
+    QVERIFY(skipped->getObjectManager()->getWorkers().size() == 4u);
+    QVERIFY(skipped->getObjectManager()->getBuildings().size() == 1u);
+    QVERIFY(skipped->getObjectManager()->getBuildings().front()->isHeld());
+
+    auto same = [&stepped, &skipped](){
+        return skipped->getStateHash() == stepped->getStateHash() &&
+                skipped->getPlayerScores() == stepped->getPlayerScores();
+    };
+
+    // Ends just before the effect, then over it. The farm is held for
+    // the first turn.
+    for(int i=0; i<5; i++){
+        stepped->endTurn();
+    }
+    QCOMPARE(skipped->skipTurns(5), 5);
+    QVERIFY(same());
+    for(int i=0; i<4; i++){
+        stepped->endTurn();
+    }
+    QCOMPARE(skipped->skipTurns(4), 4);
+    QVERIFY(same());
+
+    // 10 player turns are left, the rest of the span is not played
+    for(int i=0; i<20; i++){
+        stepped->endTurn();
+    }
+    QCOMPARE(skipped->skipTurns(20), 10);
+    QVERIFY(same());
+    QCOMPARE(skipped->skipTurns(1), 0);
+}
+
+void TestGameManager::testFork()
+{
+    std::unique_ptr<GameManager> game = startGame(4, 10);
+    prepareSkip(*game);
+    QVERIFY(game->getObjectManager()->getBuildings().front()->isHeld());
+
+    std::unique_ptr<GameManager> fork = game->fork();
+    QVERIFY(fork != nullptr);
+    QCOMPARE(fork->getStateHash(), game->getStateHash());
+    QVERIFY(fork->getPlayerScores() == game->getPlayerScores());
+
+    // Probing every tile of the fork doesn't create the tiles
+    std::shared_ptr<Game::ObjectManager> forkObjects =
+            fork->getObjectManager();
+    const std::pair<int, int> size = fork->getMapSize();
+    auto createdTiles = [&](){
+        unsigned int created = 0;
+        for(int y=0; y<size.second; y++){
+            for(int x=0; x<size.first; x++){
+                created += forkObjects->findTile(Course::Coordinate(x, y)) !=
+                        nullptr;
+            }
+        }
+        return created;
+    };
+    const unsigned int created = createdTiles();
+    for(int y=0; y<size.second; y++){
+        for(int x=0; x<size.first; x++){
+            Course::Coordinate coordinate(x, y);
+            fork->canClaimArea(coordinate);
+            fork->canAddBuilding(coordinate, FARM);
+            fork->canAddWorkers(coordinate, WORKER_BASIC, 1);
+        }
+    }
+    QCOMPARE(createdTiles(), created);
+    QVERIFY(created < static_cast<unsigned int>(size.first * size.second));
+
+    // The hold is released in both
+    game->endTurn();
+    fork->endTurn();
+    QCOMPARE(fork->getStateHash(), game->getStateHash());
+    QVERIFY(!fork->getObjectManager()->getBuildings().front()->isHeld());
+
+    // Changes stay in the fork
+    const quint64 hash = game->getStateHash();
+    const Course::ResourceMap resources =
+            *game->getCurrentPlayer()->getResourceMap();
+    std::shared_ptr<Course::TileBase> tile = nullptr;
+    for(const auto& candidate : fork->getObjectManager()->getTiles()){
+        if(candidate->getOwner() == fork->getCurrentPlayer()){
+            tile = candidate;
+            break;
+        }
+    }
+    QVERIFY(tile != nullptr);
+    fork->addWorkersOnTile(tile->getCoordinate(), WORKER_BASIC, 1);
+    fork->endTurn();
+    QVERIFY(fork->getStateHash() != hash);
+    QCOMPARE(game->getStateHash(), hash);
+    QVERIFY(*game->getCurrentPlayer()->getResourceMap() == resources);
+    QCOMPARE(game->getObjectManager()->getWorkers().size(), std::size_t(4));
+}
+
+void TestGameManager::testMonteCarloSearch()
+{
+    std::unique_ptr<GameManager> game = startGame(6, 10);
+    playTurns(*game, 4);
+    // Enough to do something on this turn
+    game->getCurrentPlayer()->setResourceMap(
+                {{Course::MONEY, 500}, {Course::FOOD, 500},
+                 {Course::WOOD, 500}, {Course::STONE, 500},
+                 {Course::ORE, 500}});
+    ForkPoint point = game->captureState();
+
+    MonteCarloSettings settings;
+    settings.budget = 60000;
+    settings.maxRollouts = 40;
+    settings.threads = 1;
+    settings.horizon = 2;
+    settings.seed = 3;
+
+    // Policies also count their searches, so each does one
+    MonteCarloPolicy first(settings);
+    MonteCarloPolicy second(settings);
+    std::vector<GameAction> plan = first.search(point);
+    std::vector<GameAction> again = second.search(point);
+    QCOMPARE(first.getLastStats().rollouts, settings.maxRollouts);
+    QVERIFY(!plan.empty());
+    QCOMPARE(again.size(), plan.size());
+    for(unsigned int i=0; i<plan.size(); i++){
+        QVERIFY(again.at(i).type == plan.at(i).type);
+        QCOMPARE(again.at(i).x, plan.at(i).x);
+        QCOMPARE(again.at(i).y, plan.at(i).y);
+        QCOMPARE(again.at(i).value, plan.at(i).value);
+        QCOMPARE(again.at(i).name, plan.at(i).name);
+        QCOMPARE(again.at(i).resource, plan.at(i).resource);
+    }
+
+    std::unique_ptr<GameManager> fork = GameManager::fork(point);
+    QVERIFY(fork != nullptr);
+    for(const GameAction& action : plan){
+        bool accepted = true;
+        try{
+            fork->applyAction(action);
+        }catch(const std::exception&){
+            accepted = false;
+        }
+        QVERIFY(accepted);
+    }
+}
+
+void TestGameManager::testMonteCarloEndTurnPath()
+{
+    std::unique_ptr<GameManager> game = startGame(6, 10);
+    playTurns(*game, 3);
+    game->getCurrentPlayer()->setResourceMap(
+                {{Course::MONEY, 50}, {Course::FOOD, 50},
+                 {Course::WOOD, 50}, {Course::STONE, 50},
+                 {Course::ORE, 50}});
+    ForkPoint point = game->captureState();
+    const int turn = game->getCurrentTurnNumber();
+    const int player = game->getCurrentPlayerIndex();
+
+    GameAction endTurn;
+    endTurn.type = ActionType::END_TURN;
+    GameAction sale;
+    sale.type = ActionType::SELL;
+    sale.resource = Course::WOOD;
+    sale.value = 1;
+
+    // The first visit expands the node, later ones replay it
+    std::vector<std::vector<GameAction>> paths = {
+        {endTurn}, {endTurn}, {sale, endTurn}, {sale, endTurn}
+    };
+    std::vector<quint64> hashes;
+    for(const std::vector<GameAction>& path : paths){
+        std::unique_ptr<GameManager> fork = GameManager::fork(point);
+        for(const GameAction& action : path){
+            MonteCarloPolicy::applyPathAction(*fork, action);
+        }
+        QCOMPARE(fork->getCurrentTurnNumber(), turn);
+        QCOMPARE(fork->getCurrentPlayerIndex(), player);
+        hashes.push_back(fork->getStateHash());
+    }
+    QCOMPARE(hashes.at(0), game->getStateHash());
+    QCOMPARE(hashes.at(1), hashes.at(0));
+    QCOMPARE(hashes.at(3), hashes.at(2));
+    QVERIFY(hashes.at(2) != hashes.at(0));
+}
+
+QTEST_APPLESS_MAIN(TestGameManager)
+
+#include "testgamemanager.moc"
@@ -32,17 +32,77 @@ DEFINES += QT_DEPRECATED_WARNINGS
 SOURCES += \
         testobjectmanager.cpp \
     ../../Game/interfaces/objectmanager.cpp \
+    ../../Game/core/mapsnapshot.cpp \
+    ../../Game/tiles/lake.cpp \
+    ../../Game/tiles/mountain.cpp \
+    ../../Game/tiles/ocean.cpp \
     ../../Game/graphics/mapitem.cpp \
+    ../../Game/core/objectregistry.cpp \
+    ../../Game/core/objectpool.cpp \
+    ../../Game/core/scoreledger.cpp \
+    ../../Game/core/actionerror.cpp \
+    ../../Game/core/productionforecast.cpp \
+    ../../Game/core/upkeep.cpp \
+    ../../Game/core/steadyturns.cpp \
+    ../../Game/core/turntimers.cpp \
+    ../../Game/core/profiler.cpp \
+    ../../Game/core/statsrecorder.cpp \
+    ../../Game/buildings/mine.cpp \
+    ../../Game/buildings/cottage.cpp \
+    ../../Game/buildings/fishingboat.cpp \
+    ../../Game/workers/farmer.cpp \
+    ../../Game/workers/miner.cpp \
     ../../Game/graphics/gamescene.cpp \
     ../../Game/core/player.cpp \
-    ../../Game/interfaces/gameeventhandler.cpp
+    ../../Game/interfaces/gameeventhandler.cpp \
+    ../../Game/core/gameobject.cpp \
+    ../../Game/core/placeablegameobject.cpp \
+    ../../Game/core/coordinate.cpp \
+    ../../Game/tiles/tilebase.cpp \
+    ../../Game/tiles/grassland.cpp \
+    ../../Game/tiles/forest.cpp \
+    ../../Game/buildings/buildingbase.cpp \
+    ../../Game/buildings/farm.cpp \
+    ../../Game/buildings/headquarters.cpp \
+    ../../Game/buildings/outpost.cpp \
+    ../../Game/workers/workerbase.cpp \
+    ../../Game/workers/basicworker.cpp
 
 HEADERS += \
+    ../../Game/core/mapsnapshot.hh \
     ../../Game/graphics/gamescene.hh \
     ../../Game/graphics/mapitem.hh \
+    ../../Game/core/objectregistry.hh \
+    ../../Game/core/objectpool.hh \
+    ../../Game/core/resourcemaps.h \
+    ../../Game/core/scoreledger.hh \
+    ../../Game/core/actionerror.hh \
+    ../../Game/core/productionforecast.hh \
+    ../../Game/core/upkeep.hh \
+    ../../Game/core/steadyturns.hh \
+    ../../Game/core/turntimers.hh \
+    ../../Game/core/profiler.hh \
+    ../../Game/core/statsrecorder.hh \
+    ../../Game/core/tilebitset.hh \
+    ../../Game/core/typetags.hh \
     ../../Game/core/player.hh \
-    ../../Game/interfaces/gameeventhandler.hh
+    ../../Game/interfaces/gameeventhandler.hh \
+    ../../Game/core/gameobject.h \
+    ../../Game/core/placeablegameobject.h \
+    ../../Game/core/coordinate.h \
+    ../../Game/interfaces/iobjectmanager.h \
+    ../../Game/tiles/tilebase.h \
+    ../../Game/tiles/grassland.h \
+    ../../Game/tiles/forest.h \
+    ../../Game/buildings/buildingbase.h \
+    ../../Game/buildings/farm.h \
+    ../../Game/buildings/headquarters.h \
+    ../../Game/buildings/outpost.h \
+    ../../Game/workers/workerbase.h \
+    ../../Game/workers/basicworker.h
 
+# Course classes changed in this repo are built from Game/, the library
+# only provides the unchanged ones
 INCLUDEPATH += ../../Game
 DEPENDPATH += ../../Game
 
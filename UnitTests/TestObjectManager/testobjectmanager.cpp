@@ -4,7 +4,28 @@
 #include <interfaces/gameeventhandler.hh>
 #include <workers/basicworker.h>
 #include <buildings/farm.h>
+#include <buildings/outpost.h>
 #include <tiles/grassland.h>
+#include <core/actionerror.hh>
+#include <core/mapsnapshot.hh>
+#include <core/objectregistry.hh>
+#include <core/objectpool.hh>
+#include <core/productionforecast.hh>
+#include <core/profiler.hh>
+#include <core/scoreledger.hh>
+#include <core/statsrecorder.hh>
+#include <core/steadyturns.hh>
+#include <core/upkeep.hh>
+#include <core/tilebitset.hh>
+#include <core/turntimers.hh>
+#include <constants/constants.hh>
+#include <exceptions/illegalaction.h>
+#include <exceptions/invalidpointer.h>
+#include <exceptions/ownerconflict.h>
+#include <QDir>
+
+#include <thread>
+#include <type_traits>
 
 using namespace Game;
 
@@ -35,6 +56,36 @@ private:
     std::shared_ptr<Course::TileBase> testTile = nullptr;
     std::shared_ptr<Course::TileBase> anotherTile = nullptr;
 
+    /**
+     * @brief Creates grassland tiles for columns of a map
+     * @param world - World of the tiles
+     * @param fromX - First column
+     * @param toX - Column after the last one
+     * @param height - Tiles in a column
+     * @param events - Event handler of the tiles
+     * @param buildSpaces - Buildings a tile takes
+     * @return Tiles column by column like the world generator makes them
+     */
+    std::vector<std::shared_ptr<Course::TileBase>> grassColumns(
+            const std::shared_ptr<ObjectManager>& world,
+            int fromX, int toX, int height,
+            const std::shared_ptr<GameEventHandler>& events,
+            unsigned int buildSpaces = 3);
+
+    /**
+     * @brief Creates an own grassland world so earlier tests don't matter
+     * @param width - Map width
+     * @param height - Map height
+     * @param players - Players of the world in turn order
+     * @param events - Event handler of the tiles, geHandler if nullptr
+     * @param buildSpaces - Buildings a tile takes
+     */
+    std::shared_ptr<ObjectManager> grassWorld(
+            int width, int height,
+            const std::vector<std::shared_ptr<Course::PlayerBase>>& players,
+            std::shared_ptr<GameEventHandler> events = nullptr,
+            unsigned int buildSpaces = 3);
+
 private Q_SLOTS:
 
     /**
@@ -63,6 +114,110 @@ private Q_SLOTS:
      * Also tests ObjectManager addWorker by adding the worker to the vector
      */
     void testRemoveWorker();
+
+    /**
+     * @brief Tests that tiles saved to a snapshot are restored lazily
+     * with the same type, owner and production
+     * Writes the snapshot to the temp directory and creates the same one
+     * in memory
+     */
+    void testSnapshotRestore();
+
+    /**
+     * @brief Tests that every ObjectManager numbers its objects from 0
+     * without gaps and finds tiles by ID
+     */
+    void testPerWorldIds();
+
+    /**
+     * @brief Tests that every registry entry is found by its tag and name
+     * and its factory creates an object of the same type
+     */
+    void testObjectRegistry();
+
+    /**
+     * @brief Tests that freed pool blocks are reused and that pooled
+     * buildings share the cost maps of their type
+     */
+    void testObjectPool();
+
+    /**
+     * @brief Tests setting, reading and unsetting the coordinate of
+     * a GameObject and comparing coordinates of two objects
+     */
+    void testInlineCoordinate();
+
+    /**
+     * @brief Tests neighbour iteration with both connectivities, rings and
+     * clipping, and the tile query that uses it
+     */
+    void testNeighbourRange();
+
+    /**
+     * @brief Tests that the owner raster follows claims, owner changes and
+     * player order, and that territory sizes match it
+     */
+    void testOwnerRaster();
+
+    /**
+     * @brief Tests that the score ledger follows resources, claims and
+     * booked objects, and keeps tied players on the leaderboard
+     */
+    void testScoreLedger();
+
+    /**
+     * @brief Tests that recorded rounds land in the right columns and
+     * that both export formats can be written
+     */
+    void testStatsRecorder();
+
+    /**
+     * @brief Tests that scoped timers are summed per turn and the trace
+     * and summary files can be written
+     */
+    void testProfiler();
+
+    /**
+     * @brief Tests that action errors map to the messages and exceptions
+     * the acting methods used to throw
+     */
+    void testActionError();
+
+    /**
+     * @brief Tests the bitset operations and that placement masks follow
+     * owners and buildings on the tiles
+     */
+    void testPlacement();
+
+    /**
+     * @brief Tests that forecasts match the real production and are only
+     * calculated again when the tile or the owner's satisfaction changes
+     */
+    void testProductionForecast();
+
+    /**
+     * @brief Tests that upkeep is shared out in worker order and taken
+     * once per player
+     */
+    void testUpkeep();
+
+    /**
+     * @brief Tests that steady turns change the resources the same way and
+     * end at the turn a tile can't afford its production
+     */
+    void testSteadyTurns();
+
+    /**
+     * @brief Tests that timers run on their turn in schedule order, also
+     * when they are further away than the wheel
+     */
+    void testTurnTimers();
+
+    /**
+     * @brief Tests that a reserved map added in chunks of columns ends up
+     * the same as the map added at once
+     */
+    void testChunkedTiles();
 };
 
 TestObjectManager::TestObjectManager()
@@ -92,6 +247,38 @@ TestObjectManager::TestObjectManager()
     objManager->addTiles(tiles);
 }
 
+std::vector<std::shared_ptr<Course::TileBase>>
+TestObjectManager::grassColumns(const std::shared_ptr<ObjectManager>& world,
+                                int fromX, int toX, int height,
+                                const std::shared_ptr<GameEventHandler>& events,
+                                unsigned int buildSpaces)
+{
+    std::vector<std::shared_ptr<Course::TileBase>> grass;
+    for(int x=fromX; x<toX; x++){
+        for(int y=0; y<height; y++){
+            grass.push_back(std::make_shared<Grassland>(
+                                Coordinate(x,y), events, world,
+                                buildSpaces));
+        }
+    }
+    return grass;
+}
+
+std::shared_ptr<ObjectManager> TestObjectManager::grassWorld(
+        int width, int height,
+        const std::vector<std::shared_ptr<Course::PlayerBase>>& players,
+        std::shared_ptr<GameEventHandler> events, unsigned int buildSpaces)
+{
+    if(events == nullptr){
+        events = geHandler;
+    }
+    std::shared_ptr<ObjectManager> world = std::make_shared<ObjectManager>();
+    world->addTiles(grassColumns(world, 0, width, height, events,
+                                 buildSpaces));
+    world->setPlayers(players);
+    return world;
+}
+
 void TestObjectManager::testGetTiles()
 {
     /* Vectors should be the same now
@@ -138,6 +325,756 @@ void TestObjectManager::testRemoveWorker()
     objManager->removeWorker(unSuccessfulWorker);
 }
 
+void TestObjectManager::testSnapshotRestore()
+{
+    std::shared_ptr<Player> testPlayer = std::make_shared<Player>("PlayerTest");
+    anotherTile->setOwner(testPlayer);
+    std::vector<std::shared_ptr<Course::PlayerBase>> players = {testPlayer};
+
+    std::pair<int, int> mapSize = objManager->getMapSize();
+    SnapshotHeader header = {};
+    header.mapWidth = mapSize.first;
+    header.mapHeight = mapSize.second;
+    header.currentTurnNumber = 1;
+    SnapshotPlayer playerRecord = {};
+
+    QString path = QDir::tempPath() + "/testobjectmanager.pvsave";
+    QVERIFY(MapSnapshot::write(path, header, {playerRecord},
+                               objManager->exportTiles(players), {}));
+
+    std::shared_ptr<MapSnapshot> snapshot = MapSnapshot::open(path);
+    QVERIFY(snapshot != nullptr);
+
+    std::shared_ptr<ObjectManager> restored = std::make_shared<ObjectManager>();
+    restored->setSnapshot(snapshot, geHandler, players);
+
+    // Type and owner are readable without creating the tile
+    QVERIFY(restored->getTileType(Coordinate(1,3)) == "Grassland");
+    QVERIFY(restored->getTileOwner(Coordinate(1,3)) == testPlayer);
+    QVERIFY(restored->getTileOwner(Coordinate(0,0)) == nullptr);
+
+    std::shared_ptr<Course::TileBase> tile = restored->getTile(Coordinate(1,3));
+    QVERIFY(tile != nullptr);
+    QVERIFY(tile->getType() == anotherTile->getType());
+    QVERIFY(tile->getOwner() == testPlayer);
+    QVERIFY(tile->BASE_PRODUCTION == anotherTile->BASE_PRODUCTION);
+    QVERIFY(restored->getTile(Coordinate(1,3)) == tile);
+
+    QFile::remove(path);
+
+    // Snapshots in memory have the same records as the file
+    std::shared_ptr<MapSnapshot> inMemory = MapSnapshot::create(
+                header, {playerRecord}, objManager->exportTiles(players), {});
+    QCOMPARE(inMemory->header().tileCount, snapshot->header().tileCount);
+    QCOMPARE(inMemory->header().playerCount, 1u);
+    std::shared_ptr<ObjectManager> forked = std::make_shared<ObjectManager>();
+    forked->setSnapshot(inMemory, geHandler, players);
+    QVERIFY(forked->getTileOwner(Coordinate(1,3)) == testPlayer);
+    QVERIFY(forked->getTile(Coordinate(1,3))->BASE_PRODUCTION ==
+            anotherTile->BASE_PRODUCTION);
+
+    // Corrupt files are rejected before anything is restored
+    SnapshotHeader badPlayer = header;
+    badPlayer.currentPlayerIndex = 1;
+    QVERIFY(MapSnapshot::write(path, badPlayer, {playerRecord},
+                               objManager->exportTiles(players), {}));
+    QVERIFY(MapSnapshot::open(path) == nullptr);
+
+    SnapshotHeader badTurn = header;
+    badTurn.currentTurnNumber = 0;
+    QVERIFY(MapSnapshot::write(path, badTurn, {playerRecord},
+                               objManager->exportTiles(players), {}));
+    QVERIFY(MapSnapshot::open(path) == nullptr);
+
+    std::vector<SnapshotTile> badTiles = objManager->exportTiles(players);
+    badTiles.back().type = 200;
+    QVERIFY(MapSnapshot::write(path, header, {playerRecord}, badTiles, {}));
+    QVERIFY(MapSnapshot::open(path) == nullptr);
+
+    // Objects that could not be placed back on their tile
+    SnapshotObject farm = {};
+    farm.tileIndex = 3 * mapSize.first + 1;
+    farm.kind = SNAPSHOT_BUILDING;
+    SnapshotObject worker = farm;
+    worker.kind = SNAPSHOT_WORKER;
+    QVERIFY(MapSnapshot::write(path, header, {playerRecord},
+                               objManager->exportTiles(players),
+                               {farm, worker}));
+    QVERIFY(MapSnapshot::open(path) != nullptr);
+
+    SnapshotObject mine = farm;
+    mine.type = 3;
+    SnapshotObject unownedWorker = worker;
+    unownedWorker.tileIndex = 0;
+    SnapshotObject badFocus = worker;
+    badFocus.focus = 9;
+    SnapshotObject badKind = worker;
+    badKind.kind = 7;
+    for(const SnapshotObject& bad : {mine, unownedWorker, badFocus, badKind}){
+        QVERIFY(MapSnapshot::write(path, header, {playerRecord},
+                                   objManager->exportTiles(players), {bad}));
+        QVERIFY(MapSnapshot::open(path) == nullptr);
+    }
+
+    std::vector<SnapshotObject> crowded(
+                objManager->exportTiles(players).at(worker.tileIndex)
+                .maxWorkers + 1, worker);
+    QVERIFY(MapSnapshot::write(path, header, {playerRecord},
+                               objManager->exportTiles(players), crowded));
+    QVERIFY(MapSnapshot::open(path) == nullptr);
+    QFile::remove(path);
+}
+
+void TestObjectManager::testPerWorldIds()
+{
+    std::shared_ptr<ObjectManager> first = std::make_shared<ObjectManager>();
+    std::shared_ptr<ObjectManager> second = std::make_shared<ObjectManager>();
+
+    std::shared_ptr<Course::TileBase> firstTile = std::make_shared<Grassland>(
+                Course::Coordinate(0,0), geHandler, first);
+    std::shared_ptr<Course::TileBase> secondTile = std::make_shared<Grassland>(
+                Course::Coordinate(0,0), geHandler, second);
+    std::shared_ptr<Course::TileBase> nextTile = std::make_shared<Grassland>(
+                Course::Coordinate(1,0), geHandler, first);
+
+    // Worlds don't affect each other
+    QCOMPARE(firstTile->ID, 0u);
+    QCOMPARE(secondTile->ID, 0u);
+    QCOMPARE(nextTile->ID, 1u);
+    QCOMPARE(first->getIdCount(), 2u);
+
+    first->addTiles({firstTile, nextTile});
+    QVERIFY(first->getTile(nextTile->ID) == nextTile);
+    QVERIFY(first->getTile(Course::ObjectId(5)) == nullptr);
+}
+
+void TestObjectManager::testObjectRegistry()
+{
+    std::shared_ptr<Player> player = std::make_shared<Player>("player");
+
+    for(const BuildingEntry& entry : ObjectRegistry::buildings()){
+        QVERIFY(ObjectRegistry::building(entry.tag) == &entry);
+        QVERIFY(ObjectRegistry::findBuilding(entry.name) == &entry);
+        QVERIFY(entry.create(geHandler, objManager, player)->getTypeTag() ==
+                entry.tag);
+    }
+    for(const WorkerEntry& entry : ObjectRegistry::workers()){
+        QVERIFY(ObjectRegistry::worker(entry.tag) == &entry);
+        QVERIFY(ObjectRegistry::findWorker(entry.name) == &entry);
+        QVERIFY(entry.create(geHandler, objManager, player)->getTypeTag() ==
+                entry.tag);
+    }
+
+    QVERIFY(ObjectRegistry::building(TypeTag::FOREST) == nullptr);
+    QVERIFY(ObjectRegistry::worker(TypeTag::FARM) == nullptr);
+    QVERIFY(ObjectRegistry::findBuilding("Castle") == nullptr);
+}
+
+void TestObjectManager::testObjectPool()
+{
+    BlockPool pool(24, 4);
+    QVERIFY(pool.getBlockSize() >= 24);
+
+    void* first = pool.allocate();
+    void* second = pool.allocate();
+    QVERIFY(first != second);
+    QCOMPARE(pool.getUsedCount(), std::size_t(2));
+    QCOMPARE(pool.getCapacity(), std::size_t(4));
+
+    pool.deallocate(first);
+    QVERIFY(pool.allocate() == first);
+
+    // A fifth block needs a new chunk
+    pool.allocate();
+    pool.allocate();
+    pool.allocate();
+    QCOMPARE(pool.getCapacity(), std::size_t(8));
+
+    std::shared_ptr<Player> player = std::make_shared<Player>("player");
+    std::shared_ptr<Course::Farm> farm = makePooled<Course::Farm>(
+                geHandler, objManager, player);
+    std::shared_ptr<Course::Farm> another = makePooled<Course::Farm>(
+                geHandler, objManager, player);
+    QVERIFY(&farm->BUILD_COST == &another->BUILD_COST);
+    QVERIFY(farm->BUILD_COST == Course::ConstResourceMaps::FARM_BUILD_COST);
+
+    // Kept maps must outlive the object, temporaries don't compile
+    static_assert(!std::is_constructible<
+                  Course::Farm, std::shared_ptr<GameEventHandler>,
+                  std::shared_ptr<ObjectManager>, std::shared_ptr<Player>,
+                  int, Course::ResourceMap>::value,
+                  "Farm keeps the cost map by reference");
+    static_assert(std::is_constructible<
+                  Course::Farm, std::shared_ptr<GameEventHandler>,
+                  std::shared_ptr<ObjectManager>, std::shared_ptr<Player>,
+                  int, const Course::ResourceMap&>::value,
+                  "Farm accepts shared maps");
+
+    // Threads share the pool, blocks can be freed on any thread
+    BlockPool* mainPool = &PoolAllocator<Course::Farm>::pool();
+    BlockPool* threadPool = nullptr;
+    std::shared_ptr<Course::Farm> threadFarm;
+    std::thread thread([&](){
+        threadPool = &PoolAllocator<Course::Farm>::pool();
+        threadFarm = makePooled<Course::Farm>(geHandler, objManager, player);
+    });
+    thread.join();
+    QVERIFY(threadPool == mainPool);
+    QVERIFY(threadFarm->BUILD_COST ==
+            Course::ConstResourceMaps::FARM_BUILD_COST);
+    threadFarm = nullptr;
+}
+
+void TestObjectManager::testInlineCoordinate()
+{
+    std::shared_ptr<Player> player = std::make_shared<Player>("player");
+    std::shared_ptr<Course::Farm> farm = std::make_shared<Course::Farm>(
+                geHandler, objManager, player);
+    std::shared_ptr<Course::Farm> another = std::make_shared<Course::Farm>(
+                geHandler, objManager, player);
+
+    QVERIFY(!farm->hasCoordinate());
+    QVERIFY(farm->peekCoordinate() == nullptr);
+    QVERIFY(farm->getCoordinatePtr() == nullptr);
+    QVERIFY_EXCEPTION_THROWN(farm->getCoordinate(), Course::InvalidPointer);
+    QVERIFY(farm->hasSameCoordinateAs(another));
+
+    farm->setCoordinate(Coordinate(2,3));
+    QVERIFY(farm->hasCoordinate());
+    QVERIFY(*farm->peekCoordinate() == Coordinate(2,3));
+    QVERIFY(&farm->getCoordinate() == farm->peekCoordinate());
+    QVERIFY(!farm->hasSameCoordinateAs(another));
+
+    another->setCoordinate(Coordinate(2,3));
+    QVERIFY(farm->hasSameCoordinateAs(another));
+
+    farm->unsetCoordinate();
+    QVERIFY(!farm->hasCoordinate());
+    QVERIFY(!farm->hasSameCoordinateAs(another));
+}
+
+void TestObjectManager::testNeighbourRange()
+{
+    Coordinate centre(5,5);
+
+    // Same coordinates and order as Coordinate::neighbours
+    std::vector<Coordinate> expected = centre.neighbours(2);
+    std::vector<Coordinate> iterated;
+    for(Coordinate coordinate : NeighbourRange(centre, 2)){
+        iterated.push_back(coordinate);
+    }
+    QVERIFY(iterated == expected);
+
+    unsigned int count = 0;
+    for(Coordinate coordinate : NeighbourRange(centre, 2, Connectivity::FOUR)){
+        QVERIFY(std::abs(coordinate.x() - 5) + std::abs(coordinate.y() - 5)
+                <= 2);
+        count++;
+    }
+    QCOMPARE(count, 12u);
+
+    count = 0;
+    for(Coordinate coordinate : NeighbourRange(centre, 2, Connectivity::EIGHT,
+                                               true)){
+        QVERIFY(std::max(std::abs(coordinate.x() - 5),
+                         std::abs(coordinate.y() - 5)) == 2);
+        count++;
+    }
+    QCOMPARE(count, 16u);
+
+    count = 0;
+    for(Coordinate coordinate : NeighbourRange(centre, 3, Connectivity::FOUR,
+                                               true)){
+        QVERIFY(std::abs(coordinate.x() - 5) + std::abs(coordinate.y() - 5)
+                == 3);
+        count++;
+    }
+    QCOMPARE(count, 12u);
+
+    // Corner of a 10x10 map keeps only the quarter inside
+    count = 0;
+    NeighbourRange corner = NeighbourRange(Coordinate(0,0), 1).clippedTo(10, 10);
+    for(Coordinate coordinate : corner){
+        QVERIFY(coordinate.x() >= 0 && coordinate.y() >= 0);
+        count++;
+    }
+    QCOMPARE(count, 3u);
+    NeighbourRange empty(centre, 0);
+    QVERIFY(empty.begin() == empty.end());
+    QVERIFY(NeighbourRange(centre, 1).contains(Coordinate(6,6)));
+    QVERIFY(!NeighbourRange(centre, 1).contains(centre));
+
+    // Tiles at (0,0) and (1,3), only the first is next to (1,1)
+    std::vector<std::shared_ptr<Course::TileBase>> found =
+            objManager->getTiles(NeighbourRange(Coordinate(1,1), 1));
+    QCOMPARE(found.size(), std::size_t(1));
+    QVERIFY(found.front() == testTile);
+}
+
+void TestObjectManager::testOwnerRaster()
+{
+    std::shared_ptr<Player> first = std::make_shared<Player>("First");
+    std::shared_ptr<Player> second = std::make_shared<Player>("Second");
+    std::shared_ptr<ObjectManager> world = grassWorld(4, 4, {first, second});
+
+    // Centre is not claimed
+    QCOMPARE(world->claimUnowned(NeighbourRange(Coordinate(1,1), 1), first),
+             8u);
+    QCOMPARE(world->getTerritorySize(first), 8u);
+    QCOMPARE(world->getTileOwnerIndex(Coordinate(0,0)), quint8(0));
+    QCOMPARE(world->getTileOwnerIndex(Coordinate(1,1)), NO_OWNER);
+    QVERIFY(world->getTile(Coordinate(0,0))->getOwner() == first);
+
+    // Owner set on the tile object shows in the raster
+    world->getTile(Coordinate(1,1))->setOwner(second);
+    QCOMPARE(world->getTileOwnerIndex(Coordinate(1,1)), quint8(1));
+
+    // (1,1), (1,2) and (2,1) are owned already
+    QCOMPARE(world->claimUnowned(NeighbourRange(Coordinate(2,2), 1), second),
+             5u);
+    QCOMPARE(world->getTerritorySize(second), 6u);
+    QVERIFY(world->getTileOwner(Coordinate(3,3)) == second);
+
+    world->getTile(Coordinate(0,0))->setOwner(nullptr);
+    QCOMPARE(world->getTerritorySize(first), 7u);
+    QCOMPARE(world->getTileOwnerIndex(Coordinate(0,0)), NO_OWNER);
+
+    // Reordering keeps the owners
+    world->setPlayers({second, first});
+    QCOMPARE(world->getTileOwnerIndex(Coordinate(0,1)), quint8(1));
+    QCOMPARE(world->getTerritorySize(first), 7u);
+    QCOMPARE(world->getTerritorySize(second), 6u);
+
+    // Unknown owners are added after the given players
+    std::shared_ptr<Player> third = std::make_shared<Player>("Third");
+    world->getTile(Coordinate(0,0))->setOwner(third);
+    QCOMPARE(world->getPlayers().size(), std::size_t(3));
+    QCOMPARE(world->getTerritorySize(third), 1u);
+
+    unsigned int owned = 0;
+    for(quint8 owner : world->getOwnerRaster()){
+        owned += owner != NO_OWNER ? 1 : 0;
+    }
+    QCOMPARE(owned, 14u);
+}
+
+void TestObjectManager::testScoreLedger()
+{
+    std::shared_ptr<Player> first = std::make_shared<Player>("First");
+    std::shared_ptr<Player> second = std::make_shared<Player>("Second");
+    ResourceMap empty = {{MONEY, 0}, {FOOD, 0}, {WOOD, 0}, {STONE, 0},
+                         {ORE, 0}};
+    first->setResourceMap(empty);
+    second->setResourceMap(empty);
+    std::shared_ptr<ObjectManager> world = grassWorld(3, 1, {first, second});
+
+    ScoreLedger ledger(world);
+    ledger.setPlayers({first, second});
+    QCOMPARE(ledger.getScore(0), 0);
+
+    // Ore and money are worth double
+    first->setResourceMap({{MONEY, 10}, {FOOD, 1}, {WOOD, 1}, {STONE, 1},
+                           {ORE, 5}});
+    QCOMPARE(ledger.getScore(0), 33);
+
+    world->getTile(Coordinate(0,0))->setOwner(second);
+    QCOMPARE(ledger.getScore(1), CLAIM_SCORE);
+
+    ResourceMap cost = {{MONEY, 3}, {WOOD, 2}};
+    ledger.addAsset(second, cost);
+    QCOMPARE(ledger.getScore(1), CLAIM_SCORE + 8);
+    ledger.removeAsset(second, cost);
+    QCOMPARE(ledger.getScore(1), CLAIM_SCORE);
+
+    // Tied players are both listed, in turn order
+    ledger.addAsset(first, {{WOOD, 17}});
+    std::vector<ScoreEntry> board = ledger.getLeaderboard();
+    QCOMPARE(board.size(), std::size_t(2));
+    QCOMPARE(board.at(0).score, 50);
+    QCOMPARE(board.at(1).score, 50);
+    QVERIFY(board.at(0).name == "First");
+
+    world->getTile(Coordinate(1,0))->setOwner(second);
+    QVERIFY(ledger.getLeaderboard().front().name == "Second");
+}
+
+void TestObjectManager::testStatsRecorder()
+{
+    std::vector<std::shared_ptr<Player>> players = {
+        std::make_shared<Player>("First"), std::make_shared<Player>("Second")};
+
+    StatsRecorder recorder;
+    recorder.start(players, 3);
+    QCOMPARE(recorder.getPlayerCount(), 2u);
+    QCOMPARE(recorder.getRoundCount(), 0u);
+
+    for(int turn=1; turn<=3; turn++){
+        recorder.beginRound(turn);
+        recorder.set(0, Stat::MONEY, turn * 10);
+        recorder.set(1, Stat::TERRITORY, turn);
+    }
+
+    QCOMPARE(recorder.getRoundCount(), 3u);
+    QCOMPARE(recorder.getTurn(2), 3);
+    QCOMPARE(recorder.get(Stat::MONEY, 1, 0), 20);
+    QCOMPARE(recorder.get(Stat::MONEY, 1, 1), 0);
+    QCOMPARE(recorder.get(Stat::TERRITORY, 2, 1), 3);
+    QCOMPARE(recorder.getColumn(Stat::TERRITORY).size(), std::size_t(6));
+    QVERIFY(recorder.getPlayerName(1) == "Second");
+    QVERIFY(std::string(StatsRecorder::statName(Stat::SCORE)) == "score");
+    QVERIFY_EXCEPTION_THROWN(recorder.get(Stat::MONEY, 3, 0),
+                             std::out_of_range);
+
+    QString csv = QDir::tempPath() + "/testobjectmanager.csv";
+    QString binary = QDir::tempPath() + "/testobjectmanager.pvstats";
+    QVERIFY(recorder.exportCsv(csv));
+    QVERIFY(recorder.exportBinary(binary));
+    QFile::remove(csv);
+    QFile::remove(binary);
+
+    // Starting again drops the rounds
+    recorder.start(players, 3);
+    QCOMPARE(recorder.getRoundCount(), 0u);
+}
+
+void TestObjectManager::testProfiler()
+{
+    using Game::Profiler;
+    Profiler& profiler = Profiler::getInstance();
+    profiler.clear();
+
+    profiler.setTurn(4);
+    {
+        Game::ScopedTimer timer("testTimer");
+    }
+    profiler.addEvent("testTimer", profiler.now(), 25);
+    profiler.count("testCounter", 3);
+
+    QCOMPARE(profiler.getEventCount(), 2u);
+    QVERIFY(profiler.getTotal(4, "testTimer") >= 25);
+    QCOMPARE(profiler.getTotal(5, "testTimer"), qint64(0));
+
+    QString prefix = QDir::tempPath() + "/testobjectmanager";
+    QVERIFY(profiler.writeFiles(prefix));
+
+    QFile summary(prefix + ".turns.csv");
+    QVERIFY(summary.open(QIODevice::ReadOnly));
+    QString text = summary.readAll();
+    QVERIFY(text.startsWith("turn,name,calls,total_us\n"));
+    QVERIFY(text.contains("4,testTimer,2,"));
+    QVERIFY(text.contains("4,testCounter,,3\n"));
+    summary.close();
+    QFile::remove(prefix + ".turns.csv");
+    QFile::remove(prefix + ".trace.json");
+
+    profiler.clear();
+    profiler.setTurn(0);
+    QCOMPARE(profiler.getEventCount(), 0u);
+}
+
+void TestObjectManager::testActionError()
+{
+    QVERIFY(actionErrorMessage(ActionError::NONE).isEmpty());
+    QVERIFY(actionErrorMessage(ActionError::NO_WORKER_SPACE) ==
+            TOO_MANY_WORKERS);
+    QVERIFY(actionErrorMessage(ActionError::NO_TILE) == CANT_BE_BUILT);
+
+    throwActionError(ActionError::NONE);
+    QVERIFY_EXCEPTION_THROWN(throwActionError(ActionError::NOT_OWNED),
+                             Course::OwnerConflict);
+    QVERIFY_EXCEPTION_THROWN(throwActionError(ActionError::ALREADY_OWNED),
+                             Course::OwnerConflict);
+    QVERIFY_EXCEPTION_THROWN(
+                throwActionError(ActionError::NOT_ENOUGH_RESOURCES),
+                Course::IllegalAction);
+}
+
+void TestObjectManager::testPlacement()
+{
+    TileBitset bits(70);
+    bits.set(3);
+    bits.set(69);
+    QCOMPARE(bits.count(), std::size_t(2));
+    TileBitset other(70);
+    other.set(69);
+    bits &= other;
+    QVERIFY(bits == other);
+    std::vector<std::size_t> visited;
+    bits.forEach([&visited](std::size_t index){ visited.push_back(index); });
+    QVERIFY(visited == std::vector<std::size_t>{69});
+
+    // 3x3 grassland that takes one building per tile
+    std::shared_ptr<Player> first = std::make_shared<Player>("First");
+    std::shared_ptr<Player> second = std::make_shared<Player>("Second");
+    std::shared_ptr<ObjectManager> world =
+            grassWorld(3, 3, {first, second}, nullptr, 1);
+    QCOMPARE(world->getPlacement(TypeTag::FARM, first).count(),
+             std::size_t(0));
+
+    world->getTile(Coordinate(0,0))->setOwner(first);
+    world->getTile(Coordinate(1,0))->setOwner(first);
+    world->getTile(Coordinate(2,2))->setOwner(second);
+
+    TileBitset farms = world->getPlacement(TypeTag::FARM, first);
+    QCOMPARE(farms.size(), std::size_t(9));
+    QCOMPARE(farms.count(), std::size_t(2));
+    QVERIFY(farms.test(0) && farms.test(1));
+    // Mines need mountains
+    QCOMPARE(world->getPlacement(TypeTag::MINE, first).count(),
+             std::size_t(0));
+    QCOMPARE(world->getPlacement(TypeTag::FARM, second).count(),
+             std::size_t(1));
+
+    // A full tile is left out until the building is removed
+    std::shared_ptr<Course::Farm> farm = std::make_shared<Course::Farm>(
+                geHandler, world, first);
+    farm->setCoordinate(Coordinate(0,0));
+    world->getTile(Coordinate(0,0))->addBuilding(farm);
+    world->addBuilding(farm);
+    farms = world->getPlacement(TypeTag::FARM, first);
+    QCOMPARE(farms.count(), std::size_t(1));
+    QVERIFY(!farms.test(0) && farms.test(1));
+
+    world->removeBuilding(farm);
+    QCOMPARE(world->getPlacement(TypeTag::FARM, first).count(),
+             std::size_t(2));
+
+    // Unknown players and non-building tags get an empty mask
+    std::shared_ptr<Player> stranger = std::make_shared<Player>("Stranger");
+    QCOMPARE(world->getPlacement(TypeTag::FARM, stranger).count(),
+             std::size_t(0));
+    QCOMPARE(world->getPlacement(TypeTag::GRASSLAND, first).count(),
+             std::size_t(0));
+}
+
+void TestObjectManager::testUpkeep()
+{
+    std::shared_ptr<Player> first = std::make_shared<Player>("First");
+    std::shared_ptr<Player> second = std::make_shared<Player>("Second");
+    first->setResourceMap({{Course::FOOD, 3}, {Course::MONEY, 1},
+                           {Course::WOOD, 0}});
+    second->setResourceMap({{Course::FOOD, 9}, {Course::MONEY, 9},
+                            {Course::WOOD, -1}});
+    std::shared_ptr<GameEventHandler> events =
+            std::make_shared<GameEventHandler>();
+    std::vector<std::shared_ptr<Player>> players = {first, second};
+    events->setPlayers(players);
+
+    // Workers of both players mixed, first one of the second player
+    std::vector<std::shared_ptr<Course::WorkerBase>> workers;
+    workers.push_back(std::make_shared<Course::BasicWorker>(
+                          events, objManager, second));
+    for(int i=0; i<4; i++){
+        workers.push_back(std::make_shared<Course::BasicWorker>(
+                              events, objManager, first));
+    }
+
+    UpkeepPlan plan = planUpkeep(players, workers);
+    std::vector<Satisfaction> expected = {
+        Satisfaction::HUNGRY, Satisfaction::PAID, Satisfaction::FED,
+        Satisfaction::FED, Satisfaction::HUNGRY};
+    QVERIFY(plan.satisfaction == expected);
+    QVERIFY(plan.cost.at(0) == Course::ResourceMap(
+                {{Course::FOOD, -3}, {Course::MONEY, -1}}));
+    // Negative wood keeps everyone hungry
+    QVERIFY(plan.cost.at(1).empty());
+
+    payUpkeep(*events, players, workers);
+    QCOMPARE(first->getResourceMap()->at(Course::FOOD), 0);
+    QCOMPARE(first->getResourceMap()->at(Course::MONEY), 0);
+    QCOMPARE(second->getResourceMap()->at(Course::FOOD), 9);
+    QCOMPARE(workers.at(1)->getSatisfaction(), 1.0);
+    QCOMPARE(workers.at(2)->getSatisfaction(), 0.5);
+    QCOMPARE(workers.at(4)->getSatisfaction(), 0.0);
+}
+
+void TestObjectManager::testProductionForecast()
+{
+    // Own event handler since the players are set to it
+    std::shared_ptr<GameEventHandler> events =
+            std::make_shared<GameEventHandler>();
+    std::shared_ptr<Player> player = std::make_shared<Player>("Player");
+    Course::ResourceMap rich = {{Course::MONEY, 50}, {Course::FOOD, 50},
+                                {Course::WOOD, 50}, {Course::STONE, 50},
+                                {Course::ORE, 50}};
+    player->setResourceMap(rich);
+    std::vector<std::shared_ptr<Player>> players = {player};
+    events->setPlayers(players);
+    std::shared_ptr<ObjectManager> world = grassWorld(2, 2, {player}, events);
+
+    std::shared_ptr<Course::TileBase> tile = world->getTile(Coordinate(0,0));
+    tile->setOwner(player);
+    std::shared_ptr<Course::BasicWorker> worker =
+            std::make_shared<Course::BasicWorker>(events, world, player);
+    worker->setCoordinate(Coordinate(0,0));
+    tile->addWorker(worker);
+    world->addWorker(worker);
+
+    ProductionForecast forecast(world);
+    forecast.setPlayers(players);
+    Course::ResourceMap production = forecast.getProduction(tile);
+    QCOMPARE(forecast.getCalculationCount(), 1u);
+    forecast.getProduction(tile);
+    QCOMPARE(forecast.getCalculationCount(), 1u);
+    QCOMPARE(forecast.getPlanCount(), 1u);
+
+    // The real production is the forecast minus the upkeep
+    payUpkeep(*events, players, world->getWorkers());
+    QVERIFY(tile->generateResources());
+    Course::ResourceMap expected = Course::mergeResourceMaps(
+                rich, production);
+    expected = Course::mergeResourceMaps(
+                expected, {{Course::FOOD, -1}, {Course::MONEY, -1}});
+    QVERIFY(*player->getResourceMap() == expected);
+
+    // Same satisfaction keeps the forecast and the plan
+    forecast.getProduction(tile);
+    QCOMPARE(forecast.getCalculationCount(), 1u);
+    QCOMPARE(forecast.getPlanCount(), 1u);
+
+    // Unpaid worker works less
+    Course::ResourceMap unpaid = rich;
+    unpaid[Course::MONEY] = 0;
+    player->setResourceMap(unpaid);
+    Course::ResourceMap lower = forecast.getProduction(tile);
+    QCOMPARE(forecast.getCalculationCount(), 2u);
+    QCOMPARE(forecast.getPlanCount(), 2u);
+    QVERIFY(lower != production);
+
+    // Buildings change the tile revision
+    player->setResourceMap(rich);
+    std::shared_ptr<Course::Farm> farm = std::make_shared<Course::Farm>(
+                events, world, player);
+    farm->setCoordinate(Coordinate(0,0));
+    tile->addBuilding(farm);
+    world->addBuilding(farm);
+    Course::ResourceMap farmed = forecast.getProduction(tile);
+    QCOMPARE(forecast.getCalculationCount(), 3u);
+    QVERIFY(farmed == Course::mergeResourceMaps(production,
+                                                farm->PRODUCTION_EFFECT));
+
+    // Only worked tiles have values
+    std::vector<int> values = forecast.getValues();
+    QCOMPARE(values.size(), std::size_t(4));
+    QCOMPARE(values.at(0), ScoreLedger::resourceValue(farmed));
+    QCOMPARE(values.at(1), 0);
+    QCOMPARE(forecast.getCalculationCount(), 3u);
+}
+
+void TestObjectManager::testSteadyTurns()
+{
+    std::shared_ptr<GameEventHandler> events =
+            std::make_shared<GameEventHandler>();
+    std::shared_ptr<Player> player = std::make_shared<Player>("Player");
+    player->setResourceMap({{Course::MONEY, 23}, {Course::FOOD, 50},
+                            {Course::WOOD, 50}, {Course::STONE, 50},
+                            {Course::ORE, 50}});
+    std::vector<std::shared_ptr<Player>> players = {player};
+    events->setPlayers(players);
+    std::shared_ptr<ObjectManager> world = grassWorld(1, 1, {player}, events);
+
+    // Outpost costs money every turn and ignores its hold markers
+    std::shared_ptr<Course::TileBase> tile = world->getTile(Coordinate(0,0));
+    tile->setOwner(player);
+    std::shared_ptr<Course::Outpost> outpost =
+            std::make_shared<Course::Outpost>(events, world, player);
+    outpost->setCoordinate(Coordinate(0,0));
+    outpost->addHoldMarkers(1);
+    tile->addBuilding(outpost);
+    world->addBuilding(outpost);
+
+    ProductionForecast forecast(world);
+    forecast.setPlayers(players);
+    SteadyTurns steady = planSteadyTurns(players, world, forecast);
+    QCOMPARE(steady.change.at(0)[Course::MONEY], -5);
+    QCOMPARE(steady.change.at(0)[Course::FOOD], -2);
+    // 23, 18, 13 and 8 money still pay the outpost
+    QCOMPARE(steady.repeats, 4);
+
+    for(int turn=0; turn<steady.repeats; turn++){
+        Course::ResourceMap expected = Course::mergeResourceMaps(
+                    *player->getResourceMap(), steady.change.at(0));
+        payUpkeep(*events, players, world->getWorkers());
+        QVERIFY(tile->generateResources());
+        QVERIFY(*player->getResourceMap() == expected);
+    }
+    QCOMPARE(planSteadyTurns(players, world, forecast).repeats, 0);
+    QVERIFY(!tile->generateResources());
+}
+
+void TestObjectManager::testTurnTimers()
+{
+    // Short wheel so that later timers wait for rounds
+    TurnTimers timers(4);
+    std::vector<int> ran;
+    timers.schedule(2, [&ran](){ ran.push_back(1); });
+    timers.schedule(6, [&ran](){ ran.push_back(2); });
+    quint64 cancelled = timers.schedule(2, [&ran](){ ran.push_back(3); });
+    timers.schedule(2, [&ran](){ ran.push_back(4); });
+    QCOMPARE(timers.pendingCount(), 4u);
+    QCOMPARE(timers.nextDue(), 2u);
+    QCOMPARE(timers.remaining(cancelled), 2u);
+
+    QVERIFY(timers.cancel(cancelled));
+    QVERIFY(!timers.cancel(cancelled));
+    QCOMPARE(timers.remaining(cancelled), 0u);
+
+    timers.advance();
+    QVERIFY(ran.empty());
+    timers.advance();
+    QCOMPARE(ran, std::vector<int>({1, 4}));
+
+    // Effects can schedule more
+    timers.schedule(1, [&ran, &timers](){
+        ran.push_back(5);
+        timers.schedule(1, [&ran](){ ran.push_back(6); });
+    });
+    timers.advance(2);
+    QCOMPARE(ran, std::vector<int>({1, 4, 5, 6}));
+
+    // Same slot two rounds later
+    QCOMPARE(timers.nextDue(), 2u);
+    timers.advance(2);
+    QCOMPARE(ran, std::vector<int>({1, 4, 5, 6, 2}));
+    QCOMPARE(timers.pendingCount(), 0u);
+    QCOMPARE(timers.nextDue(), UINT_MAX);
+    timers.advance(1000);
+}
+
+void TestObjectManager::testChunkedTiles()
+{
+    std::shared_ptr<Player> first = std::make_shared<Player>("First");
+    std::shared_ptr<ObjectManager> whole = grassWorld(5, 3, {first});
+    std::shared_ptr<ObjectManager> chunked = std::make_shared<ObjectManager>();
+    chunked->setPlayers({first});
+
+    chunked->reserveMap(5, 3);
+    QCOMPARE(chunked->getMapSize(), std::make_pair(5, 3));
+    QCOMPARE(chunked->getTileTag(Coordinate(4,2)), TypeTag::UNKNOWN);
+    chunked->addTiles(grassColumns(chunked, 0, 2, 3, geHandler));
+    QVERIFY(chunked->getTile(Coordinate(1,2)) != nullptr);
+    QCOMPARE(chunked->getTileTag(Coordinate(2,0)), TypeTag::UNKNOWN);
+    chunked->addTiles(grassColumns(chunked, 2, 5, 3, geHandler));
+
+    QCOMPARE(chunked->getMapSize(), whole->getMapSize());
+    QCOMPARE(chunked->getTileTags(), whole->getTileTags());
+    QCOMPARE(chunked->getTile(Coordinate(3,1))->ID,
+             chunked->getTiles().at(10)->ID);
+    QVERIFY(chunked->getPlacement(TypeTag::FARM, first) ==
+            whole->getPlacement(TypeTag::FARM, first));
+
+    // Owners of tiles added later are counted
+    chunked->getTile(Coordinate(4,0))->setOwner(first);
+    whole->getTile(Coordinate(4,0))->setOwner(first);
+    QCOMPARE(chunked->getTerritorySize(first), 1u);
+    QVERIFY(chunked->getPlacement(TypeTag::FARM, first) ==
+            whole->getPlacement(TypeTag::FARM, first));
+
+    // Reserving a smaller map changes nothing
+    chunked->reserveMap(2, 2);
+    QCOMPARE(chunked->getMapSize(), std::make_pair(5, 3));
+}
+
 QTEST_APPLESS_MAIN(TestObjectManager)
 
 #include "testobjectmanager.moc"
@@ -1,5 +1,7 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
+    BenchmarkCore \
     TestGameEventHandler \
+    TestGameManager \
     TestObjectManager \